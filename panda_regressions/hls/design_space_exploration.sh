@@ -0,0 +1,40 @@
+#!/bin/bash
+# Check the exit status and the results of --dse-configurations on configurations which succeed, fail or are malformed
+BAMBU=/opt/panda/bin/bambu
+for arg in "$@"; do
+   case $arg in
+      --bambu=*) BAMBU=${arg#--bambu=} ;;
+   esac
+done
+root_dir=$(cd $(dirname $0) && pwd)
+output_dir=$(pwd)/output_design_space_exploration
+return_value=0
+
+check_exploration()
+{
+   configurations=$1
+   expected_status=$2
+   expected_successes=$3
+   expected_failures=$4
+   rm -rf $output_dir/$configurations
+   mkdir -p $output_dir/$configurations
+   cd $output_dir/$configurations
+   $BAMBU -O2 --top-fname=sum --evaluation=TOTAL_CYCLES,CYCLES --simulate --dse-configurations=$root_dir/design_space_exploration/$configurations $root_dir/design_space_exploration/sum.c > bambu_output.txt 2>&1
+   status=$?
+   if test $expected_status = 0 -a $status != 0 || test $expected_status != 0 -a $status = 0; then
+      echo "FAILURE: $configurations: unexpected exit status $status"
+      return_value=1
+   elif test $expected_successes != - && (test $(grep -c ",success," dse/results.csv) != $expected_successes || test $(grep -c ",failure," dse/results.csv) != $expected_failures); then
+      echo "FAILURE: $configurations: expected $expected_successes synthesized and $expected_failures failed configurations, found:"
+      cat dse/results.csv
+      return_value=1
+   else
+      echo "SUCCESS: $configurations"
+   fi
+   cd - > /dev/null
+}
+
+check_exploration valid_configurations 0 3 0
+check_exploration failing_configurations 1 0 2
+check_exploration unknown_option_configurations 1 - -
+exit $return_value
@@ -0,0 +1,9 @@
+/* Small kernel synthesized under several configurations by design_space_exploration.sh */
+unsigned int sum(unsigned int* a, unsigned int n)
+{
+   unsigned int s = 0;
+   unsigned int i;
+   for(i = 0; i < n; i++)
+      s += a[i] * (i + 1);
+   return s;
+}
@@ -0,0 +1,33 @@
+#!/bin/bash
+# Check the initiation interval and its bounds printed by --modulo-scheduling-report on loops whose values are known
+BAMBU=/opt/panda/bin/bambu
+for arg in "$@"; do
+   case $arg in
+      --bambu=*) BAMBU=${arg#--bambu=} ;;
+   esac
+done
+root_dir=$(cd $(dirname $0) && pwd)
+output_dir=$(pwd)/output_modulo_scheduling
+return_value=0
+
+check_loop()
+{
+   source_file=$1
+   top_function=$2
+   expected="of $top_function: initiation interval $3 (ResMII $4, RecMII $5)"
+   mkdir -p $output_dir/$top_function
+   cd $output_dir/$top_function
+   $BAMBU -O2 --pipelining --modulo-scheduling-report --top-fname=$top_function $root_dir/modulo_scheduling/$source_file > bambu_output.txt 2>&1
+   if grep -qF "$expected" bambu_output.txt; then
+      echo "SUCCESS: $top_function"
+   else
+      echo "FAILURE: $top_function: expected \"$expected\", found:"
+      grep "of $top_function: initiation interval" bambu_output.txt
+      return_value=1
+   fi
+   cd - > /dev/null
+}
+
+check_loop accumulate.c accumulate 1 1 1
+check_loop recurrence.c recurrence 2 1 2
+exit $return_value
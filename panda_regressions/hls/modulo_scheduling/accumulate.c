@@ -0,0 +1,9 @@
+/* No limited resource and a recurrence made of a single operation: II 1, ResMII 1, RecMII 1 */
+unsigned int accumulate(unsigned int x, unsigned int n)
+{
+   unsigned int s = 0;
+   unsigned int i;
+   for(i = 0; i < n; i++)
+      s += i ^ x;
+   return s;
+}
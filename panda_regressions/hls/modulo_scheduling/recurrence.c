@@ -0,0 +1,9 @@
+/* No limited resource and a recurrence made of two chained operations: II 2, ResMII 1, RecMII 2 */
+unsigned int recurrence(unsigned int x, unsigned int n)
+{
+   unsigned int s = 0;
+   unsigned int i;
+   for(i = 0; i < n; i++)
+      s = (s ^ x) + i;
+   return s;
+}
@@ -232,7 +232,8 @@
 #define OPT_ROM_DUPLICATION (1 + OPT_DO_NOT_EXPOSE_GLOBALS)
 #define OPT_DO_NOT_USE_ASYNCHRONOUS_MEMORIES (1 + OPT_ROM_DUPLICATION)
 #define OPT_DSE (1 + OPT_DO_NOT_USE_ASYNCHRONOUS_MEMORIES)
-#define OPT_DSP_ALLOCATION_COEFFICIENT (1 + OPT_DSE)
+#define INPUT_OPT_DSE_CONFIGURATIONS (1 + OPT_DSE)
+#define OPT_DSP_ALLOCATION_COEFFICIENT (1 + INPUT_OPT_DSE_CONFIGURATIONS)
 #define OPT_DSP_MARGIN_COMBINATIONAL (1 + OPT_DSP_ALLOCATION_COEFFICIENT)
 #define OPT_DSP_MARGIN_PIPELINED (1 + OPT_DSP_MARGIN_COMBINATIONAL)
 #define OPT_DUMP_CONSTRAINTS (1 + OPT_DSP_MARGIN_PIPELINED)
@@ -274,7 +275,8 @@
 #define OPT_MEM_DELAY_WRITE (1 + OPT_MEM_DELAY_READ)
 #define OPT_MEMORY_BANKS_NUMBER (1 + OPT_MEM_DELAY_WRITE)
 #define OPT_MIN_INHERITANCE (1 + OPT_MEMORY_BANKS_NUMBER)
-#define OPT_MOSA_FLOW (1 + OPT_MIN_INHERITANCE)
+#define INPUT_OPT_MODULO_SCHEDULING_REPORT (1 + OPT_MIN_INHERITANCE)
+#define OPT_MOSA_FLOW (1 + INPUT_OPT_MODULO_SCHEDULING_REPORT)
 #define OPT_NO_MIXED_DESIGN (1 + OPT_MOSA_FLOW)
 #define OPT_NUM_ACCELERATORS (1 + OPT_NO_MIXED_DESIGN)
 #define OPT_PARALLEL_CONTROLLER (1 + OPT_NUM_ACCELERATORS)
@@ -456,6 +458,12 @@ void BambuParameter::PrintHelp(std::ostream& os) const
 #endif
       << "    --pipelining,-p\n"
       << "        Perform functional pipelining starting from the top function.\n\n"
+      << "    --modulo-scheduling-report\n"
+      << "        Report the initiation interval, ResMII, RecMII, stages and register\n"
+      << "        pressure that modulo scheduling would reach on the innermost single\n"
+      << "        block loops of the pipelined functions. This is an analysis only:\n"
+      << "        the generated controller still executes one iteration at a time.\n"
+      << "        Requires --pipelining.\n\n"
       << "    --fixed-scheduling=<file>\n"
       << "        Provide scheduling as an XML file.\n\n"
       << "    --no-chaining\n"
@@ -723,6 +731,17 @@ void BambuParameter::PrintHelp(std::ostream& os) const
       << "            PERIOD          - Actual clock period\n"
       << "            REGISTERS       - number of registers\n"
       << "\n"
+      << "    --dse-configurations=<file>\n"
+      << "        Explore the configurations listed in <file>, one per line. Each line\n"
+      << "        is a space separated list of <option>=<value> pairs, where <option> is\n"
+      << "        the internal name of an option (e.g., clock_period=5). The front-end\n"
+      << "        is executed only once, then the HLS flow of each configuration is\n"
+      << "        executed in a separate process in dse/configuration_<n>; at most\n"
+      << "        --jobs configurations are synthesized at the same time; the front-end\n"
+      << "        and each configuration run on a single thread. Unknown option names\n"
+      << "        are rejected. The evaluated objectives and the Pareto front are\n"
+      << "        written in dse/results.csv.\n"
+      << "        Requires --evaluation or --simulate.\n\n"
 #if HAVE_EXPERIMENTAL
       << "    --evaluation-mode[=type]\n"
       << "        Perform evaluation of the results:\n"
@@ -1111,6 +1130,7 @@ int BambuParameter::Exec()
       {"speculative-sdc-scheduling", no_argument, nullptr, 's'},
 #endif
       {"pipelining", no_argument, nullptr, 'p'},
+      {"modulo-scheduling-report", no_argument, nullptr, INPUT_OPT_MODULO_SCHEDULING_REPORT},
       {"serialize-memory-accesses", no_argument, nullptr, OPT_SERIALIZE_MEMORY_ACCESSES},
       {PAR_LIST_BASED_OPT, optional_argument, nullptr, OPT_LIST_BASED}, // no short option
       {"post-rescheduling", no_argument, nullptr, OPT_POST_RESCHEDULING},
@@ -1257,6 +1277,7 @@ int BambuParameter::Exec()
 #endif
 #endif
       {"dry-run-evaluation", no_argument, nullptr, INPUT_OPT_DRY_RUN_EVALUATION},
+      {"dse-configurations", required_argument, nullptr, INPUT_OPT_DSE_CONFIGURATIONS},
       GCC_LONG_OPTIONS,
       {nullptr, 0, nullptr, 0}
    };
@@ -1921,6 +1942,11 @@ int BambuParameter::Exec()
             setOption(OPT_pipelining, true);
             break;
          }
+         case INPUT_OPT_MODULO_SCHEDULING_REPORT:
+         {
+            setOption(OPT_modulo_scheduling_report, true);
+            break;
+         }
          case OPT_SERIALIZE_MEMORY_ACCESSES:
          {
             setOption(OPT_gcc_serialize_memory_accesses, true);
@@ -2334,6 +2360,11 @@ int BambuParameter::Exec()
             setOption(OPT_dry_run_evaluation, true);
             break;
          }
+         case INPUT_OPT_DSE_CONFIGURATIONS:
+         {
+            setOption(OPT_dse_configurations, std::string(optarg));
+            break;
+         }
          case 0:
          {
             if(strcmp(long_options[option_index].name, "module-binding") == 0)
@@ -3382,6 +3413,24 @@ void BambuParameter::CheckParameters()
    {
       setOption(OPT_evaluation_mode, Evaluation_Mode::DRY_RUN);
    }
+   if(getOption<bool>(OPT_modulo_scheduling_report) and not(isOption(OPT_pipelining) and getOption<bool>(OPT_pipelining)))
+   {
+      THROW_ERROR("--modulo-scheduling-report requires --pipelining");
+   }
+   if(isOption(OPT_dse_configurations))
+   {
+#ifdef _WIN32
+      THROW_ERROR("--dse-configurations is not supported on this platform");
+#endif
+      if(not getOption<bool>(OPT_evaluation))
+      {
+         THROW_ERROR("--dse-configurations requires --evaluation or --simulate");
+      }
+      if(not boost::filesystem::exists(getOption<std::string>(OPT_dse_configurations)))
+      {
+         THROW_ERROR("File " + getOption<std::string>(OPT_dse_configurations) + " does not exist");
+      }
+   }
    /// When simd is enabled bit value analysis and optimization are disabled
    if(getOption<int>(OPT_gcc_openmp_simd))
       setOption(OPT_bitvalue_ipa, false);
@@ -3492,6 +3541,7 @@ void BambuParameter::SetDefaults()
 
    /// Disable memory mapped interface for top function by default
    setOption(OPT_memory_mapped_top, false);
+   setOption(OPT_modulo_scheduling_report, false);
 
    setOption(OPT_mem_delay_read, 2);
    setOption(OPT_mem_delay_write, 1);
@@ -2668,16 +2668,15 @@ void mux_connection_binding::create_connections()
    const std::list<vertex>::const_iterator vEnd = support.end();
    for(std::list<vertex>::const_iterator vIt = support.begin(); vIt != vEnd; vIt++)
    {
-      const CustomOrderedSet<unsigned int>& live_in = HLS->Rliv->get_live_in(*vIt);
-      for(CustomOrderedSet<unsigned int>::const_iterator k = live_in.begin(); k != live_in.end(); ++k)
+      const std::vector<unsigned int> live_in = HLS->Rliv->get_live_in(*vIt);
+      for(auto k = live_in.begin(); k != live_in.end(); ++k)
       {
          if(!HLS->Rliv->has_state_in(*vIt, *k)) continue;
          const CustomOrderedSet<vertex>& states_in = HLS->Rliv->get_state_in(*vIt,*k);
          const CustomOrderedSet<vertex>::const_iterator si_it_end = states_in.end();
          for(CustomOrderedSet<vertex>::const_iterator si_it=states_in.begin(); si_it != si_it_end; si_it++)
          {
-            const CustomOrderedSet<unsigned int>& live_in_src = HLS->Rliv->get_live_in(*si_it);
-            if (live_in_src.find(*k) == live_in_src.end()) continue;
+            if (!HLS->Rliv->is_live_in(*si_it, *k)) continue;
             unsigned int storage_value_src = HLS->storage_value_information->get_storage_value_index(*si_it, *k);
             unsigned int r_index_src = HLS->Rreg->get_register(storage_value_src);
             unsigned int storage_value_dest = HLS->storage_value_information->get_storage_value_index(*vIt, *k);
@@ -83,9 +83,9 @@ void compatibility_based_register::create_compatibility_graph()
    const std::list<vertex>::const_iterator vEnd = support.end();
    for(auto vIt = support.begin(); vIt != vEnd; ++vIt)
    {
-      const CustomOrderedSet<unsigned int>& live = HLS->Rliv->get_live_in(*vIt);
+      const std::vector<unsigned int> live = HLS->Rliv->get_live_in(*vIt);
       register_lower_bound = std::max(static_cast<unsigned int>(live.size()), register_lower_bound);
-      const CustomOrderedSet<unsigned int>::const_iterator k_end = live.end();
+      const auto k_end = live.end();
       for(auto k = live.begin(); k != k_end; ++k)
       {
          auto k_inner = k;
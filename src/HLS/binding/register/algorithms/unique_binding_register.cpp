@@ -78,7 +78,7 @@ DesignFlowStep_Status unique_binding_register::InternalExec()
    const std::list<vertex>::const_iterator vEnd = support.end();
    for(auto vIt = support.begin(); vIt != vEnd; ++vIt)
    {
-      const CustomOrderedSet<unsigned int>& live = HLS->Rliv->get_live_in(*vIt);
+      const std::vector<unsigned int> live = HLS->Rliv->get_live_in(*vIt);
       auto k_end = live.end();
       for(auto k = live.begin(); k != k_end; ++k)
       {
@@ -178,8 +178,8 @@ void reg_binding::compute_is_without_enable()
    {
       vertex v = *ss_it;
       unsigned int dummy_offset = HLS->Rliv->is_a_dummy_state(v) ? 1 : 0;
-      const CustomOrderedSet<unsigned int>& LI = HLS->Rliv->get_live_in(v);
-      const CustomOrderedSet<unsigned int>::const_iterator li_it_end = LI.end();
+      const std::vector<unsigned int> LI = HLS->Rliv->get_live_in(v);
+      const auto li_it_end = LI.end();
       for(auto li_it = LI.begin(); li_it != li_it_end; ++li_it)
       {
          if(n_in.find(*li_it) == n_in.end())
@@ -187,14 +187,14 @@ void reg_binding::compute_is_without_enable()
          else
             n_in[*li_it] = n_in[*li_it] + 1 + dummy_offset;
       }
-      const CustomOrderedSet<unsigned int>& LO = HLS->Rliv->get_live_out(v);
-      const CustomOrderedSet<unsigned int>::const_iterator lo_it_end = LO.end();
+      const std::vector<unsigned int> LO = HLS->Rliv->get_live_out(v);
+      const auto lo_it_end = LO.end();
       for(auto lo_it = LO.begin(); lo_it != lo_it_end; ++lo_it)
       {
          if(n_out.find(*lo_it) == n_out.end())
          {
             n_out[*lo_it] = 1 + dummy_offset;
-            if(LI.find(*lo_it) != LI.end())
+            if(HLS->Rliv->is_live_in(v, *lo_it))
                n_out[*lo_it] = 2 + dummy_offset;
          }
          else
@@ -0,0 +1,353 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file design_space_exploration.cpp
+ * @brief Class exploring a set of HLS configurations which share the same front-end analyses
+ *
+ */
+
+/// Header include
+#include "design_space_exploration.hpp"
+
+/// Autoheader include
+#include "config_HAVE_OPENMP.hpp"
+
+/// . include
+#include "Parameter.hpp"
+
+/// constants include
+#include "constant_strings.hpp"
+
+/// design_flows include
+#include "design_flow_manager.hpp"
+#include "design_flow_step_factory.hpp"
+
+/// frontend_analysis include
+#include "frontend_flow_step.hpp"
+#include "frontend_flow_step_factory.hpp"
+
+/// HLS include
+#include "hls_flow_step_factory.hpp"
+#include "hls_manager.hpp"
+
+/// STD include
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+/// System include
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#if HAVE_OPENMP
+#include <omp.h>
+#endif
+
+/// utility include
+#include "dbgPrintHelper.hpp"
+#include "exceptions.hpp"
+#include "string_manipulation.hpp"
+#include "utility.hpp"
+#include <boost/filesystem.hpp>
+
+DesignSpaceExploration::DesignSpaceExploration(const ParameterRef _parameters, const HLS_managerRef _HLSMgr, const DesignFlowManagerRef _design_flow_manager, const DesignFlowStepFactoryConstRef _frontend_flow_step_factory,
+                                               const DesignFlowStepFactoryConstRef _hls_flow_step_factory, const size_t _jobs)
+    : parameters(_parameters),
+      HLSMgr(_HLSMgr),
+      design_flow_manager(_design_flow_manager),
+      frontend_flow_step_factory(_frontend_flow_step_factory),
+      hls_flow_step_factory(_hls_flow_step_factory),
+      dse_directory(boost::filesystem::absolute("dse").string() + "/"),
+      jobs(_jobs),
+      output_level(_parameters->getOption<int>(OPT_output_level))
+{
+}
+
+DesignSpaceExploration::~DesignSpaceExploration() = default;
+
+size_t DesignSpaceExploration::SerializeParentProcess(const ParameterRef parameters)
+{
+   const auto dse_jobs = static_cast<size_t>(std::max(1, parameters->getOption<int>(OPT_jobs)));
+   parameters->setOption(OPT_jobs, 1);
+#if HAVE_OPENMP
+   omp_set_num_threads(1);
+#endif
+   return dse_jobs;
+}
+
+void DesignSpaceExploration::ReadConfigurations()
+{
+   const auto file_name = parameters->getOption<std::string>(OPT_dse_configurations);
+   std::ifstream configuration_file(file_name);
+   if(not configuration_file.is_open())
+   {
+      THROW_ERROR("Unable to open " + file_name);
+   }
+   std::string line;
+   while(std::getline(configuration_file, line))
+   {
+      const auto options = convert_string_to_vector<std::string>(line, " \t\r");
+      /// empty lines and comments are skipped
+      if(options.empty() or options.front().front() == '#')
+      {
+         continue;
+      }
+      std::list<std::pair<std::string, std::string>> configuration;
+      for(const auto& option : options)
+      {
+         const auto equal = option.find('=');
+         if(equal == std::string::npos or equal == 0)
+         {
+            THROW_ERROR("Malformed option " + option + " in configuration " + STR(configurations.size()) + " of " + file_name + ": expected <option>=<value>");
+         }
+         const auto name = option.substr(0, equal);
+         if(not parameters->IsOptionName(name))
+         {
+            THROW_ERROR("Unknown option " + name + " in configuration " + STR(configurations.size()) + " of " + file_name);
+         }
+         configuration.push_back(std::make_pair(name, option.substr(equal + 1)));
+      }
+      configuration_lines.push_back(line);
+      configurations.push_back(configuration);
+   }
+   if(configurations.empty())
+   {
+      THROW_ERROR("No configuration found in " + file_name);
+   }
+}
+
+std::string DesignSpaceExploration::GetConfigurationDirectory(const size_t index) const
+{
+   return dse_directory + "configuration_" + STR(index) + "/";
+}
+
+int DesignSpaceExploration::SynthesizeConfiguration(const size_t index)
+{
+   try
+   {
+      /// the outputs written in the current directory (e.g., the HDL top file) have to be kept separated as well
+      const auto configuration_directory = GetConfigurationDirectory(index);
+      boost::filesystem::create_directories(configuration_directory);
+      boost::filesystem::current_path(configuration_directory);
+      const auto temporary_directory = configuration_directory + STR_CST_temporary_directory + "/";
+      boost::filesystem::create_directories(temporary_directory);
+      boost::filesystem::create_directories(configuration_directory + "HLS_output/");
+      parameters->setOption(OPT_output_temporary_directory, temporary_directory);
+      parameters->setOption(OPT_output_directory, configuration_directory + "HLS_output/");
+      for(const auto& option : configurations.at(index))
+      {
+         parameters->SetOptionByName(option.first, option.second);
+      }
+      const std::pair<HLSFlowStep_Type, HLSFlowStepSpecializationConstRef> hls_flow_step(parameters->getOption<HLSFlowStep_Type>(OPT_synthesis_flow), HLSFlowStepSpecializationConstRef());
+      design_flow_manager->AddSteps(GetPointer<const HLSFlowStepFactory>(hls_flow_step_factory)->CreateHLSFlowSteps(hls_flow_step));
+      design_flow_manager->Exec();
+      std::ofstream evaluations_file(configuration_directory + "evaluations.txt");
+      for(const auto& evaluation : HLSMgr->evaluations)
+      {
+         evaluations_file << evaluation.first;
+         for(const auto value : evaluation.second)
+         {
+            evaluations_file << " " << STR(value);
+         }
+         evaluations_file << "\n";
+      }
+      if(not parameters->getOption<bool>(OPT_no_clean))
+      {
+         boost::filesystem::remove_all(temporary_directory);
+      }
+      return EXIT_SUCCESS;
+   }
+   catch(const char* str)
+   {
+      std::cerr << str << std::endl;
+   }
+   catch(const std::string& str)
+   {
+      std::cerr << str << std::endl;
+   }
+   catch(std::exception& e)
+   {
+      std::cerr << e.what() << std::endl;
+   }
+   catch(...)
+   {
+      std::cerr << "Unknown error type" << std::endl;
+   }
+   return EXIT_FAILURE;
+}
+
+void DesignSpaceExploration::WriteResults(const std::vector<bool>& succeeded) const
+{
+   const auto objectives = convert_string_to_vector<std::string>(parameters->getOption<std::string>(OPT_evaluation_objectives), ",");
+   /// The value of each objective of each configuration; all the objectives are minimized except the frequency
+   std::vector<std::map<std::string, double>> values(configurations.size());
+   for(size_t index = 0; index < configurations.size(); index++)
+   {
+      if(not succeeded.at(index))
+      {
+         continue;
+      }
+      std::ifstream evaluations_file(GetConfigurationDirectory(index) + "evaluations.txt");
+      std::string line;
+      while(std::getline(evaluations_file, line))
+      {
+         std::istringstream evaluation(line);
+         std::string objective;
+         double value;
+         if(evaluation >> objective >> value)
+         {
+            values[index][objective] = value;
+         }
+      }
+   }
+   const auto complete = [&](const size_t index) -> bool {
+      return succeeded.at(index) and std::all_of(objectives.begin(), objectives.end(), [&](const std::string& objective) { return values.at(index).count(objective) != 0; });
+   };
+   const auto dominates = [&](const size_t first, const size_t second) -> bool {
+      bool strictly = false;
+      for(const auto& objective : objectives)
+      {
+         const double sign = objective == "FREQUENCY" ? -1.0 : 1.0;
+         const auto first_value = sign * values.at(first).at(objective);
+         const auto second_value = sign * values.at(second).at(objective);
+         if(first_value > second_value)
+         {
+            return false;
+         }
+         strictly = strictly or first_value < second_value;
+      }
+      return strictly;
+   };
+   std::ofstream results_file(dse_directory + "results.csv");
+   results_file << "configuration,options,status";
+   for(const auto& objective : objectives)
+   {
+      results_file << "," << objective;
+   }
+   results_file << ",pareto\n";
+   INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "-->Pareto front");
+   for(size_t index = 0; index < configurations.size(); index++)
+   {
+      bool pareto = complete(index);
+      for(size_t other = 0; other < configurations.size() and pareto; other++)
+      {
+         pareto = not(other != index and complete(other) and dominates(other, index));
+      }
+      results_file << index << ",\"" << configuration_lines.at(index) << "\"," << (succeeded.at(index) ? "success" : "failure");
+      std::string objectives_string;
+      for(const auto& objective : objectives)
+      {
+         const auto value = values.at(index).find(objective);
+         results_file << "," << (value != values.at(index).end() ? STR(value->second) : "");
+         if(value != values.at(index).end())
+         {
+            objectives_string += " " + objective + "=" + STR(value->second);
+         }
+      }
+      results_file << "," << (pareto ? "yes" : "no") << "\n";
+      if(pareto)
+      {
+         INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "---Configuration " + STR(index) + " (" + configuration_lines.at(index) + "):" + objectives_string);
+      }
+   }
+   INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "<--");
+   INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "---Results written in " + dse_directory + "results.csv");
+}
+
+bool DesignSpaceExploration::Exec()
+{
+#ifdef _WIN32
+   THROW_ERROR("Design space exploration is not supported on this platform");
+   return false;
+#else
+   ReadConfigurations();
+   INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "-->Design space exploration of " + STR(configurations.size()) + " configurations");
+   /// The front-end is executed only once; its results are inherited by all the configurations
+   design_flow_manager->AddStep(GetPointer<const FrontendFlowStepFactory>(frontend_flow_step_factory)->CreateApplicationFrontendFlowStep(FrontendFlowStepType::BAMBU_FRONTEND_FLOW));
+   design_flow_manager->Exec();
+   boost::filesystem::create_directories(dse_directory);
+   std::map<pid_t, size_t> running;
+   std::vector<bool> succeeded(configurations.size(), false);
+   size_t next = 0;
+   while(next < configurations.size() or not running.empty())
+   {
+      if(next < configurations.size() and running.size() < jobs)
+      {
+         INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "---Starting configuration " + STR(next) + ": " + configuration_lines.at(next));
+         std::cout.flush();
+         std::cerr.flush();
+         const pid_t pid = fork();
+         if(pid == 0)
+         {
+            const auto exit_status = SynthesizeConfiguration(next);
+            std::cout.flush();
+            std::cerr.flush();
+            _exit(exit_status);
+         }
+         if(pid < 0)
+         {
+            THROW_ERROR("Unable to create the process for configuration " + STR(next));
+         }
+         running[pid] = next;
+         next++;
+         continue;
+      }
+      int status;
+      const pid_t pid = waitpid(-1, &status, 0);
+      if(pid < 0)
+      {
+         if(errno == EINTR)
+         {
+            continue;
+         }
+         THROW_ERROR("Error while waiting for the synthesis of the configurations");
+      }
+      if(running.find(pid) == running.end())
+      {
+         continue;
+      }
+      const auto index = running.at(pid);
+      running.erase(pid);
+      succeeded[index] = WIFEXITED(status) and WEXITSTATUS(status) == EXIT_SUCCESS;
+      INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "---Configuration " + STR(index) + (succeeded[index] ? " completed" : " failed"));
+   }
+   WriteResults(succeeded);
+   INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "<--");
+   return std::find(succeeded.begin(), succeeded.end(), true) != succeeded.end();
+#endif
+}
@@ -0,0 +1,150 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file design_space_exploration.hpp
+ * @brief Class exploring a set of HLS configurations which share the same front-end analyses
+ *
+ */
+#ifndef DESIGN_SPACE_EXPLORATION_HPP
+#define DESIGN_SPACE_EXPLORATION_HPP
+
+/// STD include
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// utility include
+#include "refcount.hpp"
+
+REF_FORWARD_DECL(DesignFlowManager);
+CONSTREF_FORWARD_DECL(DesignFlowStepFactory);
+REF_FORWARD_DECL(HLS_manager);
+REF_FORWARD_DECL(Parameter);
+
+/**
+ * Design space exploration over a list of configurations.
+ * The front-end flow is executed once in the current process; then the HLS flow of each configuration is executed in a child process created by fork, so that
+ * the intermediate representation and the technology library are shared (copy-on-write) among all the configurations.
+ */
+class DesignSpaceExploration
+{
+ protected:
+   /// The set of input parameters; the options of a configuration are applied to it in the process which synthesizes that configuration
+   const ParameterRef parameters;
+
+   /// The HLS manager
+   const HLS_managerRef HLSMgr;
+
+   /// The design flow manager
+   const DesignFlowManagerRef design_flow_manager;
+
+   /// The factory of the front-end steps
+   const DesignFlowStepFactoryConstRef frontend_flow_step_factory;
+
+   /// The factory of the HLS steps
+   const DesignFlowStepFactoryConstRef hls_flow_step_factory;
+
+   /// The directory where the outputs of the configurations and the results are written
+   const std::string dse_directory;
+
+   /// The configurations as written in the input file
+   std::vector<std::string> configuration_lines;
+
+   /// The configurations: for each of them, the list of pairs <option name, option value>
+   std::vector<std::list<std::pair<std::string, std::string>>> configurations;
+
+   /// The number of configurations synthesized concurrently
+   const size_t jobs;
+
+   /// The output level
+   int output_level;
+
+   /**
+    * Read the configurations from the input file
+    */
+   void ReadConfigurations();
+
+   /**
+    * Return the directory where the outputs of a configuration are written
+    * @param index is the index of the configuration
+    */
+   std::string GetConfigurationDirectory(size_t index) const;
+
+   /**
+    * Apply a configuration and execute the HLS flow; this is executed in the child process created for the configuration
+    * @param index is the index of the configuration
+    * @return the exit status of the process
+    */
+   int SynthesizeConfiguration(size_t index);
+
+   /**
+    * Collect the evaluations of the configurations, compute the Pareto front and write the results
+    * @param succeeded tells for each configuration if its synthesis ended without errors
+    */
+   void WriteResults(const std::vector<bool>& succeeded) const;
+
+ public:
+   /**
+    * Constructor
+    * @param parameters is the set of input parameters
+    * @param HLSMgr is the HLS manager
+    * @param design_flow_manager is the design flow manager
+    * @param frontend_flow_step_factory is the factory of the front-end steps
+    * @param hls_flow_step_factory is the factory of the HLS steps
+    * @param jobs is the number of configurations synthesized concurrently (see SerializeParentProcess)
+    */
+   DesignSpaceExploration(const ParameterRef parameters, const HLS_managerRef HLSMgr, const DesignFlowManagerRef design_flow_manager, const DesignFlowStepFactoryConstRef frontend_flow_step_factory,
+                          const DesignFlowStepFactoryConstRef hls_flow_step_factory, size_t jobs);
+
+   /**
+    * Force the current process to run serially; it must be called before any data structure is created from the parameters.
+    * The children are created by fork after the front-end: using OpenMP in a child is undefined once the parent has started OpenMP threads,
+    * so the jobs are used only to synthesize the configurations concurrently
+    * @param parameters is the set of input parameters
+    * @return the number of configurations to be synthesized concurrently
+    */
+   static size_t SerializeParentProcess(const ParameterRef parameters);
+
+   /**
+    * Destructor
+    */
+   ~DesignSpaceExploration();
+
+   /**
+    * Execute the exploration
+    * @return true if at least one configuration has been synthesized without errors
+    */
+   bool Exec();
+};
+#endif
@@ -41,6 +41,20 @@
 /// Header include
 #include "evaluation_base_step.hpp"
 
+///. include
+#include "Parameter.hpp"
+
+/// HLS include
+#include "hls_manager.hpp"
+
+/// STD include
+#include <fstream>
+#include <sstream>
+
+/// utility include
+#include "string_manipulation.hpp"
+#include <boost/filesystem/operations.hpp>
+
 EvaluationBaseStep::EvaluationBaseStep(const ParameterConstRef _parameters, const HLS_managerRef _HLSMgr, const unsigned _function_id, const DesignFlowManagerConstRef _design_flow_manager, const HLSFlowStep_Type _hls_flow_step_type)
     : HLSFunctionStep(_parameters, _HLSMgr, _function_id, _design_flow_manager, _hls_flow_step_type)
 {
@@ -52,3 +66,74 @@ const std::vector<double>& EvaluationBaseStep::GetEvaluations() const
 {
    return evaluations;
 }
+
+std::string EvaluationBaseStep::ComputeEvaluationCacheKey(const std::list<std::string>& input_files) const
+{
+   std::stringstream key;
+   key << GetSignature() << "\n" << parameters->getOption<std::string>(OPT_revision) << "\n" << parameters->getOption<std::string>(OPT_evaluation_objectives) << "\n";
+   std::list<std::string> files(HLSMgr->aux_files.begin(), HLSMgr->aux_files.end());
+   files.insert(files.end(), HLSMgr->hdl_files.begin(), HLSMgr->hdl_files.end());
+   files.insert(files.end(), input_files.begin(), input_files.end());
+   for(const auto& file_name : files)
+   {
+      if(not boost::filesystem::exists(file_name))
+      {
+         return "";
+      }
+      std::ifstream file(file_name);
+      key << boost::filesystem::path(file_name).filename().string() << "\n" << file.rdbuf() << "\n";
+   }
+   return key.str();
+}
+
+void EvaluationBaseStep::WriteCachedEvaluations(const std::string& cache_file, const std::list<std::string>& names) const
+{
+   std::ofstream file(cache_file);
+   for(const auto& name : names)
+   {
+      if(HLSMgr->evaluations.find(name) == HLSMgr->evaluations.end())
+      {
+         continue;
+      }
+      file << name;
+      for(const auto value : HLSMgr->evaluations.at(name))
+      {
+         file << " " << STR(value);
+      }
+      file << "\n";
+   }
+}
+
+bool EvaluationBaseStep::ReadCachedEvaluations(const std::string& cache_file)
+{
+   std::ifstream file(cache_file);
+   if(not file.is_open())
+   {
+      return false;
+   }
+   CustomMap<std::string, std::vector<double>> cached_evaluations;
+   std::string line;
+   while(std::getline(file, line))
+   {
+      std::istringstream evaluation(line);
+      std::string name;
+      if(not(evaluation >> name))
+      {
+         return false;
+      }
+      double value;
+      while(evaluation >> value)
+      {
+         cached_evaluations[name].push_back(value);
+      }
+      if(not evaluation.eof() or cached_evaluations[name].empty())
+      {
+         return false;
+      }
+   }
+   for(const auto& cached_evaluation : cached_evaluations)
+   {
+      HLSMgr->evaluations[cached_evaluation.first] = cached_evaluation.second;
+   }
+   return true;
+}
@@ -44,6 +44,11 @@
 #ifndef EVALUATION_BASE_STEP_HPP
 #define EVALUATION_BASE_STEP_HPP
 
+/// STD include
+#include <list>
+#include <string>
+#include <vector>
+
 /**
  * This class is the base class of evaluation steps
  */
@@ -59,6 +64,28 @@ class EvaluationBaseStep : public HLSFunctionStep
    /// store the result of the evaluation
    std::vector<double> evaluations;
 
+   /**
+    * Compute the common part of the step cache key of an evaluation: the signature of the step, the revision of the tool, the objectives and the content of the
+    * generated HDL files and of the additional input files
+    * @param input_files is the list of additional input files
+    * @return the key; empty if any of the files does not exist
+    */
+   std::string ComputeEvaluationCacheKey(const std::list<std::string>& input_files) const;
+
+   /**
+    * Write the values of some evaluations in a step cache file, one evaluation per line
+    * @param cache_file is the file to be written
+    * @param names is the list of the evaluations to be written; the ones which have not been computed are skipped
+    */
+   void WriteCachedEvaluations(const std::string& cache_file, const std::list<std::string>& names) const;
+
+   /**
+    * Read the evaluations stored in a step cache file
+    * @param cache_file is the file to be read
+    * @return true if the file has been correctly read
+    */
+   bool ReadCachedEvaluations(const std::string& cache_file);
+
  public:
    /**
     * Constructor
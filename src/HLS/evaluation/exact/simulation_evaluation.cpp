@@ -50,6 +50,9 @@
 // include from HLS/simulation
 #include "SimulationInformation.hpp"
 
+/// constants include
+#include "testbench_generation_constants.hpp"
+
 /// STD include
 #include <string>
 
@@ -133,3 +136,30 @@ DesignFlowStep_Status SimulationEvaluation::InternalExec()
 
    return DesignFlowStep_Status::SUCCESS;
 }
+
+std::string SimulationEvaluation::ComputeCacheKey() const
+{
+   /// the waveforms and the traces used by the discrepancy analysis are not stored in the cache
+   if((parameters->isOption(OPT_discrepancy) and parameters->getOption<bool>(OPT_discrepancy)) or (parameters->isOption(OPT_discrepancy_hw) and parameters->getOption<bool>(OPT_discrepancy_hw)) or
+      (parameters->isOption(OPT_generate_vcd) and parameters->getOption<bool>(OPT_generate_vcd)))
+   {
+      return "";
+   }
+   const std::string values_file = parameters->getOption<std::string>(OPT_output_directory) + "/simulation/" + STR_CST_testbench_generation_basename + ".txt";
+   const auto key = ComputeEvaluationCacheKey({HLSMgr->RSim->filename_bench, values_file});
+   if(key.empty())
+   {
+      return "";
+   }
+   return key + parameters->getOption<std::string>(OPT_simulator) + "\n" + parameters->getOption<std::string>(OPT_max_sim_cycles) + "\n";
+}
+
+bool SimulationEvaluation::LoadCachedResult(const std::string& cache_file)
+{
+   return ReadCachedEvaluations(cache_file);
+}
+
+void SimulationEvaluation::StoreCachedResult(const std::string& cache_file) const
+{
+   WriteCachedEvaluations(cache_file, {"TOTAL_CYCLES", "CYCLES", "NUM_EXECUTIONS"});
+}
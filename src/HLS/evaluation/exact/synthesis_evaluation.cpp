@@ -221,3 +221,34 @@ DesignFlowStep_Status SynthesisEvaluation::InternalExec()
    }
    return DesignFlowStep_Status::SUCCESS;
 }
+
+std::string SynthesisEvaluation::ComputeCacheKey() const
+{
+   std::list<std::string> input_files;
+   if(parameters->isOption(OPT_backend_script_extensions))
+   {
+      input_files.push_back(parameters->getOption<std::string>(OPT_backend_script_extensions));
+   }
+   if(parameters->isOption(OPT_backend_sdc_extensions))
+   {
+      input_files.push_back(parameters->getOption<std::string>(OPT_backend_sdc_extensions));
+   }
+   const auto key = ComputeEvaluationCacheKey(input_files);
+   if(key.empty())
+   {
+      return "";
+   }
+   const double clock_period = HLSMgr->get_HLS(*(HLSMgr->CGetCallGraphManager()->GetRootFunctions().begin()))->HLS_C->get_clock_period();
+   return key + (parameters->isOption(OPT_device_string) ? parameters->getOption<std::string>(OPT_device_string) : "") + "\n" +
+          (parameters->isOption(OPT_target_device_file) ? parameters->getOption<std::string>(OPT_target_device_file) : "") + "\n" + STR(clock_period) + "\n" + STR(parameters->getOption<bool>(OPT_connect_iob)) + "\n";
+}
+
+bool SynthesisEvaluation::LoadCachedResult(const std::string& cache_file)
+{
+   return ReadCachedEvaluations(cache_file);
+}
+
+void SynthesisEvaluation::StoreCachedResult(const std::string& cache_file) const
+{
+   WriteCachedEvaluations(cache_file, {"SLICE", "SLICE_LUTS", "LUT_FF_PAIRS", "LOGIC_ELEMENTS", "FUNCTIONAL_ELEMENTS", "ALMS", "AREA", "BRAMS", "CLOCK_SLACK", "PERIOD", "DSPS", "FREQUENCY", "REGISTERS"});
+}
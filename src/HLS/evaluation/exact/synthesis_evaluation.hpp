@@ -78,5 +78,24 @@ class SynthesisEvaluation : public EvaluationBaseStep
     * @return the exit status of this step
     */
    DesignFlowStep_Status InternalExec() override;
+
+   /**
+    * Compute the key of the result of this step in the persistent step cache
+    * @return the key
+    */
+   std::string ComputeCacheKey() const override;
+
+   /**
+    * Restore the evaluations from the persistent step cache
+    * @param cache_file is the file storing the evaluations
+    * @return true if the evaluations have been restored
+    */
+   bool LoadCachedResult(const std::string& cache_file) override;
+
+   /**
+    * Store the evaluations in the persistent step cache
+    * @param cache_file is the file where the evaluations have to be written
+    */
+   void StoreCachedResult(const std::string& cache_file) const override;
 };
 #endif
@@ -95,6 +95,11 @@ const CustomUnorderedSet<std::tuple<HLSFlowStep_Type, HLSFlowStepSpecializationC
 #endif
          ret.insert(std::make_tuple(synthesis_flow, HLSFlowStepSpecializationConstRef(), HLSFlowStep_Relationship::SAME_FUNCTION));
          ret.insert(std::make_tuple(parameters->getOption<HLSFlowStep_Type>(OPT_datapath_architecture), HLSFlowStepSpecializationConstRef(), HLSFlowStep_Relationship::SAME_FUNCTION));
+         /// the modulo schedules are only reported, so they are computed only on request
+         if(parameters->isOption(OPT_modulo_scheduling_report) and parameters->getOption<bool>(OPT_modulo_scheduling_report) and HLSMgr->CGetFunctionBehavior(funId)->is_pipelining_enabled())
+         {
+            ret.insert(std::make_tuple(HLSFlowStep_Type::MODULO_SCHEDULING, HLSFlowStepSpecializationConstRef(), HLSFlowStep_Relationship::SAME_FUNCTION));
+         }
          if(HLSMgr->get_HLS(funId))
             ret.insert(std::make_tuple(HLSMgr->get_HLS(funId)->controller_type, HLSFlowStepSpecializationConstRef(), HLSFlowStep_Relationship::SAME_FUNCTION));
          HLSFlowStep_Type top_entity_type;
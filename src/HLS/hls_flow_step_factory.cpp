@@ -231,6 +231,7 @@
 #include "ilp_scheduling.hpp"
 #include "ilp_scheduling_new.hpp"
 #endif
+#include "modulo_scheduling.hpp"
 #include "parametric_list_based.hpp"
 #include "scheduling.hpp"
 #if HAVE_ILP_BUILT
@@ -613,6 +614,11 @@ DesignFlowStepRef HLSFlowStepFactory::CreateHLSFlowStep(const HLSFlowStep_Type t
          design_flow_step = DesignFlowStepRef(new MinimalInterfaceTestbench(parameters, HLS_mgr, design_flow_manager.lock()));
          break;
       }
+      case HLSFlowStep_Type::MODULO_SCHEDULING:
+      {
+         design_flow_step = DesignFlowStepRef(new ModuloScheduling(parameters, HLS_mgr, funId, design_flow_manager.lock()));
+         break;
+      }
       case HLSFlowStep_Type::MUX_INTERCONNECTION_BINDING:
       {
          design_flow_step = DesignFlowStepRef(new mux_connection_binding(parameters, HLS_mgr, funId, design_flow_manager.lock()));
@@ -980,6 +986,7 @@ const DesignFlowStepSet HLSFlowStepFactory::CreateHLSFlowSteps(const CustomUnord
 #endif
          case HLSFlowStep_Type::MINIMAL_INTERFACE_GENERATION:
          case HLSFlowStep_Type::MINIMAL_TESTBENCH_GENERATION:
+         case HLSFlowStep_Type::MODULO_SCHEDULING:
          case HLSFlowStep_Type::MUX_INTERCONNECTION_BINDING:
 #if HAVE_EXPERIMENTAL
          case HLSFlowStep_Type::NPI_INTERFACE_GENERATION:
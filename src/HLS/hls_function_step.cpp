@@ -188,6 +188,36 @@ void HLSFunctionStep::ComputeRelationships(DesignFlowStepSet& design_flow_step_s
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Computing relationships of " + GetName());
 }
 
+bool HLSFunctionStep::IsFunctionLocal() const
+{
+   return false;
+}
+
+bool HLSFunctionStep::IsParallelizable() const
+{
+   if(not funId or not IsFunctionLocal())
+   {
+      return false;
+   }
+   /// steps reading the HLS data structures of other functions could see them while they are modified
+   for(const auto relationship_type : {DEPENDENCE_RELATIONSHIP, PRECEDENCE_RELATIONSHIP})
+   {
+      for(const auto& hls_relationship : ComputeHLSRelationships(relationship_type))
+      {
+         if(std::get<2>(hls_relationship) == HLSFlowStep_Relationship::CALLED_FUNCTIONS or std::get<2>(hls_relationship) == HLSFlowStep_Relationship::ALL_FUNCTIONS)
+         {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+std::string HLSFunctionStep::GetParallelGroup() const
+{
+   return "HLS::" + STR(funId);
+}
+
 DesignFlowStep_Status HLSFunctionStep::Exec()
 {
    const auto status = InternalExec();
@@ -68,6 +68,13 @@ class HLSFunctionStep : public HLS_step
     */
    virtual DesignFlowStep_Status InternalExec() = 0;
 
+   /**
+    * Check if InternalExec only reads the intermediate representation and writes only the HLS data structures of the analyzed function
+    * Steps returning true can be executed concurrently with steps synthesizing other functions
+    * @return true if the step does not modify data of other functions or global data structures
+    */
+   virtual bool IsFunctionLocal() const;
+
  public:
    /**
     * Constructor
@@ -123,6 +130,17 @@ class HLSFunctionStep : public HLS_step
     */
    void ComputeRelationships(DesignFlowStepSet& relationship, const DesignFlowStep::RelationshipType relationship_type) override;
 
+   /**
+    * Check if this step can be executed concurrently with steps synthesizing other functions
+    * @return true if the step is function local and it does not depend on steps of other functions
+    */
+   bool IsParallelizable() const override;
+
+   /**
+    * Return the group of this step: steps synthesizing the same function are never executed concurrently
+    */
+   std::string GetParallelGroup() const override;
+
    /**
     * Execute the step
     * @return the exit status of this step
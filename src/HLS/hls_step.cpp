@@ -264,6 +264,8 @@ const std::string HLS_step::EnumToName(const HLSFlowStep_Type hls_flow_step_type
          return "InferInterfaceGeneration";
       case HLSFlowStep_Type::MINIMAL_TESTBENCH_GENERATION:
          return "MinimalTestbenchGeneration";
+      case HLSFlowStep_Type::MODULO_SCHEDULING:
+         return "ModuloScheduling";
       case HLSFlowStep_Type::MUX_INTERCONNECTION_BINDING:
          return "MuxInterconnectionBinding";
 #if HAVE_EXPERIMENTAL
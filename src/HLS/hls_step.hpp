@@ -183,6 +183,7 @@ enum class HLSFlowStep_Type
 #endif
    MINIMAL_INTERFACE_GENERATION,
    MINIMAL_TESTBENCH_GENERATION,
+   MODULO_SCHEDULING,
    MUX_INTERCONNECTION_BINDING,
 #if HAVE_EXPERIMENTAL
    NPI_INTERFACE_GENERATION,
@@ -64,6 +64,111 @@
 #include "loop.hpp"
 #include "loops.hpp"
 
+/// STD include
+#include <algorithm>
+#include <iterator>
+
+LiveSet::LiveSet() : dense(false)
+{
+}
+
+void LiveSet::MakeDense(size_t universe)
+{
+   bits.resize(universe);
+   for(const auto index : elements)
+      bits.set(index);
+   elements.clear();
+   elements.shrink_to_fit();
+   dense = true;
+}
+
+void LiveSet::Insert(size_t index, size_t universe)
+{
+   if(dense)
+   {
+      if(index >= bits.size())
+         bits.resize(index + 1);
+      bits.set(index);
+      return;
+   }
+   const auto position = std::lower_bound(elements.begin(), elements.end(), index);
+   if(position != elements.end() and *position == index)
+      return;
+   elements.insert(position, index);
+   /// a word of the bitset costs as much as an index of the sorted vector
+   if(elements.size() * boost::dynamic_bitset<>::bits_per_block > universe)
+      MakeDense(universe);
+}
+
+void LiveSet::Erase(size_t index)
+{
+   if(dense)
+   {
+      if(index < bits.size())
+         bits.reset(index);
+      return;
+   }
+   const auto position = std::lower_bound(elements.begin(), elements.end(), index);
+   if(position != elements.end() and *position == index)
+      elements.erase(position);
+}
+
+bool LiveSet::Contains(size_t index) const
+{
+   if(dense)
+      return index < bits.size() and bits.test(index);
+   return std::binary_search(elements.begin(), elements.end(), index);
+}
+
+void LiveSet::Union(const LiveSet& other, size_t universe)
+{
+   if(&other == this)
+      return;
+   if(not dense and not other.dense)
+   {
+      std::vector<size_t> merged;
+      merged.reserve(elements.size() + other.elements.size());
+      std::set_union(elements.begin(), elements.end(), other.elements.begin(), other.elements.end(), std::back_inserter(merged));
+      elements.swap(merged);
+      if(elements.size() * boost::dynamic_bitset<>::bits_per_block > universe)
+         MakeDense(universe);
+      return;
+   }
+   if(not dense)
+      MakeDense(universe);
+   if(other.dense)
+   {
+      if(other.bits.size() > bits.size())
+         bits.resize(other.bits.size());
+      if(other.bits.size() == bits.size())
+      {
+         bits |= other.bits;
+      }
+      else
+      {
+         auto other_bits = other.bits;
+         other_bits.resize(bits.size());
+         bits |= other_bits;
+      }
+   }
+   else
+   {
+      for(const auto index : other.elements)
+         Insert(index, universe);
+   }
+}
+
+void LiveSet::GetElements(std::vector<size_t>& indices) const
+{
+   if(not dense)
+   {
+      indices.insert(indices.end(), elements.begin(), elements.end());
+      return;
+   }
+   for(auto index = bits.find_first(); index != boost::dynamic_bitset<>::npos; index = bits.find_next(index))
+      indices.push_back(index);
+}
+
 liveness::liveness(const HLS_managerRef _HLSMgr, const ParameterConstRef _Param) : TreeM(_HLSMgr->get_tree_manager()), Param(_Param), null_vertex_string("NULL_VERTEX"), HLSMgr(_HLSMgr)
 
 {
@@ -79,60 +184,126 @@ bool liveness::is_defined(unsigned int var) const
    return false;
 }
 
+size_t liveness::get_variable_index(unsigned int var)
+{
+   const auto variable_index = variable_indices.find(var);
+   if(variable_index != variable_indices.end())
+      return variable_index->second;
+   const auto index = indexed_variables.size();
+   variable_indices[var] = index;
+   indexed_variables.push_back(var);
+   return index;
+}
+
+std::vector<unsigned int> liveness::get_variables(const LiveSet& live_set) const
+{
+   std::vector<size_t> indices;
+   live_set.GetElements(indices);
+   std::vector<unsigned int> variables;
+   variables.reserve(indices.size());
+   for(const auto index : indices)
+      variables.push_back(indexed_variables[index]);
+   std::sort(variables.begin(), variables.end());
+   return variables;
+}
+
 void liveness::set_live_in(const vertex& v, unsigned int var)
 {
-   live_in[v].insert(var);
+   const auto index = get_variable_index(var);
+   live_in[v].Insert(index, indexed_variables.size());
 }
 
 void liveness::set_live_in(const vertex& v, const CustomOrderedSet<unsigned int>& live_set)
 {
-   live_in[v].insert(live_set.begin(), live_set.end());
+   set_live_in(v, live_set.begin(), live_set.end());
 }
 
 void liveness::set_live_in(const vertex& v, const CustomOrderedSet<unsigned int>::const_iterator first, const CustomOrderedSet<unsigned int>::const_iterator last)
 {
-   live_in[v].insert(first, last);
+   auto& target = live_in[v];
+   for(auto var = first; var != last; var++)
+   {
+      const auto index = get_variable_index(*var);
+      target.Insert(index, indexed_variables.size());
+   }
+}
+
+void liveness::set_live_in_from_live_out(const vertex& v, const vertex& source)
+{
+   auto& target = live_in[v];
+   const auto live_set = live_out.find(source);
+   if(live_set != live_out.end())
+      target.Union(live_set->second, indexed_variables.size());
 }
 
 void liveness::erase_el_live_in(const vertex& v, unsigned int var)
 {
-   live_in[v].erase(var);
+   const auto variable_index = variable_indices.find(var);
+   if(variable_index != variable_indices.end())
+      live_in[v].Erase(variable_index->second);
 }
 
-const CustomOrderedSet<unsigned int>& liveness::get_live_in(const vertex& v) const
+std::vector<unsigned int> liveness::get_live_in(const vertex& v) const
 {
-   if(live_in.find(v) != live_in.end())
-      return live_in.find(v)->second;
+   const auto live_set = live_in.find(v);
+   if(live_set != live_in.end())
+      return get_variables(live_set->second);
    else
-      return empty_set;
+      return std::vector<unsigned int>();
+}
+
+bool liveness::is_live_in(const vertex& v, unsigned int var) const
+{
+   const auto live_set = live_in.find(v);
+   if(live_set == live_in.end())
+      return false;
+   const auto variable_index = variable_indices.find(var);
+   return variable_index != variable_indices.end() and live_set->second.Contains(variable_index->second);
 }
 
 void liveness::set_live_out(const vertex& v, unsigned int var)
 {
-   live_out[v].insert(var);
+   const auto index = get_variable_index(var);
+   live_out[v].Insert(index, indexed_variables.size());
 }
 
 void liveness::set_live_out(const vertex& v, const CustomOrderedSet<unsigned int>& vars)
 {
-   live_out[v].insert(vars.begin(), vars.end());
+   set_live_out(v, vars.begin(), vars.end());
 }
 
 void liveness::set_live_out(const vertex& v, const CustomOrderedSet<unsigned int>::const_iterator first, const CustomOrderedSet<unsigned int>::const_iterator last)
 {
-   live_out[v].insert(first, last);
+   auto& target = live_out[v];
+   for(auto var = first; var != last; var++)
+   {
+      const auto index = get_variable_index(*var);
+      target.Insert(index, indexed_variables.size());
+   }
+}
+
+void liveness::set_live_out_from_live_out(const vertex& v, const vertex& source)
+{
+   auto& target = live_out[v];
+   const auto live_set = live_out.find(source);
+   if(live_set != live_out.end())
+      target.Union(live_set->second, indexed_variables.size());
 }
 
 void liveness::erase_el_live_out(const vertex& v, unsigned int var)
 {
-   live_out[v].erase(var);
+   const auto variable_index = variable_indices.find(var);
+   if(variable_index != variable_indices.end())
+      live_out[v].Erase(variable_index->second);
 }
 
-const CustomOrderedSet<unsigned int>& liveness::get_live_out(const vertex& v) const
+std::vector<unsigned int> liveness::get_live_out(const vertex& v) const
 {
-   if(live_out.find(v) != live_out.end())
-      return live_out.find(v)->second;
+   const auto live_set = live_out.find(v);
+   if(live_set != live_out.end())
+      return get_variables(live_set->second);
    else
-      return empty_set;
+      return std::vector<unsigned int>();
 }
 
 vertex liveness::get_op_where_defined(unsigned int var) const
@@ -148,50 +319,36 @@ bool liveness::has_op_where_defined(unsigned int var) const
 
 const CustomOrderedSet<vertex>& liveness::get_state_in(vertex state, vertex op, unsigned int var) const
 {
-   THROW_ASSERT(state_in_definitions.find(state) != state_in_definitions.end(), "state never used " + get_name(state));
-   THROW_ASSERT(state_in_definitions.find(state)->second.find(op) != state_in_definitions.find(state)->second.end(), "op never used in state " + get_name(state));
-   THROW_ASSERT(state_in_definitions.find(state)->second.find(op)->second.find(var) != state_in_definitions.find(state)->second.find(op)->second.end(), "var never used in the given state. Var: " + std::to_string(var));
-   return state_in_definitions.find(state)->second.find(op)->second.find(var)->second;
+   const auto definition = state_in_definitions.find(std::make_tuple(state, op, var));
+   THROW_ASSERT(definition != state_in_definitions.end(), "var never used in the given state " + get_name(state) + ". Var: " + std::to_string(var));
+   return definition->second;
 }
 
 bool liveness::has_state_in(vertex state, vertex op, unsigned int var) const
 {
-   if(state_in_definitions.find(state) == state_in_definitions.end())
-      return false;
-   if(state_in_definitions.find(state)->second.find(op) == state_in_definitions.find(state)->second.end())
-      return false;
-   if(state_in_definitions.find(state)->second.find(op)->second.find(var) == state_in_definitions.find(state)->second.find(op)->second.end())
-      return false;
-   return true;
+   return state_in_definitions.find(std::make_tuple(state, op, var)) != state_in_definitions.end();
 }
 
 void liveness::add_state_in_for_var(unsigned int var, vertex op, vertex state, vertex state_in)
 {
-   state_in_definitions[state][op][var].insert(state_in);
+   state_in_definitions[std::make_tuple(state, op, var)].insert(state_in);
 }
 
 const CustomOrderedSet<vertex>& liveness::get_state_out(vertex state, vertex op, unsigned int var) const
 {
-   THROW_ASSERT(state_out_definitions.find(state) != state_out_definitions.end(), "state never used " + get_name(state));
-   THROW_ASSERT(state_out_definitions.find(state)->second.find(op) != state_out_definitions.find(state)->second.end(), "op never used in state " + get_name(state));
-   THROW_ASSERT(state_out_definitions.find(state)->second.find(op)->second.find(var) != state_out_definitions.find(state)->second.find(op)->second.end(), "var never used in the given state. Var: " + std::to_string(var));
-   return state_out_definitions.find(state)->second.find(op)->second.find(var)->second;
+   const auto definition = state_out_definitions.find(std::make_tuple(state, op, var));
+   THROW_ASSERT(definition != state_out_definitions.end(), "var never used in the given state " + get_name(state) + ". Var: " + std::to_string(var));
+   return definition->second;
 }
 
 bool liveness::has_state_out(vertex state, vertex op, unsigned int var) const
 {
-   if(state_out_definitions.find(state) == state_out_definitions.end())
-      return false;
-   if(state_out_definitions.find(state)->second.find(op) == state_out_definitions.find(state)->second.end())
-      return false;
-   if(state_out_definitions.find(state)->second.find(op)->second.find(var) == state_out_definitions.find(state)->second.find(op)->second.end())
-      return false;
-   return true;
+   return state_out_definitions.find(std::make_tuple(state, op, var)) != state_out_definitions.end();
 }
 
 void liveness::add_state_out_for_var(unsigned int var, vertex op, vertex state, vertex state_in)
 {
-   state_out_definitions[state][op][var].insert(state_in);
+   state_out_definitions[std::make_tuple(state, op, var)].insert(state_in);
 }
 
 const CustomOrderedSet<vertex>& liveness::get_state_where_end(vertex op) const
@@ -52,8 +52,11 @@
 #include "graph.hpp"
 
 /// STD include
+#include <boost/dynamic_bitset.hpp>
 #include <list>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "custom_map.hpp"
 #include "custom_set.hpp"
@@ -72,6 +75,67 @@ CONSTREF_FORWARD_DECL(BBGraph);
 REF_FORWARD_DECL(tree_manager);
 //@}
 
+/**
+ * Set of variables identified by dense indices.
+ * Small sets are stored as sorted vectors of indices; when the number of elements makes a bitset smaller, the set switches to one bit per variable
+ */
+class LiveSet
+{
+ private:
+   /// The sorted indices of the variables when the sparse representation is used
+   std::vector<size_t> elements;
+
+   /// The bits of the variables when the dense representation is used
+   boost::dynamic_bitset<> bits;
+
+   /// True if the dense representation is used
+   bool dense;
+
+   /**
+    * Switch to the dense representation
+    * @param universe is the current number of variables
+    */
+   void MakeDense(size_t universe);
+
+ public:
+   /**
+    * Constructor
+    */
+   LiveSet();
+
+   /**
+    * Add a variable
+    * @param index is the index of the variable
+    * @param universe is the current number of variables
+    */
+   void Insert(size_t index, size_t universe);
+
+   /**
+    * Remove a variable
+    * @param index is the index of the variable
+    */
+   void Erase(size_t index);
+
+   /**
+    * Return true if the variable belongs to the set
+    * @param index is the index of the variable
+    */
+   bool Contains(size_t index) const;
+
+   /**
+    * Add all the variables of another set
+    * @param other is the set to be merged
+    * @param universe is the current number of variables
+    */
+   void Union(const LiveSet& other, size_t universe);
+
+   /**
+    * Return the indices of the variables of the set in increasing order
+    * @param indices is where indices are appended
+    */
+   void GetElements(std::vector<size_t>& indices) const;
+};
+
 class liveness
 {
  private:
@@ -81,18 +145,21 @@ class liveness
    /// class containing all the parameters
    const ParameterConstRef Param;
 
+   /// The dense index of each variable appearing in a live set
+   CustomUnorderedMap<unsigned int, size_t> variable_indices;
+
+   /// The variables sorted by dense index
+   std::vector<unsigned int> indexed_variables;
+
    /// This is the map from each vertex to the set of variables live at the input of vertex.
-   std::map<vertex, CustomOrderedSet<unsigned int>> live_in;
+   CustomUnorderedMap<vertex, LiveSet> live_in;
 
    /// This is the map from each vertex to the set of variables live at the output of vertex.
-   std::map<vertex, CustomOrderedSet<unsigned int>> live_out;
+   CustomUnorderedMap<vertex, LiveSet> live_out;
 
    /// null vertex string
    const std::string null_vertex_string;
 
-   /// used to return a reference to an empty set
-   const CustomOrderedSet<unsigned int> empty_set;
-
    /// vertex over which the live in/out is computed
    std::list<vertex> support_set;
 
@@ -105,11 +172,11 @@ class liveness
    /// store where an operation run and need its input
    std::map<vertex, CustomOrderedSet<vertex>> running_operations;
 
-   /// store where a variable comes from given a support state and an operation
-   std::map<vertex, std::map<vertex, std::map<unsigned int, CustomOrderedSet<vertex>>>> state_in_definitions;
+   /// store where a variable comes from given a support state and an operation; key is the tuple state - operation - variable
+   std::map<std::tuple<vertex, vertex, unsigned int>, CustomOrderedSet<vertex>> state_in_definitions;
 
-   /// store along which transitions the variable has to be stored
-   std::map<vertex, std::map<vertex, std::map<unsigned int, CustomOrderedSet<vertex>>>> state_out_definitions;
+   /// store along which transitions the variable has to be stored; key is the tuple state - operation - variable
+   std::map<std::tuple<vertex, vertex, unsigned int>, CustomOrderedSet<vertex>> state_out_definitions;
 
    /// store the name of each state
    std::map<vertex, std::string> names;
@@ -123,6 +190,19 @@ class liveness
 
    CustomOrderedSet<vertex> dummy_states;
 
+   /**
+    * Return the dense index of a variable, numbering it if it is the first time it is considered
+    * @param var is the identifier of the variable
+    */
+   size_t get_variable_index(unsigned int var);
+
+   /**
+    * Return the identifiers of the variables of a live set
+    * @param live_set is the live set
+    * @return the identifiers of the variables in increasing order
+    */
+   std::vector<unsigned int> get_variables(const LiveSet& live_set) const;
+
  public:
    /**
     * Constructor
@@ -195,18 +275,39 @@ class liveness
    void erase_el_live_out(const vertex& v, unsigned int var);
 
    /**
-    * Get the set of variables live at the input of a vertex
+    * Add to the live out of a vertex the variables alive at the output of another vertex
+    * @param v is the vertex to be updated
+    * @param source is the vertex whose live out is added
+    */
+   void set_live_out_from_live_out(const vertex& v, const vertex& source);
+
+   /**
+    * Add to the live in of a vertex the variables alive at the output of another vertex
+    * @param v is the vertex to be updated
+    * @param source is the vertex whose live out is added
+    */
+   void set_live_in_from_live_out(const vertex& v, const vertex& source);
+
+   /**
+    * Get the variables live at the input of a vertex
+    * @param v is the vertex
+    * @return the identifiers of the variables in increasing order
+    */
+   std::vector<unsigned int> get_live_in(const vertex& v) const;
+
+   /**
+    * Get the variables live at the output of a vertex
     * @param v is the vertex
-    * @return a set containing the identifiers of the variables
+    * @return the identifiers of the variables in increasing order
     */
-   const CustomOrderedSet<unsigned int>& get_live_in(const vertex& v) const;
+   std::vector<unsigned int> get_live_out(const vertex& v) const;
 
    /**
-    * Get the set of variables live at the output of a vertex
+    * Check if a variable is live at the input of a vertex
     * @param v is the vertex
-    * @return a set containing the identifiers of the variables
+    * @param var is the identifier of the variable
     */
-   const CustomOrderedSet<unsigned int>& get_live_out(const vertex& v) const;
+   bool is_live_in(const vertex& v, unsigned int var) const;
 
    /// map a chained vertex with one of the starting operation
    std::map<vertex, vertex> start_op;
@@ -49,6 +49,7 @@
 #include "exceptions.hpp"
 #include "function_behavior.hpp"
 #include "graph.hpp"
+#include "graph_snapshot.hpp"
 #include "hls.hpp"
 #include "hls_constraints.hpp"
 #include "hls_manager.hpp"
@@ -111,6 +112,11 @@ ASLAP::ASLAP(const HLS_managerConstRef _hls_manager, const hlsRef HLS, const boo
       if(operations.find(l) != operations.end())
          levels.push_back(l);
    }
+   beh_snapshot = GraphSnapshotConstRef(new GraphSnapshot(*beh_graph));
+   for(const auto l : levels)
+   {
+      level_indices.push_back(beh_snapshot->IsIn(l) ? beh_snapshot->GetIndex(l) : beh_snapshot->NumVertices());
+   }
 }
 
 const OpGraphConstRef ASLAP::CGetOpGraph() const
@@ -243,15 +249,11 @@ void ASLAP::add_constraints_to_ASAP()
 
 void ASLAP::compute_ASAP(const ScheduleConstRef partial_schedule)
 {
-   vertex vi;
-   InEdgeIterator ei, ei_end;
    // Store the current execution time
    double cur_start;
-   vertex2float finish_time; //
+   std::vector<double> finish_time(beh_snapshot->NumVertices(), 0.0);
 
    ASAP->clear();
-   finish_time.clear();                                 //
-   finish_time.resize(levels.begin(), levels.end(), 0); //
    min_tot_csteps = ControlStep(0u);
    if(partial_schedule)
    {
@@ -272,25 +274,26 @@ void ASLAP::compute_ASAP(const ScheduleConstRef partial_schedule)
       add_constraints_to_ASAP();
    }
 
-   for(std::deque<vertex>::const_iterator i = levels.begin(); i != levels.end(); ++i)
+   for(size_t level = 0; level < levels.size(); level++)
    {
+      const auto i = levels.begin() + static_cast<std::ptrdiff_t>(level);
       if(!beh_graph->is_in_subset(*i))
          continue;
+      const auto index = level_indices[level];
       const auto op_cycles = GetCycleLatency(*i, Allocation_MinMax::MIN);
       cur_start = 0.0;
 
-      for(boost::tie(ei, ei_end) = boost::in_edges(*i, *beh_graph); ei != ei_end; ei++)
+      const auto predecessors = beh_snapshot->Predecessors(index);
+      for(auto predecessor = predecessors.first; predecessor != predecessors.second; predecessor++)
       {
-         vi = boost::source(*ei, *beh_graph);
-         cur_start = finish_time[vi] < cur_start ? cur_start : finish_time[vi];
-         //       PRINT_DBG_MEX(DEBUG_LEVEL_VERBOSE, debug_level, GET_NAME(beh_graph, vi) + " -> " +GET_NAME(beh_graph, *i) + " cur_start " + boost::lexical_cast<std::string>(cur_start));
+         cur_start = finish_time[*predecessor] < cur_start ? cur_start : finish_time[*predecessor];
       }
 
-      finish_time[*i] = cur_start + from_strongtype_cast<double>(op_cycles);
+      finish_time[index] = cur_start + from_strongtype_cast<double>(op_cycles);
       ControlStep curr_asap = ASAP->is_scheduled(*i) ? ASAP->get_cstep(*i).second : ControlStep(0u);
       curr_asap = ControlStep(static_cast<unsigned int>(cur_start / ctrl_step_multiplier)) > curr_asap ? ControlStep(static_cast<unsigned int>(cur_start / ctrl_step_multiplier)) : curr_asap;
       ASAP->set_execution(*i, curr_asap);
-      PRINT_DBG_MEX(DEBUG_LEVEL_VERBOSE, debug_level, GET_NAME(beh_graph, *i) + " cur_start " + boost::lexical_cast<std::string>(cur_start) + " finish_time[*i] " + boost::lexical_cast<std::string>(finish_time[*i]));
+      PRINT_DBG_MEX(DEBUG_LEVEL_VERBOSE, debug_level, GET_NAME(beh_graph, *i) + " cur_start " + boost::lexical_cast<std::string>(cur_start) + " finish_time[*i] " + boost::lexical_cast<std::string>(finish_time[index]));
       min_tot_csteps = min_tot_csteps < curr_asap ? curr_asap : min_tot_csteps;
       PRINT_DBG_MEX(DEBUG_LEVEL_PEDANTIC, debug_level, GET_NAME(beh_graph, *i) + " - " + STR(ASAP->get_cstep(*i).second));
    }
@@ -458,29 +461,26 @@ void ASLAP::update_ALAP(const ControlStep maxc, bool* feasible, const ScheduleCo
 void ASLAP::compute_ALAP_fast(bool* feasible)
 {
    // This function is used both in fast case and
-   vertex vi;
-   OutEdgeIterator ei, ei_end;
    double cur_rev_start;
-   vertex2float Rev_finish_time;                            //
-   Rev_finish_time.clear();                                 //
-   Rev_finish_time.resize(levels.begin(), levels.end(), 0); //
+   std::vector<double> Rev_finish_time(beh_snapshot->NumVertices(), 0.0);
 
-   std::deque<vertex>::const_reverse_iterator i_end = levels.rend();
-   for(std::deque<vertex>::const_reverse_iterator i = levels.rbegin(); i != i_end; ++i)
+   for(size_t level = levels.size(); level > 0; level--)
    {
+      const auto i = levels.begin() + static_cast<std::ptrdiff_t>(level - 1);
       if(!beh_graph->is_in_subset(*i))
          continue;
+      const auto index = level_indices[level - 1];
       const auto op_cycles = GetCycleLatency(*i, Allocation_MinMax::MIN);
       cur_rev_start = 0.0;
-      for(boost::tie(ei, ei_end) = boost::out_edges(*i, *beh_graph); ei != ei_end; ei++)
+      const auto successors = beh_snapshot->Successors(index);
+      for(auto successor = successors.first; successor != successors.second; successor++)
       {
-         vi = boost::target(*ei, *beh_graph);
-         cur_rev_start = Rev_finish_time[vi] < cur_rev_start ? cur_rev_start : Rev_finish_time[vi];
+         cur_rev_start = Rev_finish_time[*successor] < cur_rev_start ? cur_rev_start : Rev_finish_time[*successor];
       }
-      Rev_finish_time[*i] = cur_rev_start + from_strongtype_cast<double>(op_cycles);
+      Rev_finish_time[index] = cur_rev_start + from_strongtype_cast<double>(op_cycles);
 
       ControlStep rev_curr_alap = ALAP->is_scheduled(*i) ? ALAP->get_cstep(*i).second : ControlStep(0u);
-      const auto rev_finish_time = ControlStep(static_cast<unsigned int>((Rev_finish_time[*i] - 1) / ctrl_step_multiplier));
+      const auto rev_finish_time = ControlStep(static_cast<unsigned int>((Rev_finish_time[index] - 1) / ctrl_step_multiplier));
       rev_curr_alap = rev_finish_time > rev_curr_alap ? rev_finish_time : rev_curr_alap;
       ALAP->set_execution(*i, rev_curr_alap);
       max_tot_csteps = max_tot_csteps < rev_curr_alap ? rev_curr_alap : max_tot_csteps;
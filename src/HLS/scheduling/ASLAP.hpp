@@ -45,6 +45,7 @@
 
 #include <deque>
 #include <iosfwd>
+#include <vector>
 
 #include "graph.hpp"
 #include "refcount.hpp"
@@ -57,6 +58,7 @@
  */
 //@{
 CONSTREF_FORWARD_DECL(AllocationInformation);
+CONSTREF_FORWARD_DECL(GraphSnapshot);
 REF_FORWARD_DECL(HLS_constraints);
 CONSTREF_FORWARD_DECL(Schedule);
 REF_FORWARD_DECL(Schedule);
@@ -90,6 +92,12 @@ class ASLAP
    /// the graph to be scheduled
    OpGraphConstRef beh_graph;
 
+   /// the compressed sparse row copy of beh_graph used to visit predecessors and successors
+   GraphSnapshotConstRef beh_snapshot;
+
+   /// the dense indices in beh_snapshot of the vertices in levels
+   std::vector<size_t> level_indices;
+
    /// constant variable storing the reference to the array of vertexes sorted by topological order associated with
    /// the SDG(it can be used also for SG).
    std::deque<vertex> levels;
@@ -0,0 +1,507 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file modulo_scheduling.cpp
+ * @brief Implementation of the initiation interval analysis of innermost loops based on iterative modulo scheduling
+ *
+ */
+
+/// Header include
+#include "modulo_scheduling.hpp"
+
+///. include
+#include "Parameter.hpp"
+
+/// algorithms/loops_detection includes
+#include "loop.hpp"
+#include "loops.hpp"
+
+/// behavior includes
+#include "basic_block.hpp"
+#include "behavioral_helper.hpp"
+#include "function_behavior.hpp"
+#include "op_graph.hpp"
+
+/// HLS includes
+#include "hls.hpp"
+#include "hls_manager.hpp"
+
+/// HLS/module_allocation include
+#include "allocation_information.hpp"
+
+/// STD includes
+#include <algorithm>
+#include <set>
+
+/// utility includes
+#include "dbgPrintHelper.hpp"      // for DEBUG_LEVEL_
+#include "string_manipulation.hpp" // for GET_CLASS
+#include "utility.hpp"             // for INFINITE_UINT
+
+/// The number of scheduling attempts per operation before trying a larger initiation interval
+#define MODULO_SCHEDULING_BUDGET_RATIO 6
+
+ModuloScheduling::ModuloScheduling(const ParameterConstRef _parameters, const HLS_managerRef _HLSMgr, unsigned int _function_id, const DesignFlowManagerConstRef _design_flow_manager)
+    : HLSFunctionStep(_parameters, _HLSMgr, _function_id, _design_flow_manager, HLSFlowStep_Type::MODULO_SCHEDULING)
+{
+   debug_level = parameters->get_class_debug_level(GET_CLASS(*this));
+}
+
+ModuloScheduling::~ModuloScheduling() = default;
+
+const CustomUnorderedSet<std::tuple<HLSFlowStep_Type, HLSFlowStepSpecializationConstRef, HLSFlowStep_Relationship>> ModuloScheduling::ComputeHLSRelationships(const DesignFlowStep::RelationshipType relationship_type) const
+{
+   CustomUnorderedSet<std::tuple<HLSFlowStep_Type, HLSFlowStepSpecializationConstRef, HLSFlowStep_Relationship>> ret;
+   switch(relationship_type)
+   {
+      case DEPENDENCE_RELATIONSHIP:
+      {
+#if HAVE_FROM_PRAGMA_BUILT && HAVE_BAMBU_BUILT
+         if(parameters->getOption<bool>(OPT_parse_pragma))
+         {
+            ret.insert(std::make_tuple(HLSFlowStep_Type::OMP_ALLOCATION, HLSFlowStepSpecializationConstRef(), HLSFlowStep_Relationship::SAME_FUNCTION));
+         }
+         else
+#endif
+         {
+            ret.insert(std::make_tuple(HLSFlowStep_Type::ALLOCATION, HLSFlowStepSpecializationConstRef(), HLSFlowStep_Relationship::SAME_FUNCTION));
+         }
+         break;
+      }
+      case INVALIDATION_RELATIONSHIP:
+      {
+         break;
+      }
+      case PRECEDENCE_RELATIONSHIP:
+      {
+         break;
+      }
+      default:
+         THROW_UNREACHABLE("");
+   }
+   return ret;
+}
+
+bool ModuloScheduling::HasToBeExecuted() const
+{
+   return HLSMgr->CGetFunctionBehavior(funId)->is_pipelining_enabled() and HLSFunctionStep::HasToBeExecuted();
+}
+
+void ModuloScheduling::BuildDependenceGraph(const std::list<vertex>& loop_operations)
+{
+   const FunctionBehaviorConstRef FB = HLSMgr->CGetFunctionBehavior(funId);
+   const OpGraphConstRef feedback_op_graph = FB->CGetOpGraph(FunctionBehavior::FFLSAODG);
+   const BehavioralHelperConstRef behavioral_helper = FB->CGetBehavioralHelper();
+   const AllocationInformationConstRef allocation_information = HLS->allocation_information;
+
+   operations.assign(loop_operations.begin(), loop_operations.end());
+   const auto num_operations = operations.size();
+   latencies.assign(num_operations, 0);
+   fu_types.assign(num_operations, INFINITE_UINT);
+   occupancies.assign(num_operations, 0);
+   successors.assign(num_operations, std::vector<Dependence>());
+   predecessors.assign(num_operations, std::vector<Dependence>());
+   uses.assign(num_operations, std::vector<Dependence>());
+
+   CustomUnorderedMap<vertex, size_t> operation_indexes;
+   for(size_t index = 0; index < num_operations; index++)
+   {
+      operation_indexes[operations[index]] = index;
+      const auto node_id = feedback_op_graph->CGetOpNodeInfo(operations[index])->GetNodeId();
+      if(not allocation_information->CanImplementSetNotEmpty(node_id))
+      {
+         continue;
+      }
+      unsigned int fu_type = 0;
+      if(not allocation_information->is_vertex_bounded_with(node_id, fu_type))
+      {
+         /// Operation not yet bound: use the fastest candidate
+         unsigned int fastest = INFINITE_UINT;
+         for(const auto candidate : allocation_information->can_implement_set(node_id))
+         {
+            if(allocation_information->get_cycles(candidate, node_id) < fastest)
+            {
+               fastest = allocation_information->get_cycles(candidate, node_id);
+               fu_type = candidate;
+            }
+         }
+      }
+      /// Virtual units (phi, nop, ...) do not delay their users
+      latencies[index] = allocation_information->has_to_be_synthetized(fu_type) ? std::max(allocation_information->get_cycles(fu_type, node_id), 1u) : 0;
+      if(allocation_information->get_number_fu(fu_type) != INFINITE_UINT)
+      {
+         const auto initiation_time = from_strongtype_cast<unsigned int>(allocation_information->get_initiation_time(fu_type, node_id));
+         fu_types[index] = fu_type;
+         occupancies[index] = initiation_time != 0 ? initiation_time : latencies[index];
+      }
+   }
+
+   for(size_t index = 0; index < num_operations; index++)
+   {
+      OutEdgeIterator oe, oe_end;
+      for(boost::tie(oe, oe_end) = boost::out_edges(operations[index], *feedback_op_graph); oe != oe_end; oe++)
+      {
+         const auto target = operation_indexes.find(boost::target(*oe, *feedback_op_graph));
+         if(target == operation_indexes.end())
+         {
+            continue;
+         }
+         /// Feedback flow edges serialize the iterations: they are exactly what pipelining removes
+         const auto selector = feedback_op_graph->GetSelector(*oe) & ~(FB_FLG_SELECTOR);
+         if(selector == 0)
+         {
+            continue;
+         }
+         /// Speculable operations do not have to wait for the exit condition
+         if((selector & ~(CDG_SELECTOR | FB_CDG_SELECTOR)) == 0 and behavioral_helper->CanBeSpeculated(feedback_op_graph->CGetOpNodeInfo(operations[target->second])->GetNodeId()))
+         {
+            continue;
+         }
+         Dependence dependence;
+         dependence.target = target->second;
+         dependence.delay = (selector & ~ADG_SELECTOR & ~FB_ADG_SELECTOR) != 0 ? static_cast<int>(latencies[index]) : 0;
+         dependence.distance = (selector & (CDG_SELECTOR | DFG_SELECTOR | ADG_SELECTOR | ODG_SELECTOR | FLG_SELECTOR)) != 0 ? 0 : 1;
+         successors[index].push_back(dependence);
+         if((selector & (DFG_SELECTOR | FB_DFG_SELECTOR)) != 0)
+         {
+            uses[index].push_back(dependence);
+         }
+         dependence.target = index;
+         predecessors[target->second].push_back(dependence);
+         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level,
+                        "---Dependence " + GET_NAME(feedback_op_graph, operations[index]) + "-->" + GET_NAME(feedback_op_graph, operations[target->second]) + " delay " + STR(dependence.delay) + " distance " + STR(dependence.distance));
+      }
+   }
+}
+
+unsigned int ModuloScheduling::ComputeResMII() const
+{
+   unsigned int res_mii = 1;
+   CustomMap<unsigned int, unsigned int> fu_usage;
+   for(size_t index = 0; index < operations.size(); index++)
+   {
+      if(fu_types[index] != INFINITE_UINT)
+      {
+         fu_usage[fu_types[index]] += occupancies[index];
+         /// A unit cannot be reserved twice by the same operation in the same kernel
+         res_mii = std::max(res_mii, occupancies[index]);
+      }
+   }
+   for(const auto& usage : fu_usage)
+   {
+      const auto fu_number = HLS->allocation_information->get_number_fu(usage.first);
+      res_mii = std::max(res_mii, (usage.second + fu_number - 1) / fu_number);
+   }
+   return res_mii;
+}
+
+bool ModuloScheduling::ComputeHeights(unsigned int initiation_interval, std::vector<long long>& heights) const
+{
+   const auto num_operations = operations.size();
+   heights.assign(num_operations, 0);
+   for(size_t index = 0; index < num_operations; index++)
+   {
+      heights[index] = latencies[index];
+   }
+   /// Bellman-Ford: without positive cycles the heights converge in at most num_operations rounds
+   for(size_t round = 0; round <= num_operations; round++)
+   {
+      bool changed = false;
+      for(size_t index = 0; index < num_operations; index++)
+      {
+         for(const auto& dependence : successors[index])
+         {
+            const auto candidate = dependence.delay - static_cast<long long>(initiation_interval) * dependence.distance + heights[dependence.target];
+            if(candidate > heights[index])
+            {
+               heights[index] = candidate;
+               changed = true;
+            }
+         }
+      }
+      if(not changed)
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+unsigned int ModuloScheduling::ComputeRecMII() const
+{
+   std::vector<long long> heights;
+   unsigned int upper = 1;
+   for(const auto& operation_successors : successors)
+   {
+      for(const auto& dependence : operation_successors)
+      {
+         upper += static_cast<unsigned int>(std::max(dependence.delay, 0));
+      }
+   }
+   if(not ComputeHeights(upper, heights))
+   {
+      /// A recurrence within the same iteration
+      return 0;
+   }
+   unsigned int lower = 1;
+   while(lower < upper)
+   {
+      const auto middle = lower + (upper - lower) / 2;
+      if(ComputeHeights(middle, heights))
+      {
+         upper = middle;
+      }
+      else
+      {
+         lower = middle + 1;
+      }
+   }
+   return lower;
+}
+
+bool ModuloScheduling::IterativeModuloSchedule(unsigned int initiation_interval, std::vector<long long>& starting_cycles) const
+{
+   const auto num_operations = operations.size();
+   const auto ii = static_cast<long long>(initiation_interval);
+   std::vector<long long> heights;
+   if(not ComputeHeights(initiation_interval, heights))
+   {
+      return false;
+   }
+
+   /// The modulo reservation table: for each limited functional unit type, for each unit, the operation using it in each kernel cycle (num_operations if free)
+   CustomMap<unsigned int, std::vector<std::vector<size_t>>> reservation_table;
+   CustomMap<unsigned int, unsigned int> fu_operations;
+   for(const auto fu_type : fu_types)
+   {
+      if(fu_type != INFINITE_UINT)
+      {
+         fu_operations[fu_type]++;
+      }
+   }
+   for(const auto& fu_operation : fu_operations)
+   {
+      const auto fu_number = std::min(HLS->allocation_information->get_number_fu(fu_operation.first), fu_operation.second);
+      reservation_table[fu_operation.first] = std::vector<std::vector<size_t>>(fu_number, std::vector<size_t>(initiation_interval, num_operations));
+   }
+   std::vector<size_t> units(num_operations, 0);
+   const auto is_free = [&](size_t operation, long long cycle, size_t unit) -> bool {
+      const auto& rows = reservation_table.find(fu_types[operation])->second[unit];
+      for(long long offset = 0; offset < occupancies[operation]; offset++)
+      {
+         if(rows[static_cast<size_t>((cycle + offset) % ii)] != num_operations)
+         {
+            return false;
+         }
+      }
+      return true;
+   };
+   const auto set_reservation = [&](size_t operation, long long cycle, size_t value) {
+      if(fu_types[operation] != INFINITE_UINT)
+      {
+         auto& rows = reservation_table.find(fu_types[operation])->second[units[operation]];
+         for(long long offset = 0; offset < occupancies[operation]; offset++)
+         {
+            rows[static_cast<size_t>((cycle + offset) % ii)] = value;
+         }
+      }
+   };
+
+   /// Operations are scheduled by decreasing height
+   std::set<std::pair<long long, size_t>> unscheduled;
+   const auto unschedule = [&](size_t operation) {
+      set_reservation(operation, starting_cycles[operation], num_operations);
+      starting_cycles[operation] = -1;
+      unscheduled.insert(std::make_pair(-heights[operation], operation));
+   };
+   starting_cycles.assign(num_operations, -1);
+   std::vector<long long> previous_cycles(num_operations, -1);
+   for(size_t index = 0; index < num_operations; index++)
+   {
+      unscheduled.insert(std::make_pair(-heights[index], index));
+   }
+   size_t budget = MODULO_SCHEDULING_BUDGET_RATIO * num_operations;
+   while(not unscheduled.empty())
+   {
+      if(budget == 0)
+      {
+         return false;
+      }
+      budget--;
+      const auto operation = unscheduled.begin()->second;
+      unscheduled.erase(unscheduled.begin());
+      long long earliest = 0;
+      for(const auto& dependence : predecessors[operation])
+      {
+         if(starting_cycles[dependence.target] >= 0)
+         {
+            earliest = std::max(earliest, starting_cycles[dependence.target] + dependence.delay - ii * dependence.distance);
+         }
+      }
+      long long cycle = -1;
+      if(fu_types[operation] == INFINITE_UINT)
+      {
+         cycle = earliest;
+      }
+      else
+      {
+         const auto fu_number = reservation_table.find(fu_types[operation])->second.size();
+         for(long long candidate = earliest; candidate < earliest + ii and cycle < 0; candidate++)
+         {
+            for(size_t unit = 0; unit < fu_number; unit++)
+            {
+               if(is_free(operation, candidate, unit))
+               {
+                  cycle = candidate;
+                  units[operation] = unit;
+                  break;
+               }
+            }
+         }
+         if(cycle < 0)
+         {
+            /// No free slot: force the operation and evict the ones in conflict on the first unit
+            cycle = (previous_cycles[operation] < 0 or earliest > previous_cycles[operation]) ? earliest : previous_cycles[operation] + 1;
+            units[operation] = 0;
+            auto& rows = reservation_table.find(fu_types[operation])->second[0];
+            for(long long offset = 0; offset < occupancies[operation]; offset++)
+            {
+               const auto conflicting = rows[static_cast<size_t>((cycle + offset) % ii)];
+               if(conflicting != num_operations)
+               {
+                  unschedule(conflicting);
+               }
+            }
+         }
+      }
+      starting_cycles[operation] = cycle;
+      previous_cycles[operation] = cycle;
+      set_reservation(operation, cycle, operation);
+      /// Evict the successors whose dependence is now violated
+      for(const auto& dependence : successors[operation])
+      {
+         if(dependence.target != operation and starting_cycles[dependence.target] >= 0 and starting_cycles[dependence.target] < cycle + dependence.delay - ii * dependence.distance)
+         {
+            unschedule(dependence.target);
+         }
+      }
+   }
+   return true;
+}
+
+unsigned int ModuloScheduling::ComputeMaxLive(unsigned int initiation_interval, const std::vector<long long>& starting_cycles) const
+{
+   const auto ii = static_cast<long long>(initiation_interval);
+   std::vector<unsigned int> live_values(initiation_interval, 0);
+   for(size_t index = 0; index < operations.size(); index++)
+   {
+      const auto definition = starting_cycles[index] + latencies[index];
+      auto last_use = definition;
+      for(const auto& use : uses[index])
+      {
+         last_use = std::max(last_use, starting_cycles[use.target] + ii * use.distance);
+      }
+      /// The value is live in [definition, last_use): each full wrap around the kernel costs a register in every cycle
+      const auto lifetime = last_use - definition;
+      for(size_t row = 0; row < initiation_interval; row++)
+      {
+         live_values[row] += static_cast<unsigned int>(lifetime / ii);
+      }
+      for(long long offset = 0; offset < lifetime % ii; offset++)
+      {
+         live_values[static_cast<size_t>((definition + offset) % ii)]++;
+      }
+   }
+   return *std::max_element(live_values.begin(), live_values.end());
+}
+
+DesignFlowStep_Status ModuloScheduling::InternalExec()
+{
+   const FunctionBehaviorConstRef FB = HLSMgr->CGetFunctionBehavior(funId);
+   const BBGraphConstRef basic_block_graph = FB->CGetBBGraph(FunctionBehavior::BB);
+   loop_schedules.clear();
+   for(const auto& loop : FB->CGetLoops()->GetList())
+   {
+      const auto loop_id = loop->GetId();
+      if(loop_id == 0 or not loop->is_innermost() or loop->num_blocks() != 1)
+      {
+         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Skipping loop " + STR(loop_id) + ": only innermost loops composed of a single basic block are pipelined");
+         continue;
+      }
+      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Modulo scheduling loop " + STR(loop_id));
+      BuildDependenceGraph(basic_block_graph->CGetBBNodeInfo(*loop->get_blocks().begin())->statements_list);
+      const auto res_mii = ComputeResMII();
+      const auto rec_mii = ComputeRecMII();
+      if(rec_mii == 0)
+      {
+         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Dependences of the iteration are cyclic");
+         continue;
+      }
+      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---ResMII is " + STR(res_mii) + " - RecMII is " + STR(rec_mii));
+      /// At this initiation interval the iterations do not overlap anymore, so a schedule always exists
+      unsigned int max_ii = std::max(res_mii, rec_mii);
+      for(size_t index = 0; index < operations.size(); index++)
+      {
+         max_ii += latencies[index] + occupancies[index];
+      }
+      std::vector<long long> starting_cycles;
+      unsigned int initiation_interval = std::max(res_mii, rec_mii);
+      while(initiation_interval <= max_ii and not IterativeModuloSchedule(initiation_interval, starting_cycles))
+      {
+         initiation_interval++;
+      }
+      if(initiation_interval > max_ii)
+      {
+         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--No modulo schedule found");
+         continue;
+      }
+      LoopModuloSchedule& loop_schedule = loop_schedules[loop_id];
+      loop_schedule.res_mii = res_mii;
+      loop_schedule.rec_mii = rec_mii;
+      loop_schedule.initiation_interval = initiation_interval;
+      loop_schedule.iteration_latency = 1;
+      loop_schedule.starting_cycles.clear();
+      for(size_t index = 0; index < operations.size(); index++)
+      {
+         loop_schedule.starting_cycles[operations[index]] = static_cast<unsigned int>(starting_cycles[index]);
+         loop_schedule.iteration_latency = std::max(loop_schedule.iteration_latency, static_cast<unsigned int>(starting_cycles[index] + latencies[index]));
+      }
+      loop_schedule.stage_count = (loop_schedule.iteration_latency + initiation_interval - 1) / initiation_interval;
+      loop_schedule.max_live = ComputeMaxLive(initiation_interval, starting_cycles);
+      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Modulo scheduled loop " + STR(loop_id));
+      INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level,
+                     "---Loop " + STR(loop_id) + " of " + FB->CGetBehavioralHelper()->get_function_name() + ": initiation interval " + STR(initiation_interval) + " (ResMII " + STR(res_mii) + ", RecMII " + STR(rec_mii) + "), iteration latency " +
+                         STR(loop_schedule.iteration_latency) + ", " + STR(loop_schedule.stage_count) + " stages, " + STR(loop_schedule.max_live) + " live values");
+   }
+   return DesignFlowStep_Status::SUCCESS;
+}
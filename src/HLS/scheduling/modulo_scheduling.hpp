@@ -0,0 +1,200 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file modulo_scheduling.hpp
+ * @brief Initiation interval analysis of innermost loops based on iterative modulo scheduling
+ *
+ * For each innermost loop composed of a single basic block, the step computes the minimum initiation interval
+ * (resource and recurrence constrained) and then searches the smallest feasible initiation interval with the
+ * iterative modulo scheduling algorithm by B. R. Rau. The register pressure of the resulting kernel is computed as
+ * the maximum number of values simultaneously live in a modulo slot.
+ * This is a report only: it is executed when --modulo-scheduling-report is given and nothing reads its schedules.
+ * No prologue, kernel or epilogue is generated, so the state transition graph and the controller still execute the
+ * iterations one after the other and the throughput of the loops is not changed.
+ *
+ */
+#ifndef MODULO_SCHEDULING_HPP
+#define MODULO_SCHEDULING_HPP
+
+/// Superclass include
+#include "hls_function_step.hpp"
+
+/// Graph include
+#include "graph.hpp"
+
+/// Utility include
+#include "custom_map.hpp"
+#include <list>
+#include <vector>
+
+class ModuloScheduling : public HLSFunctionStep
+{
+ public:
+   /// The modulo schedule of a loop
+   struct LoopModuloSchedule
+   {
+      /// The resource constrained lower bound of the initiation interval
+      unsigned int res_mii;
+
+      /// The recurrence constrained lower bound of the initiation interval
+      unsigned int rec_mii;
+
+      /// The initiation interval which has been found
+      unsigned int initiation_interval;
+
+      /// The latency of a single iteration
+      unsigned int iteration_latency;
+
+      /// The number of stages of the kernel; prologue and epilogue last (stage_count - 1) * initiation_interval cycles each
+      unsigned int stage_count;
+
+      /// The maximum number of values live in the same kernel cycle
+      unsigned int max_live;
+
+      /// The starting cycle of each operation relative to the beginning of its iteration
+      CustomMap<vertex, unsigned int> starting_cycles;
+   };
+
+   /// The modulo schedule of each pipelined loop
+   CustomMap<unsigned int, LoopModuloSchedule> loop_schedules;
+
+ private:
+   /// A dependence between two operations of a loop
+   struct Dependence
+   {
+      /// The index of the target operation
+      size_t target;
+
+      /// The minimum number of cycles between the start of the source and the start of the target
+      int delay;
+
+      /// The number of iterations crossed by the dependence
+      unsigned int distance;
+   };
+
+   /// The operations of the loop currently processed
+   std::vector<vertex> operations;
+
+   /// The latency in cycles of each operation
+   std::vector<unsigned int> latencies;
+
+   /// The functional unit type of each operation with a limited number of units (INFINITE_UINT otherwise)
+   std::vector<unsigned int> fu_types;
+
+   /// The number of cycles each operation keeps busy its functional unit
+   std::vector<unsigned int> occupancies;
+
+   /// The outgoing dependences of each operation
+   std::vector<std::vector<Dependence>> successors;
+
+   /// The incoming dependences of each operation (target field is the source operation)
+   std::vector<std::vector<Dependence>> predecessors;
+
+   /// The value dependences of each operation (target field is the user operation)
+   std::vector<std::vector<Dependence>> uses;
+
+   /**
+    * Build the dependence graph of a single basic block loop
+    * @param loop_operations are the operations of the loop
+    */
+   void BuildDependenceGraph(const std::list<vertex>& loop_operations);
+
+   /**
+    * Compute the lower bound of the initiation interval imposed by limited resources
+    */
+   unsigned int ComputeResMII() const;
+
+   /**
+    * Check if the recurrences of the loop can be satisfied with a given initiation interval
+    * @param initiation_interval is the initiation interval
+    * @param heights is where the height of each operation (longest path to the end of the iteration) is stored
+    * @return true if the dependence graph has no positive cycle
+    */
+   bool ComputeHeights(unsigned int initiation_interval, std::vector<long long>& heights) const;
+
+   /**
+    * Compute the lower bound of the initiation interval imposed by recurrences
+    * @return the bound or 0 if the recurrences cannot be satisfied
+    */
+   unsigned int ComputeRecMII() const;
+
+   /**
+    * Try to modulo schedule the loop with a given initiation interval
+    * @param initiation_interval is the initiation interval
+    * @param starting_cycles is where the starting cycles of the operations are stored
+    * @return true if a schedule has been found within the budget
+    */
+   bool IterativeModuloSchedule(unsigned int initiation_interval, std::vector<long long>& starting_cycles) const;
+
+   /**
+    * Compute the maximum number of values live in the same kernel cycle
+    * @param initiation_interval is the initiation interval
+    * @param starting_cycles are the starting cycles of the operations
+    */
+   unsigned int ComputeMaxLive(unsigned int initiation_interval, const std::vector<long long>& starting_cycles) const;
+
+   /**
+    * Compute the relationship of this step
+    * @param relationship_type is the type of relationship to be considered
+    * @return the steps in relationship with this
+    */
+   const CustomUnorderedSet<std::tuple<HLSFlowStep_Type, HLSFlowStepSpecializationConstRef, HLSFlowStep_Relationship>> ComputeHLSRelationships(const DesignFlowStep::RelationshipType relationship_type) const override;
+
+ public:
+   /**
+    * Constructor
+    * @param parameters is the set of input parameters
+    * @param HLSMgr is the HLS manager
+    * @param function_id is the index of the function
+    * @param design_flow_manager is the hls design flow
+    */
+   ModuloScheduling(const ParameterConstRef parameters, const HLS_managerRef HLSMgr, unsigned int function_id, const DesignFlowManagerConstRef design_flow_manager);
+
+   /**
+    * Destructor
+    */
+   ~ModuloScheduling() override;
+
+   /**
+    * Check if this step has actually to be executed
+    * @return true if the step has to be executed
+    */
+   bool HasToBeExecuted() const override;
+
+   /**
+    * Execute the step
+    * @return the exit status of this step
+    */
+   DesignFlowStep_Status InternalExec() override;
+};
+#endif
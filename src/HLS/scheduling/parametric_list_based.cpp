@@ -62,6 +62,7 @@
 #include "tree_helper.hpp"
 #include "tree_manager.hpp"
 #include "tree_node.hpp"
+#include "tree_reindex.hpp"
 
 #include "BambuParameter.hpp"
 #include "cpu_time.hpp"
@@ -87,19 +88,25 @@
 #include "behavioral_helper.hpp"
 #include "call_graph_manager.hpp"  // for CallGraphManager, CallGrap...
 #include "string_manipulation.hpp" // for GET_CLASS
+#include "var_pp_functor.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 
 #if !HAVE_UNORDERED
-PrioritySorter::PrioritySorter(refcount<priority_data<int>> _priority, const OpGraphConstRef _op_graph) : priority(std::move(_priority)), op_graph(_op_graph)
+PrioritySorter::PrioritySorter(const OpGraphConstRef _op_graph) : op_graph(_op_graph)
 {
 }
 
-bool PrioritySorter::operator()(const vertex x, const vertex y) const
+bool PrioritySorter::operator()(const ReadyListEntry& x, const ReadyListEntry& y) const
 {
-   const auto x_priority = (*priority)(x);
-   const auto y_priority = (*priority)(y);
-   if(x_priority != y_priority)
-      return x_priority > y_priority;
-   return GET_NAME(op_graph, x) < GET_NAME(op_graph, y);
+   if(x.first != y.first)
+      return x.first > y.first;
+   if(x.second == y.second)
+      return false;
+   return GET_NAME(op_graph, x.second) < GET_NAME(op_graph, y.second);
 }
 #endif
 
@@ -331,6 +338,204 @@ void parametric_list_based::Initialize()
    ending_time = OpVertexMap<double>(FB->CGetOpGraph(FunctionBehavior::CFG));
 }
 
+std::vector<vertex> parametric_list_based::GetCacheOperationOrder() const
+{
+   const BBGraphConstRef bbg = HLSMgr->CGetFunctionBehavior(funId)->CGetBBGraph();
+   std::map<unsigned int, vertex> sorted_bbs;
+   VertexIterator bb, bb_end;
+   for(boost::tie(bb, bb_end) = boost::vertices(*bbg); bb != bb_end; ++bb)
+   {
+      sorted_bbs[bbg->CGetBBNodeInfo(*bb)->block->number] = *bb;
+   }
+   std::vector<vertex> ret;
+   for(const auto& sorted_bb : sorted_bbs)
+   {
+      for(const auto statement : bbg->CGetBBNodeInfo(sorted_bb.second)->statements_list)
+      {
+         if(HLS->operations.find(statement) != HLS->operations.end())
+            ret.push_back(statement);
+      }
+   }
+   if(ret.size() != HLS->operations.size())
+      ret.clear();
+   return ret;
+}
+
+std::string parametric_list_based::ComputeCacheKey() const
+{
+   /// with speculation or SDC scheduling the schedule is computed together with transformations of the IR which cannot be restored from the cache
+   if(speculation or parameters->getOption<HLSFlowStep_Type>(OPT_scheduling_algorithm) == HLSFlowStep_Type::SDC_SCHEDULING)
+      return "";
+   const auto operations = GetCacheOperationOrder();
+   if(operations.empty())
+      return "";
+   const FunctionBehaviorConstRef FB = HLSMgr->CGetFunctionBehavior(funId);
+   const BehavioralHelperConstRef BH = FB->CGetBehavioralHelper();
+   const OpGraphConstRef op_graph = FB->CGetOpGraph(FunctionBehavior::CFG);
+   const tree_managerConstRef TM = HLSMgr->get_tree_manager();
+   const var_pp_functorConstRef vppf(new std_var_pp_functor(BH));
+   const auto top_function_ids = HLSMgr->CGetCallGraphManager()->GetRootFunctions();
+   std::stringstream key;
+   key << std::setprecision(std::numeric_limits<double>::max_digits10);
+   key << "parametric_list_based " << static_cast<unsigned int>(parametric_list_based_metric) << "\n";
+   key << HLS->HLS_C->get_clock_period() << " " << HLS->HLS_C->get_clock_period_resource_fraction() << " " << HLS->allocation_information->GetClockPeriodMargin() << " " << HLS->allocation_information->get_setup_hold_time() << "\n";
+   key << parameters->getOption<bool>(OPT_chaining) << " " << parameters->getOption<bool>(OPT_do_not_chain_memories) << " " << parameters->getOption<double>(OPT_scheduling_mux_margins) << " " << parameters->getOption<std::string>(OPT_registered_inputs) << " "
+       << parameters->getOption<std::string>(OPT_memory_controller_type) << " " << parameters->getOption<int>(OPT_memory_banks_number) << " " << (parameters->isOption(OPT_rom_duplication) and parameters->getOption<bool>(OPT_rom_duplication)) << " "
+       << (parameters->isOption(OPT_post_rescheduling) and parameters->getOption<bool>(OPT_post_rescheduling)) << " " << (top_function_ids.find(funId) != top_function_ids.end()) << "\n";
+   /// the identifiers of the functional units are stored in the cache, so the allocation must be the same
+   for(unsigned int fu_type = 0; fu_type < HLS->allocation_information->get_number_fu_types(); fu_type++)
+   {
+      const auto fu_name = HLS->allocation_information->get_fu_name(fu_type);
+      key << fu_name.first << " " << fu_name.second << " " << HLS->allocation_information->get_number_fu(fu_type) << "\n";
+   }
+   for(const auto operation : operations)
+   {
+      const auto statement_index = op_graph->CGetOpNodeInfo(operation)->GetNodeId();
+      key << op_graph->CGetOpNodeInfo(operation)->GetOperation() << " " << BH->print_vertex(op_graph, operation, vppf) << "\n";
+      if(statement_index != ENTRY_ID and statement_index != EXIT_ID)
+      {
+         /// the printed statement does not show the bitwidth of the operands
+         CustomOrderedSet<ssa_name*> ssa_uses;
+         tree_helper::compute_ssa_uses_rec_ptr(TM->get_tree_node_const(statement_index), ssa_uses);
+         std::set<std::string> ssa_sizes;
+         for(const auto ssa_use : ssa_uses)
+         {
+            ssa_sizes.insert(BH->PrintVariable(ssa_use->index) + ":" + STR(tree_helper::Size(TM->get_tree_node_const(ssa_use->index))) + ":" + ssa_use->bit_values);
+         }
+         const auto ga = GetPointer<const gimple_assign>(TM->get_tree_node_const(statement_index));
+         if(ga)
+         {
+            ssa_sizes.insert("=" + STR(tree_helper::Size(GET_NODE(ga->op0))));
+         }
+         for(const auto& ssa_size : ssa_sizes)
+         {
+            key << ssa_size << " ";
+         }
+      }
+      /// the characterization of the candidate units includes the latency of the called functions, so callers are scheduled again when a callee changes
+      for(const auto fu_type : HLS->allocation_information->can_implement_set(operation))
+      {
+         key << fu_type << ":" << HLS->allocation_information->get_execution_time(fu_type, operation, op_graph) << ":" << HLS->allocation_information->get_cycles(fu_type, operation, op_graph) << " ";
+      }
+      key << "\n";
+   }
+   return key.str();
+}
+
+bool parametric_list_based::LoadCachedResult(const std::string& cache_file)
+{
+   /// The whole entry is parsed and validated before anything is written: if it is rejected, the step is executed from a clean state
+   const auto operations = GetCacheOperationOrder();
+   const OpGraphConstRef op_graph = HLSMgr->CGetFunctionBehavior(funId)->CGetOpGraph(FunctionBehavior::CFG);
+   const AllocationInformationConstRef allocation_information = HLS->allocation_information;
+   std::ifstream cache(cache_file);
+   std::string line;
+   size_t operations_number = 0;
+   unsigned int csteps = 0;
+   double min_slack = 0.0;
+   if(not std::getline(cache, line))
+      return false;
+   {
+      std::istringstream header(line);
+      if(not(header >> operations_number >> csteps >> min_slack) or not(header >> std::ws).eof() or operations_number != operations.size())
+         return false;
+   }
+   struct CachedOperation
+   {
+      unsigned int cstep;
+      unsigned int cstep_end;
+      double starting;
+      double ending;
+      unsigned int fu_type;
+      unsigned int fu_index;
+      bool speculative;
+   };
+   std::vector<CachedOperation> cached_operations(operations.size());
+   for(size_t position = 0; position < operations.size(); position++)
+   {
+      auto& cached_operation = cached_operations[position];
+      if(not std::getline(cache, line))
+         return false;
+      std::istringstream fields(line);
+      if(not(fields >> cached_operation.cstep >> cached_operation.cstep_end >> cached_operation.starting >> cached_operation.ending >> cached_operation.fu_type >> cached_operation.fu_index >> cached_operation.speculative) or
+         not(fields >> std::ws).eof())
+         return false;
+      const auto statement_index = op_graph->CGetOpNodeInfo(operations[position])->GetNodeId();
+      if(cached_operation.cstep_end < cached_operation.cstep or cached_operation.fu_type >= allocation_information->get_number_fu_types())
+         return false;
+      const auto& can_implement = allocation_information->can_implement_set(statement_index);
+      if(can_implement.find(cached_operation.fu_type) == can_implement.end())
+         return false;
+      const auto fu_number = allocation_information->get_number_fu(cached_operation.fu_type);
+      if(fu_number != INFINITE_UINT and cached_operation.fu_index >= fu_number)
+         return false;
+   }
+   CustomMap<std::pair<unsigned int, unsigned int>, double> connection_times;
+   while(std::getline(cache, line))
+   {
+      size_t first, second;
+      double connection_time;
+      std::istringstream fields(line);
+      if(not(fields >> first >> second >> connection_time) or not(fields >> std::ws).eof() or first >= operations.size() or second >= operations.size())
+         return false;
+      connection_times[std::make_pair(op_graph->CGetOpNodeInfo(operations[first])->GetNodeId(), op_graph->CGetOpNodeInfo(operations[second])->GetNodeId())] = connection_time;
+   }
+
+   const ScheduleRef schedule = HLS->Rsch;
+   for(size_t position = 0; position < operations.size(); position++)
+   {
+      const auto operation = operations[position];
+      const auto& cached_operation = cached_operations[position];
+      const auto statement_index = op_graph->CGetOpNodeInfo(operation)->GetNodeId();
+      schedule->set_execution(operation, ControlStep(cached_operation.cstep));
+      schedule->set_execution_end(operation, ControlStep(cached_operation.cstep_end));
+      schedule->starting_times[statement_index] = cached_operation.starting;
+      schedule->ending_times[statement_index] = cached_operation.ending;
+      HLS->Rfu->bind(operation, cached_operation.fu_type, cached_operation.fu_index);
+      if(cached_operation.speculative)
+         spec[operation] = true;
+   }
+   for(const auto& connection_time : connection_times)
+   {
+      schedule->connection_times[connection_time.first] = connection_time.second;
+   }
+   schedule->set_csteps(ControlStep(csteps));
+   schedule->set_spec(spec);
+   HLS->allocation_information->setMinimumSlack(min_slack);
+   /// the step is not executed, so the versions must be updated here as in HLSFunctionStep::Exec
+   bb_version = HLSMgr->GetFunctionBehavior(funId)->GetBBVersion();
+   memory_version = HLSMgr->GetMemVersion();
+   INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "---Scheduling of function " + HLSMgr->CGetFunctionBehavior(funId)->CGetBehavioralHelper()->get_function_name() + " reused: " + STR(csteps) + " control steps");
+   return true;
+}
+
+void parametric_list_based::StoreCachedResult(const std::string& cache_file) const
+{
+   const auto operations = GetCacheOperationOrder();
+   const OpGraphConstRef op_graph = HLSMgr->CGetFunctionBehavior(funId)->CGetOpGraph(FunctionBehavior::CFG);
+   const ScheduleConstRef schedule = HLS->Rsch;
+   std::ofstream cache(cache_file);
+   cache << std::setprecision(std::numeric_limits<double>::max_digits10);
+   cache << operations.size() << " " << from_strongtype_cast<unsigned int>(schedule->get_csteps()) << " " << HLS->allocation_information->getMinimumSlack() << "\n";
+   CustomUnorderedMap<unsigned int, size_t> positions;
+   for(const auto operation : operations)
+   {
+      const auto statement_index = op_graph->CGetOpNodeInfo(operation)->GetNodeId();
+      const auto position = positions.size();
+      positions[statement_index] = position;
+      const auto starting_time = schedule->starting_times.find(statement_index);
+      const auto ending_time = schedule->ending_times.find(statement_index);
+      cache << from_strongtype_cast<unsigned int>(schedule->get_cstep(operation).second) << " " << from_strongtype_cast<unsigned int>(schedule->get_cstep_end(operation).second) << " "
+            << (starting_time != schedule->starting_times.end() ? starting_time->second : 0.0) << " " << (ending_time != schedule->ending_times.end() ? ending_time->second : 0.0) << " " << HLS->Rfu->get_assign(operation) << " "
+            << HLS->Rfu->get_index(operation) << " " << (spec.find(operation) != spec.end() and spec.find(operation)->second) << "\n";
+   }
+   for(const auto& connection_time : schedule->connection_times)
+   {
+      if(positions.find(connection_time.first.first) != positions.end() and positions.find(connection_time.first.second) != positions.end())
+         cache << positions.at(connection_time.first.first) << " " << positions.at(connection_time.first.second) << " " << connection_time.second << "\n";
+   }
+}
+
 void parametric_list_based::CheckSchedulabilityConditions(const vertex& current_vertex, ControlStep current_cycle, double& current_starting_time, double& current_ending_time, double& current_stage_period,
                                                           CustomMap<std::pair<unsigned int, unsigned int>, double>& local_connection_map, double current_cycle_starting_time, double current_cycle_ending_time, double setup_hold_time, double& phi_extra_time,
                                                           double scheduling_mux_margins, bool unbounded, bool cstep_has_RET_conflict, unsigned int fu_type, const vertex2obj<ControlStep>& current_ASAP, const fu_bindingRef res_binding,
@@ -526,11 +731,18 @@ void parametric_list_based::exec(const OpVertexSet& operations, ControlStep curr
    /// priory queues set up
    unsigned int n_resources = HLS->allocation_information->get_number_fu_types();
 #if HAVE_UNORDERED
-   priority_compare_functor<int> priority_functors(Priority);
-   PriorityQueues priority_queues(n_resources, priority_functors);
+   PriorityQueues priority_queues(n_resources);
+#else
+   PriorityQueues priority_queues(n_resources, std::set<ReadyListEntry, PrioritySorter>(PrioritySorter(flow_graph)));
+#endif
+   /// push back an operation already extracted from the ready list of fu_type
+   const auto push_back_to_queue = [&](const unsigned int fu_type, const vertex v) {
+#if HAVE_UNORDERED
+      priority_queues[fu_type].push(ReadyListEntry((*Priority)(v) - Priority->get_uniform_increment(), v));
 #else
-   PriorityQueues priority_queues(n_resources, std::set<vertex, PrioritySorter>(PrioritySorter(Priority, flow_graph)));
+      priority_queues[fu_type].insert(ReadyListEntry((*Priority)(v) - Priority->get_uniform_increment(), v));
 #endif
+   };
    unsigned int cstep_vuses_ARRAYs = 0;
    unsigned int cstep_vuses_others = 0;
    bool cstep_has_RET_conflict = registering_output_p;
@@ -539,7 +751,7 @@ void parametric_list_based::exec(const OpVertexSet& operations, ControlStep curr
    OpVertexSet::const_iterator rv, rv_end = ready_vertices.end();
 
    for(rv = ready_vertices.begin(); rv != rv_end; ++rv)
-      add_to_priority_queues(priority_queues, ready_resources, *rv);
+      add_to_priority_queues(priority_queues, ready_resources, *Priority, *rv);
 
    const auto TM = HLSMgr->get_tree_manager();
    auto fnode = TM->get_tree_node_const(funId);
@@ -662,9 +874,9 @@ void parametric_list_based::exec(const OpVertexSet& operations, ControlStep curr
             while(queue.size())
             {
 #if HAVE_UNORDERED
-               auto current_vertex = queue.top();
+               const auto current_vertex = queue.top().second;
 #else
-               auto current_vertex = *(queue.begin());
+               const auto current_vertex = queue.begin()->second;
 #endif
                INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---First operation ready for this unit is " + GET_NAME(flow_graph, current_vertex));
 #if HAVE_UNORDERED
@@ -673,9 +885,9 @@ void parametric_list_based::exec(const OpVertexSet& operations, ControlStep curr
                queue.erase(queue.begin());
                INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Other ready operations (" + STR(queue.size()) + ") are:");
 #ifndef NDEBUG
-               for(const auto temp_operation : queue)
+               for(const auto& temp_operation : queue)
                {
-                  INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---" + GET_NAME(flow_graph, temp_operation) + ": " + STR((*Priority)(temp_operation)));
+                  INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---" + GET_NAME(flow_graph, temp_operation.second) + ": " + STR((*Priority)(temp_operation.second)));
                }
 #endif
                INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--");
@@ -950,7 +1162,7 @@ void parametric_list_based::exec(const OpVertexSet& operations, ControlStep curr
                                  ++numReadyOrScheduled;
                               else if(schedule->is_scheduled(op))
                                  ++numReadyOrScheduled;
-                              else if(std::find(queue.begin(), queue.end(), op) != queue.end())
+                              else if(std::find_if(queue.begin(), queue.end(), [&](const ReadyListEntry& entry) { return entry.second == op; }) != queue.end())
                               {
                                  bool predecessorsCondLocal, pipeliningCondLocal, cannotBeChained0Local, chainingRetCondLocal, cannotBeChained1Local, asyncCondLocal, cannotBeChained2Local, MultiCond0Local, MultiCond1Local, nonDirectMemCondLocal;
                                  double current_starting_timeLocal, current_ending_timeLocal, current_stage_periodLocal, phi_extra_timeLocal;
@@ -991,7 +1203,7 @@ void parametric_list_based::exec(const OpVertexSet& operations, ControlStep curr
                                  ++numReadyOrScheduled;
                               else if(schedule->is_scheduled(op))
                                  ++numReadyOrScheduled;
-                              else if(std::find(queue.begin(), queue.end(), op) != queue.end())
+                              else if(std::find_if(queue.begin(), queue.end(), [&](const ReadyListEntry& entry) { return entry.second == op; }) != queue.end())
                               {
                                  bool predecessorsCondLocal, pipeliningCondLocal, cannotBeChained0Local, chainingRetCondLocal, cannotBeChained1Local, asyncCondLocal, cannotBeChained2Local, MultiCond0Local, MultiCond1Local, nonDirectMemCondLocal;
                                  double current_starting_timeLocal, current_ending_timeLocal, current_stage_periodLocal, phi_extra_timeLocal;
@@ -1133,7 +1345,7 @@ void parametric_list_based::exec(const OpVertexSet& operations, ControlStep curr
                   {
                      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Become ready");
                      ready_vertices.insert(s->second);
-                     add_to_priority_queues(priority_queues, ready_resources, s->second);
+                     add_to_priority_queues(priority_queues, ready_resources, *Priority, s->second);
                   }
                }
             }
@@ -1147,11 +1359,7 @@ void parametric_list_based::exec(const OpVertexSet& operations, ControlStep curr
                auto v_end = bl_it->second.end();
                for(auto v = bl_it->second.begin(); v != v_end; ++v)
                {
-#if HAVE_UNORDERED
-                  priority_queues[bl_it->first].push(*v);
-#else
-                  priority_queues[bl_it->first].insert(*v);
-#endif
+                  push_back_to_queue(bl_it->first, *v);
                }
                ready_resources.insert(bl_it->first);
             }
@@ -1171,11 +1379,7 @@ void parametric_list_based::exec(const OpVertexSet& operations, ControlStep curr
                auto v_end = bl_it->second.end();
                for(auto v = bl_it->second.begin(); v != v_end; ++v)
                {
-#if HAVE_UNORDERED
-                  priority_queues[bl_it->first].push(*v);
-#else
-                  priority_queues[bl_it->first].insert(*v);
-#endif
+                  push_back_to_queue(bl_it->first, *v);
                }
                ready_resources.insert(bl_it->first);
             }
@@ -1194,23 +1398,11 @@ void parametric_list_based::exec(const OpVertexSet& operations, ControlStep curr
          auto v_end = bl_it->second.end();
          for(auto v = bl_it->second.begin(); v != v_end; ++v)
          {
-#if HAVE_UNORDERED
-            priority_queues[bl_it->first].push(*v);
-#else
-            priority_queues[bl_it->first].insert(*v);
-#endif
+            push_back_to_queue(bl_it->first, *v);
          }
       }
-      /// update priorities and possibly rehash the queues
-#if HAVE_UNORDERED
-      const auto updated =
-#endif
-          Priority->update();
-#if HAVE_UNORDERED
-      if(updated)
-         for(unsigned int i = 0; i < n_resources; i++)
-            priority_queues[i].rehash();
-#endif
+      /// update priorities; the keys of the ready operations are not affected, so the queues do not have to be reordered
+      Priority->update();
       /// clear the vises
       cstep_vuses_ARRAYs = cstep_vuses_ARRAYs > 0 ? cstep_vuses_ARRAYs - 1 : 0;
       cstep_vuses_others = cstep_vuses_others > 0 ? cstep_vuses_others - 1 : 0;
@@ -1271,6 +1463,12 @@ void parametric_list_based::compute_starting_ending_time_asap(const vertex v, co
    bool no_chaining_of_load_and_store = parameters->getOption<bool>(OPT_do_not_chain_memories) && (check_LOAD_chaining(v, cs, schedule) || is_load_store);
    cannot_be_chained = is_load_store && check_non_direct_operation_chaining(v, fu_type, cs, schedule, res_binding);
    PRINT_DBG_MEX(DEBUG_LEVEL_VERBOSE, debug_level, "                  Initial value of cannot_be_chained=" + (cannot_be_chained ? std::string("T") : std::string("F")));
+   /// quantities which do not depend on the predecessor are computed once
+   const auto has_mux_margins = parameters->getOption<double>(OPT_scheduling_mux_margins) != 0.0;
+   const auto rom_duplication = HLS->Param->isOption(OPT_rom_duplication) && parameters->getOption<bool>(OPT_rom_duplication);
+   const auto cs_starting_time = from_strongtype_cast<double>(cs) * clock_cycle;
+   const auto v_statement = flow_graph->CGetOpNodeInfo(v)->GetNodeId();
+   const auto v_basic_block_index = flow_graph->CGetOpNodeInfo(v)->bb_index;
    InEdgeIterator ei, ei_end;
    for(boost::tie(ei, ei_end) = boost::in_edges(v, *flow_graph); ei != ei_end; ei++)
    {
@@ -1284,29 +1482,28 @@ void parametric_list_based::compute_starting_ending_time_asap(const vertex v, co
       unsigned int from_fu_type = res_binding->get_assign(from_vertex);
       const auto cs_prev = schedule->get_cstep(from_vertex).second;
       const double fsm_correction = [&]() -> double {
-         if(parameters->getOption<double>(OPT_scheduling_mux_margins) != 0.0)
+         if(has_mux_margins)
             return HLS->allocation_information->EstimateControllerDelay();
-         if(cs == cs_prev && HLS->allocation_information->is_one_cycle_direct_access_memory_unit(from_fu_type) &&
-            (!HLS->allocation_information->is_readonly_memory_unit(from_fu_type) || (!HLS->Param->isOption(OPT_rom_duplication) || !parameters->getOption<bool>(OPT_rom_duplication))) &&
+         if(cs == cs_prev && HLS->allocation_information->is_one_cycle_direct_access_memory_unit(from_fu_type) && (!HLS->allocation_information->is_readonly_memory_unit(from_fu_type) || !rom_duplication) &&
             HLSMgr->Rmem->get_maximum_references(HLS->allocation_information->is_memory_unit(from_fu_type) ? HLS->allocation_information->get_memory_var(from_fu_type) : HLS->allocation_information->get_proxy_memory_var(from_fu_type)) >
                 HLS->allocation_information->get_number_channels(from_fu_type))
             return HLS->allocation_information->EstimateControllerDelay();
          return 0.0;
       }();
       auto from_statement = flow_graph->CGetOpNodeInfo(from_vertex)->GetNodeId();
-      auto v_statement = flow_graph->CGetOpNodeInfo(v)->GetNodeId();
-      const auto v_basic_block_index = flow_graph->CGetOpNodeInfo(v)->bb_index;
       auto edge_pair = std::make_pair(from_statement, v_statement);
-      double connection_time = local_connection_map[edge_pair] = (schedule->get_cstep_end(from_vertex).second == cs) ? HLS->allocation_information->GetConnectionTime(from_statement, v_statement, AbsControlStep(v_basic_block_index, cs)) : 0.0;
+      const auto ends_in_cs = schedule->get_cstep_end(from_vertex).second == cs;
+      double connection_time = local_connection_map[edge_pair] = ends_in_cs ? HLS->allocation_information->GetConnectionTime(from_statement, v_statement, AbsControlStep(v_basic_block_index, cs)) : 0.0;
       /// ending time is equal to the connection time plus the maximum between the controller time and the operation ending time
-      double local_ending_time = connection_time + ((cs == cs_prev && starting_time(from_vertex) < (fsm_correction + (from_strongtype_cast<double>(cs) * clock_cycle))) ?
-                                                        ending_time.find(from_vertex)->second + fsm_correction + (from_strongtype_cast<double>(cs) * clock_cycle) - starting_time(from_vertex) :
-                                                        ending_time.find(from_vertex)->second);
+      const auto from_starting_time = starting_time(from_vertex);
+      const auto from_ending_time = ending_time.find(from_vertex)->second;
+      double local_ending_time =
+          connection_time + ((cs == cs_prev && from_starting_time < (fsm_correction + cs_starting_time)) ? from_ending_time + fsm_correction + cs_starting_time - from_starting_time : from_ending_time);
       current_starting_time = std::max(current_starting_time, local_ending_time);
       INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "current_starting_time of " + STR(GET_NAME(flow_graph, v)) + " updated to " + STR(current_starting_time));
 
       /// Check for chaining
-      if(schedule->get_cstep_end(from_vertex).second == cs)
+      if(ends_in_cs)
       {
          if(no_chaining_of_load_and_store)
             cannot_be_chained = true;
@@ -1401,38 +1598,45 @@ void parametric_list_based::compute_starting_ending_time_alap(vertex v, const un
    bool no_chaining_of_load_and_store = parameters->getOption<bool>(OPT_do_not_chain_memories) && (check_LOAD_chaining(v, cs, schedule) || is_load_store);
    cannot_be_chained = is_load_store && check_non_direct_operation_chaining(v, fu_type, cs, schedule, res_binding);
    bool is_operation_unbounded_and_registered = !HLS->allocation_information->is_operation_bounded(flow_graph, v, fu_type) && HLS->allocation_information->is_operation_PI_registered(flow_graph, v, fu_type);
+   /// quantities which do not depend on the predecessor are computed once
+   const auto has_mux_margins = parameters->getOption<double>(OPT_scheduling_mux_margins) != 0.0;
+   const auto rom_duplication = HLS->Param->isOption(OPT_rom_duplication) && parameters->getOption<bool>(OPT_rom_duplication);
+   const auto cs_starting_time = from_strongtype_cast<double>(cs) * clock_cycle;
+   const auto v_statement = flow_graph->CGetOpNodeInfo(v)->GetNodeId();
+   const auto v_basic_block_index = flow_graph->CGetOpNodeInfo(v)->bb_index;
    for(boost::tie(ei, ei_end) = boost::in_edges(v, *flow_graph); ei != ei_end; ei++)
    {
       vertex from_vertex = boost::source(*ei, *flow_graph);
       unsigned int from_fu_type = res_binding->get_assign(from_vertex);
       const auto cs_prev = schedule->get_cstep(from_vertex).second;
       const double fsm_correction = [&]() -> double {
-         if(parameters->getOption<double>(OPT_scheduling_mux_margins) != 0.0)
+         if(has_mux_margins)
             return HLS->allocation_information->EstimateControllerDelay();
-         if(cs == cs_prev && HLS->allocation_information->is_one_cycle_direct_access_memory_unit(from_fu_type) &&
-            (!HLS->allocation_information->is_readonly_memory_unit(from_fu_type) || (!HLS->Param->isOption(OPT_rom_duplication) || !parameters->getOption<bool>(OPT_rom_duplication))) &&
+         if(cs == cs_prev && HLS->allocation_information->is_one_cycle_direct_access_memory_unit(from_fu_type) && (!HLS->allocation_information->is_readonly_memory_unit(from_fu_type) || !rom_duplication) &&
             HLSMgr->Rmem->get_maximum_references(HLS->allocation_information->is_memory_unit(from_fu_type) ? HLS->allocation_information->get_memory_var(from_fu_type) : HLS->allocation_information->get_proxy_memory_var(from_fu_type)) >
                 HLS->allocation_information->get_number_channels(from_fu_type))
             return HLS->allocation_information->EstimateControllerDelay();
          return 0.0;
       }();
       auto from_statement = flow_graph->CGetOpNodeInfo(from_vertex)->GetNodeId();
-      auto v_statement = flow_graph->CGetOpNodeInfo(v)->GetNodeId();
-      const auto v_basic_block_index = flow_graph->CGetOpNodeInfo(v)->bb_index;
       std::pair<unsigned int, unsigned int> edge_pair = std::pair<unsigned int, unsigned int>(from_statement, v_statement);
       double connection_time = local_connection_map[edge_pair] = HLS->allocation_information->GetConnectionTime(from_statement, v_statement, AbsControlStep(v_basic_block_index, cs));
       /// ending time is equal to the connection time plus the maximum between the controller time and the operation ending time
-      double local_ending_time = connection_time + ((cs == cs_prev && starting_time(from_vertex) < (fsm_correction + (from_strongtype_cast<double>(cs) * clock_cycle))) ?
-                                                        ending_time.find(from_vertex)->second + fsm_correction + (from_strongtype_cast<double>(cs) * clock_cycle) - starting_time(from_vertex) :
-                                                        ending_time.find(from_vertex)->second);
+      const auto from_starting_time = starting_time(from_vertex);
+      const auto from_ending_time = ending_time.find(from_vertex)->second;
+      double local_ending_time =
+          connection_time + ((cs == cs_prev && from_starting_time < (fsm_correction + cs_starting_time)) ? from_ending_time + fsm_correction + cs_starting_time - from_starting_time : from_ending_time);
       current_starting_time = std::max(current_starting_time, local_ending_time);
 
-      if((GET_TYPE(flow_graph, from_vertex) & TYPE_STORE) and schedule->get_cstep_end(from_vertex).second == cs and !is_operation_unbounded_and_registered)
-         cannot_be_chained = true;
-      if(no_chaining_of_load_and_store && schedule->get_cstep_end(from_vertex).second == cs)
-         cannot_be_chained = true;
-      if(!HLS->allocation_information->is_operation_bounded(flow_graph, from_vertex, from_fu_type) and schedule->get_cstep_end(from_vertex).second == cs)
-         cannot_be_chained = true;
+      if(schedule->get_cstep_end(from_vertex).second == cs)
+      {
+         if((GET_TYPE(flow_graph, from_vertex) & TYPE_STORE) and !is_operation_unbounded_and_registered)
+            cannot_be_chained = true;
+         if(no_chaining_of_load_and_store)
+            cannot_be_chained = true;
+         if(!HLS->allocation_information->is_operation_bounded(flow_graph, from_vertex, from_fu_type))
+            cannot_be_chained = true;
+      }
    }
    OutEdgeIterator oi, oi_end;
    max_ending_time = std::numeric_limits<double>::max();
@@ -1462,16 +1666,17 @@ bool parametric_list_based::BB_update_resources_use(unsigned int& used_resources
    }
 }
 
-void parametric_list_based::add_to_priority_queues(PriorityQueues& priority_queue, std::set<unsigned int, resource_ordering_functor>& ready_resources, const vertex v) const
+void parametric_list_based::add_to_priority_queues(PriorityQueues& priority_queue, std::set<unsigned int, resource_ordering_functor>& ready_resources, const priority_data<int>& priority, const vertex v) const
 {
+   const ReadyListEntry entry(priority(v) - priority.get_uniform_increment(), v);
    unsigned int fu_name;
    if(HLS->allocation_information->is_vertex_bounded_with(v, fu_name))
    {
 #if HAVE_UNORDERED
-      priority_queue[fu_name].push(v);
+      priority_queue[fu_name].push(entry);
 #else
       INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---" + GET_NAME(flow_graph, v) + " bound to " + HLS->allocation_information->get_fu_name(fu_name).first);
-      priority_queue[fu_name].insert(v);
+      priority_queue[fu_name].insert(entry);
 #endif
       ready_resources.insert(fu_name);
    }
@@ -1482,9 +1687,9 @@ void parametric_list_based::add_to_priority_queues(PriorityQueues& priority_queu
       for(auto fu_set_it = fu_set.begin(); fu_set_it != fu_set_it_end; ++fu_set_it)
       {
 #if HAVE_UNORDERED
-         priority_queue[*fu_set_it].push(v);
+         priority_queue[*fu_set_it].push(entry);
 #else
-         priority_queue[*fu_set_it].insert(v);
+         priority_queue[*fu_set_it].insert(entry);
 #endif
          ready_resources.insert(*fu_set_it);
       }
@@ -2428,6 +2633,12 @@ bool parametric_list_based::check_LOAD_chaining(vertex current_v, const ControlS
    return false;
 }
 
+bool parametric_list_based::IsFunctionLocal() const
+{
+   /// the schedule, the binding and the allocation information written by the step belong to the function; the tree_manager and the memory are only read
+   return true;
+}
+
 const CustomUnorderedSet<std::tuple<HLSFlowStep_Type, HLSFlowStepSpecializationConstRef, HLSFlowStep_Relationship>> parametric_list_based::ComputeHLSRelationships(const DesignFlowStep::RelationshipType relationship_type) const
 {
    CustomUnorderedSet<std::tuple<HLSFlowStep_Type, HLSFlowStepSpecializationConstRef, HLSFlowStep_Relationship>> ret = Scheduling::ComputeHLSRelationships(relationship_type);
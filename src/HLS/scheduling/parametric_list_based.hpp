@@ -48,7 +48,9 @@
 #define PARAMETRIC_LIST_BASED_HPP
 
 #include <iosfwd>
+#include <queue>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "Vertex.hpp"
@@ -56,8 +58,8 @@
 #include "custom_set.hpp"
 #include "hash_helper.hpp"
 #include "op_graph.hpp"
+#include "priority.hpp"
 #include "refcount.hpp"
-#include "rehashed_heap.hpp"
 #include "scheduling.hpp"
 
 /**
@@ -74,35 +76,66 @@ REF_FORWARD_DECL(fu_binding);
 class OpVertexSet;
 //@}
 
+/**
+ * Element of a ready list: the key of the operation and the operation itself.
+ * The key is the priority of the operation minus the increment uniformly applied to all the ready operations when it was pushed,
+ * so that it does not change while the operation stays ready and the ready lists never have to be reordered.
+ */
+typedef std::pair<int, vertex> ReadyListEntry;
+
 #if HAVE_UNORDERED
-typedef std::vector<rehashed_heap<int>> PriorityQueues;
+/// Sorter for the ready list heaps: the top of the heap is the entry with the highest key
+struct ReadyListEntryCompare
+{
+   /**
+    * Compare two entries
+    * @param x is the first entry
+    * @param y is the second entry
+    * @return true if x has to be extracted after y
+    */
+   bool operator()(const ReadyListEntry& x, const ReadyListEntry& y) const
+   {
+      return x.first < y.first || (x.first == y.first && x.second > y.second);
+   }
+};
+
+/// Heap storing the ready list of a functional unit type
+struct ReadyListHeap : public std::priority_queue<ReadyListEntry, std::vector<ReadyListEntry>, ReadyListEntryCompare>
+{
+   std::vector<ReadyListEntry>::const_iterator begin() const
+   {
+      return c.begin();
+   }
+   std::vector<ReadyListEntry>::const_iterator end() const
+   {
+      return c.end();
+   }
+};
+
+typedef std::vector<ReadyListHeap> PriorityQueues;
 #else
 /// Sorter for connection
-struct PrioritySorter : public std::binary_function<vertex, vertex, bool>
+struct PrioritySorter : public std::binary_function<ReadyListEntry, ReadyListEntry, bool>
 {
-   /// The priority
-   refcount<priority_data<int>> priority;
-
    /// The operation graph
    const OpGraphConstRef op_graph;
 
    /**
     * Constructor
-    * @param priority is the priority associated with each vertex
     * @param op_graph is the operation graph
     */
-   PrioritySorter(const refcount<priority_data<int>> priority, const OpGraphConstRef op_graph);
+   explicit PrioritySorter(const OpGraphConstRef op_graph);
 
    /**
-    * Compare position of two vertices
-    * @param x is the first vertex
-    * @param y is the second vertex
-    * @return true if index of x is less than y
+    * Compare position of two entries
+    * @param x is the first entry
+    * @param y is the second entry
+    * @return true if x has to be extracted before y
     */
-   bool operator()(const vertex x, const vertex y) const;
+   bool operator()(const ReadyListEntry& x, const ReadyListEntry& y) const;
 };
 
-typedef std::vector<std::set<vertex, PrioritySorter>> PriorityQueues;
+typedef std::vector<std::set<ReadyListEntry, PrioritySorter>> PriorityQueues;
 #endif
 
 enum class ParametricListBased_Metric
@@ -214,11 +247,12 @@ class parametric_list_based : public Scheduling
 
    /**
     * Adds the vertex v to the priority queues
-    * @param priority_trees are the priority_queues
+    * @param priority_queue are the priority_queues
     * @param ready_resources is the set of resources which have at least one ready operation
+    * @param priority is the priority associated with each vertex
     * @param v is the vertex.
     */
-   void add_to_priority_queues(PriorityQueues& priority_queue, std::set<unsigned int, resource_ordering_functor>& ready_resources, const vertex v) const;
+   void add_to_priority_queues(PriorityQueues& priority_queue, std::set<unsigned int, resource_ordering_functor>& ready_resources, const priority_data<int>& priority, const vertex v) const;
 
    /**
     * compute the slack of a given operation and in case specify if is pipelined
@@ -277,6 +311,18 @@ class parametric_list_based : public Scheduling
     */
    const CustomUnorderedSet<std::tuple<HLSFlowStep_Type, HLSFlowStepSpecializationConstRef, HLSFlowStep_Relationship>> ComputeHLSRelationships(const DesignFlowStep::RelationshipType relationship_type) const override;
 
+   /**
+    * Check if InternalExec only writes the HLS data structures of the scheduled function
+    */
+   bool IsFunctionLocal() const override;
+
+   /**
+    * Return the scheduled operations sorted by basic block number and by position inside the basic block;
+    * differently from vertex names and node indices, this order does not depend on the rest of the translation unit
+    * @return the sorted operations or an empty vector if some operation does not belong to any basic block
+    */
+   std::vector<vertex> GetCacheOperationOrder() const;
+
  public:
    /**
     * This is the constructor of the list_based.
@@ -315,5 +361,26 @@ class parametric_list_based : public Scheduling
     * @param relationship_type is the type of relationship to be computed
     */
    void ComputeRelationships(DesignFlowStepSet& relationship, const DesignFlowStep::RelationshipType relationship_type) override;
+
+   /**
+    * Compute the key used to store the schedule in the step cache; the key is a structural hash of the body of the function
+    * (statements printed without node indices) together with the allocated functional units and the timing constraints,
+    * so that a function is scheduled again only if it or one of its callees has changed
+    * @return the key or the empty string if the schedule cannot be reused
+    */
+   std::string ComputeCacheKey() const override;
+
+   /**
+    * Restore schedule and functional unit binding from the step cache
+    * @param cache_file is the file containing the cached schedule
+    * @return true if the schedule has been restored
+    */
+   bool LoadCachedResult(const std::string& cache_file) override;
+
+   /**
+    * Store schedule and functional unit binding in the step cache
+    * @param cache_file is the file where the schedule has to be written
+    */
+   void StoreCachedResult(const std::string& cache_file) const override;
 };
 #endif
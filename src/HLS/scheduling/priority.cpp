@@ -65,7 +65,7 @@ priority_static_mobility::priority_static_mobility(const ASLAPRef& aslap)
    }
 }
 
-priority_dynamic_mobility::priority_dynamic_mobility(const ASLAPRef& aslap, const OpVertexSet& _ready_nodes, unsigned int _ctrl_step_multiplier) : ready_nodes(_ready_nodes), ctrl_step_multiplier(_ctrl_step_multiplier)
+priority_dynamic_mobility::priority_dynamic_mobility(const ASLAPRef& aslap, const OpVertexSet& _ready_nodes, unsigned int _ctrl_step_multiplier) : ready_nodes(_ready_nodes), ctrl_step_multiplier(_ctrl_step_multiplier), uniform_increment(0)
 {
    const ScheduleConstRef asap = aslap->CGetASAP();
    const ScheduleConstRef alap = aslap->CGetALAP();
@@ -91,6 +91,7 @@ bool priority_dynamic_mobility::update()
          operator[](*it) = operator[](*it) + static_cast<int>(ctrl_step_multiplier); /// increase priority
          it++;
       }
+      uniform_increment += static_cast<int>(ctrl_step_multiplier);
       return true;
    }
    else
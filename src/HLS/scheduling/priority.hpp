@@ -89,6 +89,14 @@ struct priority_data
    {
       return priority_values[_a];
    }
+   /**
+    * Return the increment uniformly applied by update to the priority of all the ready vertices so far.
+    * The priority of a vertex minus this value does not change as long as the vertex stays ready.
+    */
+   virtual dataType get_uniform_increment() const
+   {
+      return dataType();
+   }
    /**
     * Destructor.
     */
@@ -137,11 +145,21 @@ struct priority_dynamic_mobility : public priority_data<int>
     */
    bool update() override;
 
+   /**
+    * Return the sum of the increments applied to the ready nodes so far.
+    */
+   int get_uniform_increment() const override
+   {
+      return uniform_increment;
+   }
+
  private:
    /// set of ready vertices.
    const OpVertexSet& ready_nodes;
    /// multiplier used to take into account chaining during asap/alap computation
    unsigned int ctrl_step_multiplier;
+   /// sum of the increments applied to the ready nodes so far
+   int uniform_increment;
 };
 
 /**
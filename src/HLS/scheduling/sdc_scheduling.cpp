@@ -88,6 +88,7 @@
 
 /// ilp include
 #include "meilp_solver.hpp"
+#include "sdc_solver.hpp"
 
 /// STD include
 #include <list>
@@ -572,8 +573,8 @@ DesignFlowStep_Status SDCScheduling::InternalExec()
 #ifndef NDEBUG
       const OpGraphConstRef debug_filtered_op_graph = FB->CGetOpGraph(FunctionBehavior::FLSAODDG, loop_operations);
 #endif
-      /// Create the solver
-      meilp_solverRef solver(meilp_solver::create_solver(static_cast<meilp_solver::supported_solvers>(parameters->getOption<int>(OPT_ilp_solver))));
+      /// Create the solver: the formulation is a system of difference constraints, so the ILP solver is used only as fallback
+      meilp_solverRef solver(new sdc_solver(static_cast<meilp_solver::supported_solvers>(parameters->getOption<int>(OPT_ilp_solver))));
       if(parameters->getOption<int>(OPT_ilp_max_time))
          solver->setMaximumSeconds(parameters->getOption<int>(OPT_ilp_max_time));
 
@@ -1258,6 +1259,24 @@ DesignFlowStep_Status SDCScheduling::InternalExec()
       /// Phi cannot be moved
       /// Operations which depend from the phi cannot be moved before the phi and so on
       INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Checking which operations have to be moved");
+      /// For each basic block of the loop, the operation which ends last and its last step
+      CustomMap<vertex, std::pair<vertex, ControlStep>> bb_last_operation;
+      for(const auto loop_bb : loop_bbs)
+      {
+         for(const auto bb_op : basic_block_graph->CGetBBNodeInfo(loop_bb)->statements_list)
+         {
+            const auto bb_op_step = HLS->Rsch->get_cstep(bb_op).second + (allocation_information->GetCycleLatency(bb_op) - 1u);
+            const auto last_operation = bb_last_operation.find(loop_bb);
+            if(last_operation == bb_last_operation.end())
+            {
+               bb_last_operation.insert(std::make_pair(loop_bb, std::make_pair(bb_op, bb_op_step)));
+            }
+            else if(last_operation->second.second < bb_op_step)
+            {
+               last_operation->second = std::make_pair(bb_op, bb_op_step);
+            }
+         }
+      }
       CustomMap<vertex, CustomSet<vertex>> bb_barrier;
       for(const auto loop_bb : loop_bbs)
       {
@@ -1351,16 +1370,12 @@ DesignFlowStep_Status SDCScheduling::InternalExec()
                   break;
                }
                bool overlapping = false;
-               for(const auto dominator_op : basic_block_graph->CGetBBNodeInfo(candidate_bb)->statements_list)
+               const auto last_operation = bb_last_operation.find(candidate_bb);
+               if(last_operation != bb_last_operation.end() and last_operation->second.second >= operation_step)
                {
-                  if((HLS->Rsch->get_cstep(dominator_op).second + (allocation_information->GetCycleLatency(dominator_op) - 1u)) >= operation_step)
-                  {
-                     INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level,
-                                    "---" + GET_NAME(filtered_op_graph, dominator_op) + " ends at " + STR(HLS->Rsch->get_cstep(dominator_op).second + (allocation_information->GetCycleLatency(dominator_op) - 1u)) + " - " +
-                                        GET_NAME(filtered_op_graph, loop_operation) + " ends at " + STR(operation_step));
-                     overlapping = true;
-                     break;
-                  }
+                  INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level,
+                                 "---" + GET_NAME(filtered_op_graph, last_operation->second.first) + " ends at " + STR(last_operation->second.second) + " - " + GET_NAME(filtered_op_graph, loop_operation) + " ends at " + STR(operation_step));
+                  overlapping = true;
                }
                if(not overlapping)
                {
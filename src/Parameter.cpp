@@ -175,6 +175,8 @@
 #endif
 
 /// STD include
+#include <cctype>
+#include <cerrno>
 #include <cstdlib>
 #include <iosfwd>
 
@@ -204,9 +206,36 @@ const std::string revision_hash = {
 #include "revision_hash.hpp"
 };
 
+void OptionValue::Set(const std::string& _value)
+{
+   is_set = true;
+   value = _value;
+   /// only plain decimal numbers are converted here; everything else is left to boost::lexical_cast when the option is read
+   const size_t first_digit = (not value.empty() and value[0] == '-') ? 1 : 0;
+   is_integer = value.size() > first_digit and value.find_first_not_of("0123456789", first_digit) == std::string::npos;
+   if(is_integer)
+   {
+      errno = 0;
+      integer_value = std::strtoll(value.c_str(), nullptr, 10);
+      is_integer = errno != ERANGE;
+   }
+   is_real = false;
+   if(not value.empty() and (std::isdigit(static_cast<unsigned char>(value[0])) or value[0] == '-' or value[0] == '+' or value[0] == '.'))
+   {
+      try
+      {
+         real_value = boost::lexical_cast<double>(value);
+         is_real = true;
+      }
+      catch(const boost::bad_lexical_cast&)
+      {
+      }
+   }
+}
+
 #define OPTION_NAME(r, data, elem) option_name[BOOST_PP_CAT(OPT_, elem)] = #elem;
 
-Parameter::Parameter(const std::string& _program_name, int _argc, char** const _argv, int _debug_level) : argc(_argc), argv(_argv), debug_level(_debug_level)
+Parameter::Parameter(const std::string& _program_name, int _argc, char** const _argv, int _debug_level) : argc(_argc), argv(_argv), enum_options(OPTIONS_NUMBER), debug_level(_debug_level)
 {
    setOption(OPT_program_name, _program_name);
    BOOST_PP_SEQ_FOR_EACH(OPTION_NAME, BOOST_PP_EMPTY, BAMBU_OPTIONS)
@@ -352,6 +381,9 @@ void Parameter::SetCommonDefaults()
    else
       setOption(OPT_revision, revision_hash + (branch_name != "" ? "-" + branch_name : ""));
    setOption(OPT_seed, 0);
+   setOption(OPT_jobs, 1);
+   setOption(OPT_technology_cache_directory, "");
+   setOption(OPT_step_cache_directory, "");
 
    setOption(OPT_cfg_max_transformations, std::numeric_limits<size_t>::max());
 }
@@ -363,10 +395,12 @@ void Parameter::print(std::ostream& os) const
    {
       os << Option.first << ": " << Option.second << std::endl;
    }
-   std::map<enum enum_option, std::string>::const_iterator option, option_end = enum_options.end();
-   for(option = enum_options.begin(); option != option_end; ++option)
+   for(size_t option = 0; option < enum_options.size(); ++option)
    {
-      os << option_name.find(option->first)->second << ": " << option->second << std::endl;
+      if(enum_options[option].is_set)
+      {
+         os << option_name.find(static_cast<enum enum_option>(option))->second << ": " << enum_options[option].value << std::endl;
+      }
    }
    os << " === " << std::endl;
 }
@@ -635,6 +669,41 @@ bool Parameter::ManageDefaultOptions(int next_option, char* optarg_param, bool&
          setOption(OPT_seed, optarg_param);
          break;
       }
+      case INPUT_OPT_JOBS:
+      {
+         if(boost::lexical_cast<int>(optarg_param) < 1)
+         {
+            THROW_ERROR("jobs must be a positive number: " + std::string(optarg_param));
+         }
+         setOption(OPT_jobs, optarg_param);
+         break;
+      }
+      case INPUT_OPT_TECHNOLOGY_CACHE:
+      {
+         boost::filesystem::path cache_path(optarg_param);
+         if(cache_path.is_relative())
+            cache_path = boost::filesystem::current_path() / cache_path;
+         boost::filesystem::create_directories(cache_path);
+         setOption(OPT_technology_cache_directory, cache_path.string());
+         break;
+      }
+      case INPUT_OPT_STEP_CACHE:
+      {
+         boost::filesystem::path cache_path(optarg_param);
+         if(cache_path.is_relative())
+            cache_path = boost::filesystem::current_path() / cache_path;
+         boost::filesystem::create_directories(cache_path);
+         setOption(OPT_step_cache_directory, cache_path.string());
+         break;
+      }
+      case INPUT_OPT_DFM_PROFILE:
+      {
+         boost::filesystem::path profile_path(optarg_param);
+         if(profile_path.is_relative())
+            profile_path = boost::filesystem::current_path() / profile_path;
+         setOption(OPT_dfm_profile, profile_path.string());
+         break;
+      }
       case OPT_OUTPUT_TEMPORARY_DIRECTORY:
       {
          /// If the path is not absolute, make it into absolute
@@ -1151,6 +1220,15 @@ bool Parameter::ManageGccOptions(int next_option, char* optarg_param)
          setOption(OPT_gcc_write_xml, optarg);
          break;
       }
+      case INPUT_OPT_COMPILER_CACHE:
+      {
+         boost::filesystem::path cache_path(optarg_param);
+         if(cache_path.is_relative())
+            cache_path = boost::filesystem::current_path() / cache_path;
+         boost::filesystem::create_directories(cache_path);
+         setOption(OPT_gcc_cache_directory, cache_path.string());
+         break;
+      }
       default:
       {
          /// next_option is not a GCC parameter
@@ -1482,6 +1560,23 @@ void Parameter::PrintGeneralOptionsUsage(std::ostream& os) const
       << "    --seed=<number>\n"
       << "        Set the seed of the random number generator (default=0).\n\n"
 #endif
+      << "    --jobs=<number>\n"
+      << "        Set the maximum number of independent steps executed concurrently (default=1).\n\n"
+      << "    --technology-cache=<dir>\n"
+      << "        Store in <dir> a binary image of the parsed technology and device XML\n"
+      << "        descriptions; the images are reused by later executions and rebuilt when\n"
+      << "        the XML description changes.\n\n"
+      << "    --step-cache=<dir>\n"
+      << "        Store in <dir> the results of the design flow steps which support it\n"
+      << "        (e.g., the synthesis and simulation based evaluations and the list based\n"
+      << "        scheduling of each function), indexed by the content of their inputs and\n"
+      << "        by the relevant options; a later execution with the same inputs reuses\n"
+      << "        the stored results, so after editing a function only that function and\n"
+      << "        its callers are scheduled again.\n\n"
+      << "    --dfm-profile=<prefix>\n"
+      << "        Profile the execution of the design flow steps: <prefix>.json contains\n"
+      << "        the trace of the executions in Chrome trace event format, while\n"
+      << "        <prefix>.csv contains a summary for each step.\n\n"
 #if !RELEASE
       << "    --read-parameters-XML=<xml_file_name>\n"
       << "        Read command line options from a XML file.\n\n"
@@ -1649,6 +1744,10 @@ void Parameter::PrintGccOptionsUsage(std::ostream& os) const
 #endif
       << "    --extra-gcc-options\n"
       << "        Specify custom extra options to the compiler.\n\n"
+      << "    --compiler-cache=<dir>\n"
+      << "        Store the raw files produced by the compiler in <dir> and reuse them\n"
+      << "        when the same preprocessed source is compiled again with the same\n"
+      << "        options and the same version of the tool.\n\n"
       << std::endl;
 }
 #endif
@@ -1782,7 +1881,7 @@ GccWrapper_OptimizationSet Parameter::getOption(const enum enum_option name) con
 template <>
 void Parameter::setOption(const enum enum_option name, const GccWrapper_OptimizationSet value)
 {
-   enum_options[name] = boost::lexical_cast<std::string>(static_cast<int>(value));
+   enum_options[name].Set(boost::lexical_cast<std::string>(static_cast<int>(value)));
 }
 #endif
 
@@ -1803,7 +1902,7 @@ HLSFlowStep_Type Parameter::getOption(const enum enum_option name) const
 template <>
 void Parameter::setOption(const enum enum_option name, const HLSFlowStep_Type hls_flow_step_type)
 {
-   enum_options[name] = boost::lexical_cast<std::string>(static_cast<int>(hls_flow_step_type));
+   enum_options[name].Set(boost::lexical_cast<std::string>(static_cast<int>(hls_flow_step_type)));
 }
 
 template <>
@@ -1815,7 +1914,7 @@ MemoryAllocation_Policy Parameter::getOption(const enum enum_option name) const
 template <>
 void Parameter::setOption(const enum enum_option name, const MemoryAllocation_Policy memory_allocation_policy)
 {
-   enum_options[name] = boost::lexical_cast<std::string>(static_cast<int>(memory_allocation_policy));
+   enum_options[name].Set(boost::lexical_cast<std::string>(static_cast<int>(memory_allocation_policy)));
 }
 
 template <>
@@ -1827,7 +1926,7 @@ MemoryAllocation_ChannelsType Parameter::getOption(const enum enum_option name)
 template <>
 void Parameter::setOption(const enum enum_option name, const MemoryAllocation_ChannelsType memory_allocation_channels_type)
 {
-   enum_options[name] = boost::lexical_cast<std::string>(static_cast<int>(memory_allocation_channels_type));
+   enum_options[name].Set(boost::lexical_cast<std::string>(static_cast<int>(memory_allocation_channels_type)));
 }
 
 template <>
@@ -1839,7 +1938,7 @@ CliqueCovering_Algorithm Parameter::getOption(const enum enum_option name) const
 template <>
 void Parameter::setOption(const enum enum_option name, const CliqueCovering_Algorithm clique_covering_algorithm)
 {
-   enum_options[name] = boost::lexical_cast<std::string>(static_cast<int>(clique_covering_algorithm));
+   enum_options[name].Set(boost::lexical_cast<std::string>(static_cast<int>(clique_covering_algorithm)));
 }
 
 template <>
@@ -1851,7 +1950,7 @@ Evaluation_Mode Parameter::getOption(const enum enum_option name) const
 template <>
 void Parameter::setOption(const enum enum_option name, const Evaluation_Mode evaluation_mode)
 {
-   enum_options[name] = boost::lexical_cast<std::string>(static_cast<int>(evaluation_mode));
+   enum_options[name].Set(boost::lexical_cast<std::string>(static_cast<int>(evaluation_mode)));
 }
 
 template <>
@@ -1863,7 +1962,7 @@ ParametricListBased_Metric Parameter::getOption(const enum enum_option name) con
 template <>
 void Parameter::setOption(const enum enum_option name, const ParametricListBased_Metric parametric_list_based_metric)
 {
-   enum_options[name] = boost::lexical_cast<std::string>(static_cast<int>(parametric_list_based_metric));
+   enum_options[name].Set(boost::lexical_cast<std::string>(static_cast<int>(parametric_list_based_metric)));
 }
 
 template <>
@@ -1875,10 +1974,40 @@ SDCScheduling_Algorithm Parameter::getOption(const enum enum_option name) const
 template <>
 void Parameter::setOption(const enum enum_option name, const SDCScheduling_Algorithm sdc_scheduling_algorithm)
 {
-   enum_options[name] = boost::lexical_cast<std::string>(static_cast<int>(sdc_scheduling_algorithm));
+   enum_options[name].Set(boost::lexical_cast<std::string>(static_cast<int>(sdc_scheduling_algorithm)));
 }
 
 #endif
+bool Parameter::IsOptionName(const std::string& name) const
+{
+   for(const auto& option : option_name)
+   {
+      if(option.second == "OPT_" + name)
+      {
+         return true;
+      }
+   }
+   return Options.find(name) != Options.end();
+}
+
+void Parameter::SetOptionByName(const std::string& name, const std::string& value)
+{
+   for(const auto& option : option_name)
+   {
+      if(option.second == "OPT_" + name)
+      {
+         enum_options[option.first].Set(value);
+         return;
+      }
+   }
+   const auto generic_option = Options.find(name);
+   if(generic_option == Options.end())
+   {
+      THROW_ERROR("Unknown option " + name);
+   }
+   generic_option->second = value;
+}
+
 bool Parameter::IsParameter(const std::string& name) const
 {
    return panda_parameters.find(name) != panda_parameters.end();
@@ -75,8 +75,10 @@
 #include <boost/preprocessor/cat.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
 #include <climits>
+#include <limits>
 #include <list>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 /// forward decl of xml Element
@@ -125,17 +127,17 @@ enum class DiopsisInstrumentWriter_Type;
        use_asynchronous_memories)(do_not_chain_memories)(bram_high_latency)(cdfc_module_binding_algorithm)(function_allocation_algorithm)(testbench_input_string)(testbench_input_xml)(weighted_clique_register_algorithm)(disable_function_proxy)(            \
        memory_mapped_top)(do_not_expose_globals)(connect_iob)(profiling_output)(disable_bounded_function)(discrepancy)(discrepancy_force)(discrepancy_hw)(discrepancy_no_load_pointers)(discrepancy_only)(discrepancy_permissive_ptrs)(dry_run_evaluation)(    \
        find_max_cfg_transformations)(generate_taste_architecture)(initial_internal_address)(mem_delay_read)(mem_delay_write)(memory_banks_number)(mixed_design)(no_parse_c_python)(num_accelerators)(post_rescheduling)(technology_file)(                      \
-       testbench_extra_gcc_flags)(timing_violation_abort)(top_design_name)(visualizer)(serialize_output)(use_ALUs)
+       testbench_extra_gcc_flags)(timing_violation_abort)(top_design_name)(visualizer)(serialize_output)(use_ALUs)(dse_configurations)(modulo_scheduling_report)
 
 #define FRAMEWORK_OPTIONS                                                                                                                                                                                                                                     \
-   (architecture)(benchmark_name)(cat_args)(cfg_max_transformations)(compatible_compilers)(compute_size_of)(configuration_name)(debug_level)(default_compiler)(dot_directory)(dump_profiling_data)(file_costs)(file_input_data)(host_compiler)(ilp_max_time)( \
-       ilp_solver)(input_file)(input_format)(model_costs)(no_clean)(no_parse_files)(no_return_zero)(output_file)(output_level)(output_temporary_directory)(output_directory)(panda_parameter)(parse_pragma)(pretty_print)(print_dot)(profiling_file)(         \
-       profiling_method)(program_name)(read_parameter_xml)(revision)(seed)(task_threshold)(test_multiple_non_deterministic_flows)(test_single_non_deterministic_flow)(top_functions_names)(use_rtl)(xml_input_configuration)(xml_output_configuration)(       \
-       write_parameter_xml)
+   (architecture)(benchmark_name)(cat_args)(cfg_max_transformations)(compatible_compilers)(compute_size_of)(configuration_name)(debug_level)(default_compiler)(dfm_profile)(dot_directory)(dump_profiling_data)(file_costs)(file_input_data)(host_compiler)(  \
+       ilp_max_time)(ilp_solver)(input_file)(input_format)(jobs)(model_costs)(no_clean)(no_parse_files)(no_return_zero)(output_file)(output_level)(output_temporary_directory)(output_directory)(panda_parameter)(parse_pragma)(pretty_print)(print_dot)(     \
+       profiling_file)(profiling_method)(program_name)(read_parameter_xml)(revision)(seed)(step_cache_directory)(task_threshold)(technology_cache_directory)(test_multiple_non_deterministic_flows)(test_single_non_deterministic_flow)(top_functions_names)( \
+       use_rtl)(xml_input_configuration)(xml_output_configuration)(write_parameter_xml)
 
 #define GCC_OPTIONS                                                                                                                                                                                                                                         \
    (gcc_config)(gcc_costs)(gcc_defines)(gcc_extra_options)(gcc_include_sysdir)(gcc_includes)(gcc_libraries)(gcc_library_directories)(gcc_openmp_simd)(gcc_opt_level)(gcc_m32_mx32)(gcc_optimizations)(gcc_optimization_set)(gcc_parameters)(gcc_plugindir)( \
-       gcc_read_xml)(gcc_standard)(gcc_undefines)(gcc_warnings)(gcc_c)(gcc_E)(gcc_S)(gcc_write_xml)
+       gcc_read_xml)(gcc_standard)(gcc_undefines)(gcc_warnings)(gcc_c)(gcc_E)(gcc_S)(gcc_write_xml)(gcc_cache_directory)
 
 #define GECCO_OPTIONS (algorithms)(analyses)
 
@@ -174,7 +176,7 @@ enum enum_option
    BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, BAMBU_OPTIONS) BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, EUCALIPTUS_OPTIONS) BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, FRAMEWORK_OPTIONS)
        BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, GCC_OPTIONS) BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, GECCO_OPTIONS) BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, KOALA_OPTIONS)
            BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, SPIDER_OPTIONS) BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, SYNTHESIS_OPTIONS) BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, TREE_PANDA_GCC_OPTIONS)
-               BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, ZEBU_OPTIONS)
+               BOOST_PP_SEQ_FOR_EACH(OPTIONS_ENUM, BOOST_PP_EMPTY, ZEBU_OPTIONS) OPTIONS_NUMBER
 };
 
 class OptionMap : public std::map<std::string, std::string>
@@ -191,6 +193,124 @@ class OptionMap : public std::map<std::string, std::string>
    ~OptionMap() = default;
 };
 
+/**
+ * The value of an enum option: the string form and the typed forms, computed once when the option is set
+ */
+struct OptionValue
+{
+   /// True if the option has been set
+   bool is_set;
+
+   /// The string form of the value
+   std::string value;
+
+   /// True if the value is an integer
+   bool is_integer;
+
+   /// The value as integer
+   long long int integer_value;
+
+   /// True if the value is a real number
+   bool is_real;
+
+   /// The value as real number
+   double real_value;
+
+   /**
+    * Constructor of an option not set
+    */
+   OptionValue() : is_set(false), is_integer(false), integer_value(0), is_real(false), real_value(0.0)
+   {
+   }
+
+   /**
+    * Set the value of the option and compute its typed forms
+    * @param _value is the string form of the value
+    */
+   void Set(const std::string& _value);
+
+   /**
+    * Unset the option
+    */
+   void Clear()
+   {
+      *this = OptionValue();
+   }
+};
+
+/**
+ * Conversion of the value of an option to a generic type
+ */
+template <typename G, typename Enable = void>
+struct OptionConversion
+{
+   static G Get(const OptionValue& option)
+   {
+      return boost::lexical_cast<G>(option.value);
+   }
+};
+
+/**
+ * Conversion of the value of an option to an integer type; the pre-computed value is used when it is in the range of the type
+ */
+template <typename G>
+struct OptionConversion<G, typename std::enable_if<std::is_integral<G>::value and not std::is_same<G, bool>::value>::type>
+{
+   static G Get(const OptionValue& option)
+   {
+      if(option.is_integer and (std::is_signed<G>::value ? (option.integer_value >= static_cast<long long int>(std::numeric_limits<G>::min()) and option.integer_value <= static_cast<long long int>(std::numeric_limits<G>::max())) :
+                                                           (option.integer_value >= 0 and static_cast<unsigned long long int>(option.integer_value) <= static_cast<unsigned long long int>(std::numeric_limits<G>::max()))))
+      {
+         return static_cast<G>(option.integer_value);
+      }
+      return boost::lexical_cast<G>(option.value);
+   }
+};
+
+/**
+ * Conversion of the value of an option to bool
+ */
+template <>
+struct OptionConversion<bool>
+{
+   static bool Get(const OptionValue& option)
+   {
+      if(option.value == "1")
+      {
+         return true;
+      }
+      if(option.value == "0")
+      {
+         return false;
+      }
+      return boost::lexical_cast<bool>(option.value);
+   }
+};
+
+/**
+ * Conversion of the value of an option to double
+ */
+template <>
+struct OptionConversion<double>
+{
+   static double Get(const OptionValue& option)
+   {
+      return option.is_real ? option.real_value : boost::lexical_cast<double>(option.value);
+   }
+};
+
+/**
+ * Conversion of the value of an option to string
+ */
+template <>
+struct OptionConversion<std::string>
+{
+   static const std::string& Get(const OptionValue& option)
+   {
+      return option.value;
+   }
+};
+
 #define DEFAULT_OPT_BASE 512
 #define OPT_READ_PARAMETERS_XML DEFAULT_OPT_BASE
 #define OPT_WRITE_PARAMETERS_XML DEFAULT_OPT_BASE + 1
@@ -205,6 +325,10 @@ class OptionMap : public std::map<std::string, std::string>
 #define INPUT_OPT_CONFIGURATION_NAME DEFAULT_OPT_BASE + 10
 #define INPUT_OPT_CFG_MAX_TRANSFORMATIONS DEFAULT_OPT_BASE + 11
 #define INPUT_OPT_PANDA_PARAMETER DEFAULT_OPT_BASE + 12
+#define INPUT_OPT_JOBS DEFAULT_OPT_BASE + 13
+#define INPUT_OPT_TECHNOLOGY_CACHE DEFAULT_OPT_BASE + 14
+#define INPUT_OPT_DFM_PROFILE DEFAULT_OPT_BASE + 15
+#define INPUT_OPT_STEP_CACHE DEFAULT_OPT_BASE + 16
 
 /// define the default tool short option string
 #define COMMON_SHORT_OPTIONS_STRING "hVv:d:"
@@ -215,7 +339,8 @@ class OptionMap : public std::map<std::string, std::string>
        {"write-parameters-XML", required_argument, nullptr, OPT_WRITE_PARAMETERS_XML}, {"debug", required_argument, nullptr, 'd'}, {"debug-classes", required_argument, nullptr, OPT_DEBUG_CLASSES}, {"no-clean", no_argument, nullptr, INPUT_OPT_NO_CLEAN}, \
        {"benchmark-name", required_argument, nullptr, OPT_BENCHMARK_NAME}, {"configuration-name", required_argument, nullptr, INPUT_OPT_CONFIGURATION_NAME}, {"benchmark-fake-parameters", required_argument, nullptr, OPT_BENCHMARK_FAKE_PARAMETERS},       \
        {"output-temporary-directory", required_argument, nullptr, OPT_OUTPUT_TEMPORARY_DIRECTORY}, {"error-on-warning", no_argument, nullptr, INPUT_OPT_ERROR_ON_WARNING}, {"print-dot", no_argument, nullptr, INPUT_OPT_PRINT_DOT},                         \
-       {"seed", required_argument, nullptr, INPUT_OPT_SEED}, {"cfg-max-transformations", required_argument, nullptr, INPUT_OPT_CFG_MAX_TRANSFORMATIONS},                                                                                                     \
+       {"seed", required_argument, nullptr, INPUT_OPT_SEED}, {"cfg-max-transformations", required_argument, nullptr, INPUT_OPT_CFG_MAX_TRANSFORMATIONS}, {"jobs", required_argument, nullptr, INPUT_OPT_JOBS},                                               \
+       {"technology-cache", required_argument, nullptr, INPUT_OPT_TECHNOLOGY_CACHE}, {"dfm-profile", required_argument, nullptr, INPUT_OPT_DFM_PROFILE}, {"step-cache", required_argument, nullptr, INPUT_OPT_STEP_CACHE},                                   \
    {                                                                                                                                                                                                                                                         \
       "panda-parameter", required_argument, nullptr, INPUT_OPT_PANDA_PARAMETER                                                                                                                                                                               \
    }
@@ -230,7 +355,8 @@ class OptionMap : public std::map<std::string, std::string>
 #define INPUT_OPT_STD 1 + INPUT_OPT_READ_GCC_XML
 #define INPUT_OPT_USE_RAW 1 + INPUT_OPT_STD
 #define INPUT_OPT_WRITE_GCC_XML 1 + INPUT_OPT_USE_RAW
-#define LAST_GCC_OPT INPUT_OPT_WRITE_GCC_XML
+#define INPUT_OPT_COMPILER_CACHE 1 + INPUT_OPT_WRITE_GCC_XML
+#define LAST_GCC_OPT INPUT_OPT_COMPILER_CACHE
 
 /// define the GCC short option string
 #define GCC_SHORT_OPTIONS_STRING "cf:I:D:U:O::l:L:W:Em:g::"
@@ -244,7 +370,7 @@ class OptionMap : public std::map<std::string, std::string>
 
 #define GCC_LONG_OPTIONS                                                                                                                                                                                                            \
    GCC_LONG_OPTIONS_COMPILER{"std", required_argument, nullptr, INPUT_OPT_STD}, GCC_LONG_OPTIONS_RAW_XML{"param", required_argument, nullptr, INPUT_OPT_PARAM}, {"Include-sysdir", no_argument, nullptr, INPUT_OPT_INCLUDE_SYSDIR}, \
-       {"gcc-config", no_argument, nullptr, INPUT_OPT_GCC_CONFIG}, {"compute-sizeof", no_argument, nullptr, INPUT_OPT_COMPUTE_SIZEOF},                                                                                              \
+       {"gcc-config", no_argument, nullptr, INPUT_OPT_GCC_CONFIG}, {"compute-sizeof", no_argument, nullptr, INPUT_OPT_COMPUTE_SIZEOF}, {"compiler-cache", required_argument, nullptr, INPUT_OPT_COMPILER_CACHE},                    \
    {                                                                                                                                                                                                                                \
       "extra-gcc-options", required_argument, nullptr, INPUT_OPT_CUSTOM_OPTIONS                                                                                                                                                     \
    }
@@ -346,8 +472,8 @@ class Parameter
    /// Map between the name of a parameter and the related string-form value
    CustomMap<std::string, std::string> panda_parameters;
 
-   /// Map between an enum option and the related string-form value
-   std::map<enum enum_option, std::string> enum_options;
+   /// The values of the enum options indexed by option
+   std::vector<OptionValue> enum_options;
 
    /// Name of the enum options
    std::map<enum enum_option, std::string> option_name;
@@ -532,8 +658,8 @@ class Parameter
    template <typename G>
    G getOption(const enum enum_option name) const
    {
-      THROW_ASSERT(enum_options.find(name) != enum_options.end(), "Option \"" + (option_name.find(name))->second + "\" not stored");
-      return boost::lexical_cast<G>(enum_options.find(name)->second);
+      THROW_ASSERT(isOption(name), "Option \"" + (option_name.find(name))->second + "\" not stored");
+      return OptionConversion<G>::Get(enum_options[name]);
    }
 
    /**
@@ -566,9 +692,22 @@ class Parameter
    template <typename G>
    void setOption(const enum enum_option name, const G value)
    {
-      enum_options[name] = boost::lexical_cast<std::string>(value);
+      enum_options[name].Set(boost::lexical_cast<std::string>(value));
    }
 
+   /**
+    * Return true if a name corresponds to an enum option or to an already stored generic option
+    * @param name is the name of the option without the OPT_ prefix (e.g., clock_period)
+    */
+   bool IsOptionName(const std::string& name) const;
+
+   /**
+    * Sets the value of an option given its name; names which are not known options (see IsOptionName) are rejected
+    * @param name is the name of the option without the OPT_ prefix (e.g., clock_period)
+    * @param value is the string form of the value
+    */
+   void SetOptionByName(const std::string& name, const std::string& value);
+
    /**
     * Tests if an option has been stored
     * @param name is the name of the option
@@ -596,7 +735,7 @@ class Parameter
     */
    bool isOption(const enum enum_option name) const
    {
-      return enum_options.find(name) != enum_options.end();
+      return enum_options[name].is_set;
    }
 
    /**
@@ -608,7 +747,7 @@ class Parameter
    {
       if(!isOption(name))
          return false;
-      enum_options.erase(name);
+      enum_options[name].Clear();
       return true;
    }
 
@@ -62,6 +62,7 @@
 #include "custom_map.hpp" // for map
 #include "custom_set.hpp" // for set
 #include <algorithm>      // for binary_search, sort
+#include <boost/dynamic_bitset.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/filtered_graph.hpp>
 #include <boost/graph/graphviz.hpp>
@@ -316,151 +317,180 @@ class compatibility_node_info_writer
    }
 };
 
+/// Set of vertex indices stored as a dense bitset: intersections and differences process a machine word at a time
+typedef boost::dynamic_bitset<> dense_vertex_set;
+
 /**
- * Class computing the maximal weighted clique from a generic graph
+ * Dense representation of a weighted compatibility graph used by the TTT based maximal clique searches.
+ * Vertices are renumbered from zero and neighborhoods are stored as dense_vertex_set,
+ * so that the graph is visited only once for each search.
  */
 template <typename Graph>
-class TTT_maximal_weighted_clique
+struct TTT_dense_graph
 {
-   /// vertex iterator
-   typedef typename boost::graph_traits<Graph>::vertex_iterator vertex_iterator;
    /// vertex object
    typedef typename boost::graph_traits<Graph>::vertex_descriptor vertex;
-   /// adjacency iterator
-   typedef typename boost::graph_traits<Graph>::adjacency_iterator adjacency_iterator;
-   /// out edge iterator
-   typedef typename boost::graph_traits<Graph>::out_edge_iterator edge_iterator;
 
-   /// set of vertices of the current clique
-   CustomUnorderedSet<vertex> Q;
-   /// set of vertices of the maximum clique found so far
-   CustomOrderedSet<vertex> Q_max;
-   /// weight of Q
-   int W_Q;
-   /// weight of Q_max
-   int W_Q_max;
+   /// vertex associated with each index
+   std::vector<vertex> vertices;
 
-   std::map<C_vertex, std::string>& names;
+   /// neighborhood of each vertex
+   std::vector<dense_vertex_set> neighbors;
+
+   /// adjacent vertices of each vertex with the weight of the connecting edge
+   std::vector<std::vector<std::pair<std::size_t, int>>> weighted_neighbors;
+
+   /// sum of the weights of the edges of each vertex
+   std::vector<int> weights;
+
+   /**
+    * Constructor
+    * @param g is the graph
+    */
+   explicit TTT_dense_graph(const Graph& g)
+   {
+      CustomUnorderedMap<vertex, std::size_t> vertex_to_index;
+      typename boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
+      for(boost::tie(vi, vi_end) = boost::vertices(g); vi != vi_end; ++vi)
+      {
+         vertex_to_index[*vi] = vertices.size();
+         vertices.push_back(*vi);
+      }
+      neighbors.resize(vertices.size(), dense_vertex_set(vertices.size()));
+      weighted_neighbors.resize(vertices.size());
+      weights.resize(vertices.size(), 0);
+      for(std::size_t index = 0; index < vertices.size(); ++index)
+      {
+         typename boost::graph_traits<Graph>::out_edge_iterator ei, ei_end;
+         for(boost::tie(ei, ei_end) = boost::out_edges(vertices[index], g); ei != ei_end; ++ei)
+         {
+            const auto target_index = vertex_to_index.find(boost::target(*ei, g))->second;
+            neighbors[index].set(target_index);
+            weighted_neighbors[index].push_back(std::make_pair(target_index, g[*ei].weight));
+            weights[index] += g[*ei].weight;
+         }
+      }
+   }
 
-   /// return the vertex of subg with the maximum intersection with cand
-   vertex get_max_weighted_adiacent_intersection(const CustomUnorderedSet<vertex>& subg, const CustomUnorderedSet<vertex>& cand, const Graph& g)
+   /// return the vertex of subg with the maximum weight of the edges towards cand
+   std::size_t get_max_weighted_adiacent_intersection(const dense_vertex_set& subg, const dense_vertex_set& cand) const
    {
-      vertex result = boost::graph_traits<Graph>::null_vertex();
-      THROW_ASSERT(!subg.empty(), "at least one element should belong to subg");
+      std::size_t result = vertices.size();
+      THROW_ASSERT(subg.any(), "at least one element should belong to subg");
       int max_weighted_intersection = -1;
-      const typename CustomUnorderedSet<vertex>::const_iterator it_end = subg.end();
-      for(auto it = subg.begin(); it != it_end; ++it)
+      for(auto index = subg.find_first(); index != dense_vertex_set::npos; index = subg.find_next(index))
       {
          int weight_intersection = 0;
-         edge_iterator ei, ei_end;
-         boost::tie(ei, ei_end) = boost::out_edges(*it, g);
-         for(; ei != ei_end; ++ei)
+         for(const auto& neighbor : weighted_neighbors[index])
          {
-            if(cand.find(boost::target(*ei, g)) != cand.end())
-               weight_intersection += g[*ei].weight;
+            if(cand.test(neighbor.first))
+               weight_intersection += neighbor.second;
          }
          if(weight_intersection > max_weighted_intersection)
          {
             max_weighted_intersection = weight_intersection;
-            result = *it;
+            result = index;
          }
       }
       THROW_ASSERT(max_weighted_intersection >= 0, "something of wrong happen");
       return result;
    }
 
-   /// return the vertex of ext having the maximum edge weight with respect to the graph g
-   vertex get_max_weight_vertex(CustomUnorderedSet<vertex>& ext, const Graph& g)
+   /// return the vertex of ext having the maximum edge weight
+   std::size_t get_max_weight_vertex(const dense_vertex_set& ext) const
    {
-      vertex result = boost::graph_traits<Graph>::null_vertex();
+      std::size_t result = vertices.size();
       int max_weight = -1;
-      THROW_ASSERT(!ext.empty(), "at least one element should belong to ext");
-      const typename CustomUnorderedSet<vertex>::const_iterator it_end = ext.end();
-      for(typename CustomUnorderedSet<vertex>::const_iterator it = ext.begin(); it != it_end; ++it)
+      THROW_ASSERT(ext.any(), "at least one element should belong to ext");
+      for(auto index = ext.find_first(); index != dense_vertex_set::npos; index = ext.find_next(index))
       {
-         int cur_weight = 0;
-         edge_iterator ei, ei_end;
-         boost::tie(ei, ei_end) = boost::out_edges(*it, g);
-         for(; ei != ei_end; ++ei)
-         {
-            cur_weight += g[*ei].weight;
-         }
-         if(cur_weight > max_weight)
+         if(weights[index] > max_weight)
          {
-            result = *it;
-            max_weight = cur_weight;
+            result = index;
+            max_weight = weights[index];
          }
       }
       THROW_ASSERT(max_weight >= 0, "something of wrong happen");
       return result;
    }
 
-   /// compute the delta of the weight by adding q_vertex to the clique
-   int compute_delta_weight(vertex q_vertex, CustomUnorderedSet<vertex> Q_set, const Graph& g)
+   /// compute the delta of the weight by adding q_vertex to the clique Q_set
+   int compute_delta_weight(std::size_t q_vertex, const dense_vertex_set& Q_set) const
    {
       int result = 0;
-      edge_iterator ei, ei_end;
-      boost::tie(ei, ei_end) = boost::out_edges(q_vertex, g);
-      for(; ei != ei_end; ++ei)
-         if(Q_set.find(boost::target(*ei, g)) != Q_set.end())
-            result += g[*ei].weight;
+      for(const auto& neighbor : weighted_neighbors[q_vertex])
+      {
+         if(Q_set.test(neighbor.first))
+            result += neighbor.second;
+      }
       return result;
    }
+};
+
+/**
+ * Class computing the maximal weighted clique from a generic graph
+ */
+template <typename Graph>
+class TTT_maximal_weighted_clique
+{
+   /// vertex object
+   typedef typename boost::graph_traits<Graph>::vertex_descriptor vertex;
+
+   /// set of vertices of the current clique
+   dense_vertex_set Q;
+   /// number of vertices of the current clique
+   std::size_t Q_size;
+   /// set of vertices of the maximum clique found so far
+   CustomOrderedSet<vertex> Q_max;
+   /// weight of Q
+   int W_Q;
+   /// weight of Q_max
+   int W_Q_max;
+
+   std::map<C_vertex, std::string>& names;
 
    /// recursive procedure expand defined in first cited paper
-   void expand(CustomUnorderedSet<vertex>& subg, CustomUnorderedSet<vertex>& cand, const Graph& g, int upper_bound)
+   void expand(const dense_vertex_set& subg, dense_vertex_set& cand, const TTT_dense_graph<Graph>& dg, int upper_bound)
    {
-      if(subg.empty() && Q.size() >= Q_max.size())
+      if(subg.none() && Q_size >= Q_max.size())
       {
-         if(Q.size() > Q_max.size() || W_Q > W_Q_max)
+         if(Q_size > Q_max.size() || W_Q > W_Q_max)
          {
             Q_max.clear();
-            Q_max.insert(Q.begin(), Q.end());
+            for(auto index = Q.find_first(); index != dense_vertex_set::npos; index = Q.find_next(index))
+               Q_max.insert(dg.vertices[index]);
             W_Q_max = W_Q;
             // std::cerr << "clique W=" << W_Q_max << " size=" << Q_max.size() << std::endl;
          }
          return;
       }
-      else if(cand.empty())
+      else if(cand.none())
          return;
 
       /// get the vertex in subg with the maximum of adjacent vertices in cand
-      vertex u = get_max_weighted_adiacent_intersection(subg, cand, g);
-      // vertex u =get_max_adiacent_intersection(subg, cand, g);
-      /// get adjacent vertices of u
-      adjacency_iterator vi, vi_end;
-      boost::tie(vi, vi_end) = boost::adjacent_vertices(u, g);
-      /// set of vertices adjacent to u
-      CustomUnorderedSet<vertex> gamma_u;
-      gamma_u.insert(vi, vi_end);
+      const auto u = dg.get_max_weighted_adiacent_intersection(subg, cand);
       /// compute EXT_u = CAND - gamma_u
-      CustomUnorderedSet<vertex> EXT_u;
-      unordered_set_difference(cand.begin(), cand.end(), gamma_u, std::inserter(EXT_u, EXT_u.end()));
-      while(!EXT_u.empty())
+      auto EXT_u = cand - dg.neighbors[u];
+      while(EXT_u.any())
       {
-         vertex q = get_max_weight_vertex(EXT_u, g);
-         // vertex q = get_max_degree_vertex(EXT_u, g);
-         // std::cerr << names[q] << "," << std::endl;
-         Q.insert(q);
+         const auto q = dg.get_max_weight_vertex(EXT_u);
+         Q.set(q);
+         ++Q_size;
          int W_Q_pre = W_Q;
          /// compute delta_weight
-         int delta = compute_delta_weight(q, Q, g);
+         int delta = dg.compute_delta_weight(q, Q);
          W_Q += delta;
-         boost::tie(vi, vi_end) = boost::adjacent_vertices(q, g);
-         CustomUnorderedSet<vertex> gamma_q;
-         gamma_q.insert(vi, vi_end);
-         CustomUnorderedSet<vertex> subg_q;
-         unordered_set_intersection(subg.begin(), subg.end(), gamma_q, std::inserter(subg_q, subg_q.end()));
-         CustomUnorderedSet<vertex> cand_q;
-         unordered_set_intersection(cand.begin(), cand.end(), gamma_q, std::inserter(cand_q, cand_q.end()));
-         expand(subg_q, cand_q, g, upper_bound);
+         const auto subg_q = subg & dg.neighbors[q];
+         auto cand_q = cand & dg.neighbors[q];
+         expand(subg_q, cand_q, dg, upper_bound);
          if(upper_bound <= W_Q_max)
             return;
-         cand.erase(q);
+         cand.reset(q);
          // std::cerr << "back," << std::endl;
-         Q.erase(q);
+         Q.reset(q);
+         --Q_size;
          W_Q = W_Q_pre;
-         EXT_u.erase(q);
+         EXT_u.reset(q);
       }
    }
 
@@ -468,17 +498,17 @@ class TTT_maximal_weighted_clique
    /// return the weighted maximal clique of a graph g
    const CustomOrderedSet<vertex> get_weighted_maximal_cliques(const Graph& g, int upper_bound)
    {
-      Q.clear();
+      const TTT_dense_graph<Graph> dg(g);
+      Q = dense_vertex_set(dg.vertices.size());
+      Q_size = 0;
       Q_max.clear();
       W_Q = 0;
       W_Q_max = std::numeric_limits<int>::min();
-      CustomUnorderedSet<vertex> subg;
-      CustomUnorderedSet<vertex> cand;
-      vertex_iterator vi, vi_end;
-      boost::tie(vi, vi_end) = boost::vertices(g);
-      subg.insert(vi, vi_end);
-      cand.insert(vi, vi_end);
-      expand(subg, cand, g, upper_bound);
+      dense_vertex_set subg(dg.vertices.size());
+      for(std::size_t index = 0; index < dg.vertices.size(); ++index)
+         subg.set(index);
+      auto cand = subg;
+      expand(subg, cand, dg, upper_bound);
       return Q_max;
    }
 
@@ -487,7 +517,7 @@ class TTT_maximal_weighted_clique
    {
       return W_Q_max;
    }
-   explicit TTT_maximal_weighted_clique(std::map<C_vertex, std::string>& _names) : W_Q(0), W_Q_max(std::numeric_limits<int>::min()), names(_names)
+   explicit TTT_maximal_weighted_clique(std::map<C_vertex, std::string>& _names) : Q(0), Q_size(0), W_Q(0), W_Q_max(std::numeric_limits<int>::min()), names(_names)
    {
    }
 };
@@ -498,17 +528,13 @@ class TTT_maximal_weighted_clique
 template <typename Graph>
 class TTT_maximal_weighted_clique_fast
 {
-   /// vertex iterator
-   typedef typename boost::graph_traits<Graph>::vertex_iterator vertex_iterator;
    /// vertex object
    typedef typename boost::graph_traits<Graph>::vertex_descriptor vertex;
-   /// adjacency iterator
-   typedef typename boost::graph_traits<Graph>::adjacency_iterator adjacency_iterator;
-   /// out edge iterator
-   typedef typename boost::graph_traits<Graph>::out_edge_iterator edge_iterator;
 
    /// set of vertices of the current clique
-   CustomUnorderedSet<vertex> Q;
+   dense_vertex_set Q;
+   /// number of vertices of the current clique
+   std::size_t Q_size;
    /// set of vertices of the maximum clique found so far
    CustomOrderedSet<vertex> Q_max;
    /// weight of Q
@@ -518,127 +544,48 @@ class TTT_maximal_weighted_clique_fast
 
    std::map<C_vertex, std::string>& names;
 
-   /// return the vertex of subg with the maximum intersection with cand
-   vertex get_max_weighted_adiacent_intersection(const CustomUnorderedSet<vertex>& subg, const CustomUnorderedSet<vertex>& cand, const Graph& g)
-   {
-      vertex result = boost::graph_traits<Graph>::null_vertex();
-      THROW_ASSERT(!subg.empty(), "at least one element should belong to subg");
-      int max_weighted_intersection = -1;
-      const typename CustomUnorderedSet<vertex>::const_iterator it_end = subg.end();
-      for(auto it = subg.begin(); it != it_end; ++it)
-      {
-         int weight_intersection = 0;
-         edge_iterator ei, ei_end;
-         boost::tie(ei, ei_end) = boost::out_edges(*it, g);
-         for(; ei != ei_end; ++ei)
-         {
-            if(cand.find(boost::target(*ei, g)) != cand.end())
-               weight_intersection += g[*ei].weight;
-         }
-         if(weight_intersection > max_weighted_intersection)
-         {
-            max_weighted_intersection = weight_intersection;
-            result = *it;
-         }
-      }
-      THROW_ASSERT(max_weighted_intersection >= 0, "something of wrong happen");
-      return result;
-   }
-
-   /// return the vertex of ext having the maximum degree with respect to the graph g
-   vertex get_max_weight_vertex(CustomUnorderedSet<vertex>& ext, const Graph& g)
-   {
-      vertex result = boost::graph_traits<Graph>::null_vertex();
-      int max_weight = -1;
-      THROW_ASSERT(!ext.empty(), "at least one element should belong to ext");
-      const typename CustomUnorderedSet<vertex>::const_iterator it_end = ext.end();
-      for(typename CustomUnorderedSet<vertex>::const_iterator it = ext.begin(); it != it_end; ++it)
-      {
-         int cur_weight = 0;
-         edge_iterator ei, ei_end;
-         boost::tie(ei, ei_end) = boost::out_edges(*it, g);
-         for(; ei != ei_end; ++ei)
-         {
-            cur_weight += g[*ei].weight;
-         }
-         if(cur_weight > max_weight)
-         {
-            result = *it;
-            max_weight = cur_weight;
-         }
-      }
-      THROW_ASSERT(max_weight >= 0, "something of wrong happen");
-      return result;
-   }
-
-   /// compute the delta of the weight by adding q_vertex to the clique
-   int compute_delta_weight(vertex q_vertex, CustomUnorderedSet<vertex> Q_set, const Graph& g)
-   {
-      int result = 0;
-      edge_iterator ei, ei_end;
-      boost::tie(ei, ei_end) = boost::out_edges(q_vertex, g);
-      for(; ei != ei_end; ++ei)
-         if(Q_set.find(boost::target(*ei, g)) != Q_set.end())
-            result += g[*ei].weight;
-      return result;
-   }
-
    /// recursive procedure expand defined in first cited paper
-   void expand(CustomUnorderedSet<vertex>& subg, CustomUnorderedSet<vertex>& cand, const Graph& g)
+   void expand(const dense_vertex_set& subg, dense_vertex_set& cand, const TTT_dense_graph<Graph>& dg)
    {
-      if(subg.empty() && Q.size() >= Q_max.size())
+      if(subg.none() && Q_size >= Q_max.size())
       {
-         if(Q.size() > Q_max.size() || W_Q > W_Q_max)
+         if(Q_size > Q_max.size() || W_Q > W_Q_max)
          {
             Q_max.clear();
-            Q_max.insert(Q.begin(), Q.end());
+            for(auto index = Q.find_first(); index != dense_vertex_set::npos; index = Q.find_next(index))
+               Q_max.insert(dg.vertices[index]);
             W_Q_max = W_Q;
             // std::cerr << "clique W=" << W_Q_max << " size=" << Q_max.size() << std::endl;
          }
          return;
       }
-      else if(cand.empty())
+      else if(cand.none())
          return;
 
       /// get the vertex in subg with the maximum of adjacent vertices in cand
-      vertex u = get_max_weighted_adiacent_intersection(subg, cand, g);
-      // vertex u =get_max_adiacent_intersection(subg, cand, g);
-      /// get adjacent vertices of u
-      adjacency_iterator vi, vi_end;
-      boost::tie(vi, vi_end) = boost::adjacent_vertices(u, g);
-      /// set of vertices adjacent to u
-      CustomUnorderedSet<vertex> gamma_u;
-      gamma_u.insert(vi, vi_end);
+      const auto u = dg.get_max_weighted_adiacent_intersection(subg, cand);
       /// compute EXT_u = CAND - gamma_u
-      CustomUnorderedSet<vertex> EXT_u;
-      unordered_set_difference(cand.begin(), cand.end(), gamma_u, std::inserter(EXT_u, EXT_u.end()));
-      while(!EXT_u.empty())
+      auto EXT_u = cand - dg.neighbors[u];
+      while(EXT_u.any())
       {
-         vertex q = get_max_weight_vertex(EXT_u, g);
-         // vertex q = get_max_degree_vertex(EXT_u, g);
-         // std::cerr << names[q] << "," << std::endl;
-         Q.insert(q);
+         const auto q = dg.get_max_weight_vertex(EXT_u);
+         Q.set(q);
+         ++Q_size;
          int W_Q_pre = W_Q;
          /// compute delta_weight
-         int delta = compute_delta_weight(q, Q, g);
+         int delta = dg.compute_delta_weight(q, Q);
          W_Q += delta;
-         // std::cerr << "W_Q=" << W_Q << std::endl;
-         boost::tie(vi, vi_end) = boost::adjacent_vertices(q, g);
-         CustomUnorderedSet<vertex> gamma_q;
-         gamma_q.insert(vi, vi_end);
-         CustomUnorderedSet<vertex> subg_q;
-         unordered_set_intersection(subg.begin(), subg.end(), gamma_q, std::inserter(subg_q, subg_q.end()));
-         CustomUnorderedSet<vertex> cand_q;
-         unordered_set_intersection(cand.begin(), cand.end(), gamma_q, std::inserter(cand_q, cand_q.end()));
-         expand(subg_q, cand_q, g);
-         // std::cerr << "W_Q_max=" << W_Q_max << std::endl;
+         const auto subg_q = subg & dg.neighbors[q];
+         auto cand_q = cand & dg.neighbors[q];
+         expand(subg_q, cand_q, dg);
          if(W_Q_max >= 0)
             return;
-         cand.erase(q);
+         cand.reset(q);
          // std::cerr << "back," << std::endl;
-         Q.erase(q);
+         Q.reset(q);
+         --Q_size;
          W_Q = W_Q_pre;
-         EXT_u.erase(q);
+         EXT_u.reset(q);
       }
    }
 
@@ -646,21 +593,21 @@ class TTT_maximal_weighted_clique_fast
    /// return the weighted maximal clique of a graph g
    const CustomOrderedSet<vertex> get_weighted_maximal_cliques(const Graph& g)
    {
-      Q.clear();
+      const TTT_dense_graph<Graph> dg(g);
+      Q = dense_vertex_set(dg.vertices.size());
+      Q_size = 0;
       Q_max.clear();
       W_Q = 0;
       W_Q_max = std::numeric_limits<int>::min();
-      CustomUnorderedSet<vertex> subg;
-      CustomUnorderedSet<vertex> cand;
-      vertex_iterator vi, vi_end;
-      boost::tie(vi, vi_end) = boost::vertices(g);
-      subg.insert(vi, vi_end);
-      cand.insert(vi, vi_end);
-      expand(subg, cand, g);
+      dense_vertex_set subg(dg.vertices.size());
+      for(std::size_t index = 0; index < dg.vertices.size(); ++index)
+         subg.set(index);
+      auto cand = subg;
+      expand(subg, cand, dg);
       return Q_max;
    }
 
-   explicit TTT_maximal_weighted_clique_fast(std::map<typename boost::graph_traits<Graph>::vertex_descriptor, std::string>& _names) : W_Q(0), W_Q_max(std::numeric_limits<int>::min()), names(_names)
+   explicit TTT_maximal_weighted_clique_fast(std::map<typename boost::graph_traits<Graph>::vertex_descriptor, std::string>& _names) : Q(0), Q_size(0), W_Q(0), W_Q_max(std::numeric_limits<int>::min()), names(_names)
    {
    }
 };
@@ -78,6 +78,7 @@
 #include "frontend_flow_step_factory.hpp"
 
 /// HLS includes
+#include "design_space_exploration.hpp"
 #include "hls_flow_step_factory.hpp"
 #include "hls_manager.hpp"
 #include "hls_step.hpp"
@@ -215,6 +216,9 @@ int main(int argc, char* argv[])
 
       // up to now all parameters have been parsed and data structures created, so synthesis can start
 
+      /// the parent process of the design space exploration has to run serially, so this has to be done before any data structure is created
+      const auto dse_jobs = parameters->isOption(OPT_dse_configurations) ? DesignSpaceExploration::SerializeParentProcess(parameters) : 1;
+
       /// ==== Creating target for the synthesis ==== ///
       HLS_targetRef HLS_T = HLS_target::create_target(parameters);
 
@@ -260,6 +264,20 @@ int main(int argc, char* argv[])
          design_flow_manager->Exec();
          return EXIT_SUCCESS;
       }
+      if(parameters->isOption(OPT_dse_configurations))
+      {
+         DesignSpaceExploration design_space_exploration(parameters, HLSMgr, design_flow_manager, frontend_flow_step_factory, hls_flow_step_factory, dse_jobs);
+         const auto explored = design_space_exploration.Exec();
+         if(not(parameters->getOption<bool>(OPT_no_clean)))
+         {
+            boost::filesystem::remove_all(parameters->getOption<std::string>(OPT_output_temporary_directory));
+         }
+         if(not explored)
+         {
+            THROW_ERROR("Design space exploration failed: no configuration has been synthesized");
+         }
+         return EXIT_SUCCESS;
+      }
 
       /// pretty printing
       if(parameters->isOption(OPT_pretty_print))
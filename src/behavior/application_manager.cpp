@@ -340,10 +340,10 @@ bool application_manager::ApplyNewTransformation() const
 void application_manager::RegisterTransformation(const std::string& step, const tree_nodeConstRef new_tn)
 {
    THROW_ASSERT(cfg_transformations < Param->getOption<size_t>(OPT_cfg_max_transformations), step + " - " + (new_tn ? new_tn->ToString() : ""));
-   cfg_transformations++;
+   const auto transformation = ++cfg_transformations;
    if(Param->getOption<size_t>(OPT_cfg_max_transformations) != std::numeric_limits<size_t>::max())
    {
-      INDENT_OUT_MEX(0, 0, "---Transformation " + STR(cfg_transformations) + " - " + step + " - " + (new_tn ? new_tn->ToString() : ""));
+      INDENT_OUT_MEX(0, 0, "---Transformation " + STR(transformation) + " - " + step + " - " + (new_tn ? new_tn->ToString() : ""));
    }
 }
 #endif
@@ -375,3 +375,27 @@ void application_manager::clearParm2SSA()
 {
    Parm2SSA_map.clear();
 }
+
+ApplicationSnapshotConstRef application_manager::CreateSnapshot() const
+{
+   const auto snapshot = refcount<ApplicationSnapshot>(new ApplicationSnapshot());
+   snapshot->tree_manager_snapshot = TM->CreateSnapshot();
+   snapshot->call_graph_snapshot = call_graph_manager->CreateSnapshot();
+   for(const auto& behavior : call_graph_manager->CGetCallGraph()->CGetCallGraphInfo()->behaviors)
+   {
+      snapshot->function_behavior_snapshots[behavior.first] = behavior.second->CreateSnapshot();
+   }
+   snapshot->Parm2SSA_map = Parm2SSA_map;
+   return snapshot;
+}
+
+void application_manager::RestoreSnapshot(const ApplicationSnapshotConstRef& snapshot)
+{
+   TM->RestoreSnapshot(snapshot->tree_manager_snapshot);
+   call_graph_manager->RestoreSnapshot(snapshot->call_graph_snapshot);
+   for(const auto& function_behavior_snapshot : snapshot->function_behavior_snapshots)
+   {
+      GetFunctionBehavior(function_behavior_snapshot.first)->RestoreSnapshot(function_behavior_snapshot.second);
+   }
+   Parm2SSA_map = snapshot->Parm2SSA_map;
+}
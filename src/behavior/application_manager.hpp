@@ -47,6 +47,7 @@
 #include "config_HAVE_FROM_DISCREPANCY_BUILT.hpp"
 #include "config_HAVE_PRAGMA_BUILT.hpp"
 
+#include <atomic>  // for atomic
 #include <cstddef> // for size_t
 #include <string>  // for string
 
@@ -59,19 +60,41 @@ CONSTREF_FORWARD_DECL(ActorGraphManager);
 REF_FORWARD_DECL(ActorGraphManager);
 REF_FORWARD_DECL(BehavioralHelper);
 CONSTREF_FORWARD_DECL(CallGraphManager);
+CONSTREF_FORWARD_DECL(CallGraphSnapshot);
 REF_FORWARD_DECL(CallGraphManager);
 CONSTREF_FORWARD_DECL(FunctionBehavior);
 REF_FORWARD_DECL(FunctionBehavior);
+CONSTREF_FORWARD_DECL(FunctionBehaviorSnapshot);
 CONSTREF_FORWARD_DECL(FunctionExpander);
 CONSTREF_FORWARD_DECL(Parameter);
 REF_FORWARD_DECL(pragma_manager);
 REF_FORWARD_DECL(tree_manager);
+CONSTREF_FORWARD_DECL(TreeManagerSnapshot);
 #ifndef NDEBUG
 CONSTREF_FORWARD_DECL(tree_node);
 #endif
 REF_FORWARD_DECL(tree_node);
 REF_FORWARD_DECL(Discrepancy);
 
+/**
+ * The state of the intermediate representation of the application saved by application_manager::CreateSnapshot
+ */
+struct ApplicationSnapshot
+{
+   /// The snapshot of the tree_manager
+   TreeManagerSnapshotConstRef tree_manager_snapshot;
+
+   /// The snapshot of the call points of the call graph
+   CallGraphSnapshotConstRef call_graph_snapshot;
+
+   /// The snapshots of the function behaviors
+   CustomMap<unsigned int, FunctionBehaviorSnapshotConstRef> function_behavior_snapshots;
+
+   /// The relation between parm_decl and ssa_name
+   CustomMap<unsigned, unsigned> Parm2SSA_map;
+};
+typedef refcount<const ApplicationSnapshot> ApplicationSnapshotConstRef;
+
 class application_manager
 {
  protected:
@@ -109,8 +132,8 @@ class application_manager
 #endif
 
 #ifndef NDEBUG
-   /// The number of cfg transformations applied to this function
-   size_t cfg_transformations;
+   /// The number of cfg transformations applied to this function; it is atomic since function frontend steps can be executed concurrently
+   std::atomic<size_t> cfg_transformations;
 #endif
 
    /// debugging level of the class
@@ -331,6 +354,19 @@ class application_manager
     * @brief clearParm2SSA cleans the map putting into relation parm_decl and ssa_name
     */
    void clearParm2SSA();
+
+   /**
+    * Save the intermediate representation of the application, so that alternative sequences of transformations can be applied and discarded
+    * The call graph is not saved, so transformations adding or removing calls cannot be discarded
+    * @return the snapshot
+    */
+   ApplicationSnapshotConstRef CreateSnapshot() const;
+
+   /**
+    * Restore the intermediate representation saved in a snapshot; the snapshot can be restored more than once
+    * @param snapshot is the snapshot to be restored
+    */
+   void RestoreSnapshot(const ApplicationSnapshotConstRef& snapshot);
 };
 /// refcount definition of the class
 typedef refcount<application_manager> application_managerRef;
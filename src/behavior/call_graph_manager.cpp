@@ -533,6 +533,50 @@ CustomOrderedSet<unsigned int> CallGraphManager::GetReachedLibraryFunctions() co
    return reached_library_functions;
 }
 
+CallGraphSnapshotConstRef CallGraphManager::CreateSnapshot() const
+{
+   const auto snapshot = refcount<CallGraphSnapshot>(new CallGraphSnapshot());
+   EdgeIterator e, e_end;
+   for(boost::tie(e, e_end) = boost::edges(*call_graph); e != e_end; ++e)
+   {
+      const auto caller_id = Cget_node_info<FunctionInfo, CallGraph>(boost::source(*e, *call_graph), *call_graph)->nodeID;
+      const auto called_id = Cget_node_info<FunctionInfo, CallGraph>(boost::target(*e, *call_graph), *call_graph)->nodeID;
+      const auto* edge_info = Cget_edge_info<FunctionEdgeInfo, CallGraph>(*e, *call_graph);
+      for(const auto call_id : edge_info->direct_call_points)
+      {
+         snapshot->call_points.insert(std::make_tuple(caller_id, called_id, call_id, FunctionEdgeInfo::CallType::direct_call));
+      }
+      for(const auto call_id : edge_info->indirect_call_points)
+      {
+         snapshot->call_points.insert(std::make_tuple(caller_id, called_id, call_id, FunctionEdgeInfo::CallType::indirect_call));
+      }
+      for(const auto call_id : edge_info->function_addresses)
+      {
+         snapshot->call_points.insert(std::make_tuple(caller_id, called_id, call_id, FunctionEdgeInfo::CallType::function_address));
+      }
+   }
+   return snapshot;
+}
+
+void CallGraphManager::RestoreSnapshot(const CallGraphSnapshotConstRef& snapshot)
+{
+   const auto current = CreateSnapshot();
+   for(const auto& call_point : current->call_points)
+   {
+      if(snapshot->call_points.find(call_point) == snapshot->call_points.end())
+      {
+         RemoveCallPoint(std::get<0>(call_point), std::get<1>(call_point), std::get<2>(call_point));
+      }
+   }
+   for(const auto& call_point : snapshot->call_points)
+   {
+      if(current->call_points.find(call_point) == current->call_points.end())
+      {
+         AddCallPoint(std::get<0>(call_point), std::get<1>(call_point), std::get<2>(call_point), std::get<3>(call_point));
+      }
+   }
+}
+
 CalledFunctionsVisitor::CalledFunctionsVisitor(const bool _allow_recursive_functions, const CallGraphManager* _call_graph_manager, CustomOrderedSet<unsigned int>& _body_functions, CustomOrderedSet<unsigned int>& _library_functions)
     : allow_recursive_functions(_allow_recursive_functions), call_graph_manager(_call_graph_manager), body_functions(_body_functions), library_functions(_library_functions)
 {
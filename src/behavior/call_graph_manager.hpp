@@ -51,6 +51,7 @@
 #include "graph.hpp"                          // for vertex, EdgeDesc...
 #include "refcount.hpp"                       // for CONSTREF_FORWARD...
 #include <boost/graph/depth_first_search.hpp> // for default_dfs_visitor
+#include <tuple>                              // for tuple
 
 CONSTREF_FORWARD_DECL(application_manager);
 CONSTREF_FORWARD_DECL(CallGraph);
@@ -63,6 +64,16 @@ CONSTREF_FORWARD_DECL(Parameter);
 CONSTREF_FORWARD_DECL(tree_manager);
 REF_FORWARD_DECL(tree_node);
 
+/**
+ * The call points of a call graph saved by CallGraphManager::CreateSnapshot
+ */
+struct CallGraphSnapshot
+{
+   /// The call points: caller function, called function, call statement and type of the call
+   CustomOrderedSet<std::tuple<unsigned int, unsigned int, unsigned int, FunctionEdgeInfo::CallType>> call_points;
+};
+typedef refcount<const CallGraphSnapshot> CallGraphSnapshotConstRef;
+
 /**
  * This class manages the accesses to the CallGraph
  */
@@ -278,6 +289,19 @@ class CallGraphManager
     * Returns a set containing all the reachable addressed_functions
     */
    CustomOrderedSet<unsigned int> GetAddressedFunctions() const;
+
+   /**
+    * Save the call points of the call graph; it has to be used together with tree_manager::CreateSnapshot
+    * @return the snapshot
+    */
+   CallGraphSnapshotConstRef CreateSnapshot() const;
+
+   /**
+    * Remove the call points added after the snapshot and add again the removed ones
+    * Functions added after the snapshot are not removed, but they are not reached anymore through the removed call points
+    * @param snapshot is the snapshot to be restored
+    */
+   void RestoreSnapshot(const CallGraphSnapshotConstRef& snapshot);
 };
 typedef refcount<CallGraphManager> CallGraphManagerRef;
 typedef refcount<const CallGraphManager> CallGraphManagerConstRef;
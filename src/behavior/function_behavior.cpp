@@ -66,6 +66,7 @@
 #include "loops.hpp"                            // for ProfilingInformatio...
 #include "op_graph.hpp"                         // for OpGraph, OpGraphCon...
 #include "operations_graph_constructor.hpp"     // for OpGraphRef, operati...
+#include "reachability_index.hpp"               // for ReachabilityIndex
 #include <boost/graph/adjacency_list.hpp>       // for adjacency_list
 #include <boost/graph/filtered_graph.hpp>       // for filtered_graph<>::v...
 #include <boost/iterator/filter_iterator.hpp>   // for filter_iterator
@@ -668,30 +669,12 @@ bool op_vertex_order_by_map::operator()(const vertex x, const vertex y) const
 
 bool FunctionBehavior::CheckBBReachability(const vertex first_basic_block, const vertex second_basic_block) const
 {
-   if(bb_reachability.find(first_basic_block) != bb_reachability.end() and bb_reachability.find(first_basic_block)->second.find(second_basic_block) != bb_reachability.find(first_basic_block)->second.end())
-   {
-      return true;
-   }
-   else
-   {
-      return false;
-   }
+   return bb_reachability and bb_reachability->IsReachable(first_basic_block, second_basic_block);
 }
 
 bool FunctionBehavior::CheckBBFeedbackReachability(const vertex first_basic_block, const vertex second_basic_block) const
 {
-   if(CheckBBReachability(first_basic_block, second_basic_block))
-   {
-      return true;
-   }
-   if(feedback_bb_reachability.find(first_basic_block) != feedback_bb_reachability.end() and feedback_bb_reachability.find(first_basic_block)->second.find(second_basic_block) != feedback_bb_reachability.find(first_basic_block)->second.end())
-   {
-      return true;
-   }
-   else
-   {
-      return false;
-   }
+   return feedback_bb_reachability and feedback_bb_reachability->IsReachable(first_basic_block, second_basic_block);
 }
 
 bool FunctionBehavior::CheckReachability(const vertex first_operation, const vertex second_operation) const
@@ -750,6 +733,42 @@ unsigned int FunctionBehavior::UpdateBitValueVersion()
    return bitvalue_version;
 }
 
+FunctionBehaviorSnapshotConstRef FunctionBehavior::CreateSnapshot() const
+{
+   const auto snapshot = refcount<FunctionBehaviorSnapshot>(new FunctionBehaviorSnapshot());
+   snapshot->mem_nodeID = mem_nodeID;
+   snapshot->dynamic_address = dynamic_address;
+   snapshot->parm_decl_copied = parm_decl_copied;
+   snapshot->parm_decl_loaded = parm_decl_loaded;
+   snapshot->parm_decl_stored = parm_decl_stored;
+   snapshot->state_variables = state_variables;
+   snapshot->dereference_unknown_address = dereference_unknown_address;
+   snapshot->pointer_type_conversion = pointer_type_conversion;
+   snapshot->unaligned_accesses = unaligned_accesses;
+   snapshot->has_globals = has_globals;
+   snapshot->has_undefined_function_receiveing_pointers = has_undefined_function_receiveing_pointers;
+   snapshot->pipelining_enabled = pipelining_enabled;
+   return snapshot;
+}
+
+void FunctionBehavior::RestoreSnapshot(const FunctionBehaviorSnapshotConstRef& snapshot)
+{
+   mem_nodeID = snapshot->mem_nodeID;
+   dynamic_address = snapshot->dynamic_address;
+   parm_decl_copied = snapshot->parm_decl_copied;
+   parm_decl_loaded = snapshot->parm_decl_loaded;
+   parm_decl_stored = snapshot->parm_decl_stored;
+   state_variables = snapshot->state_variables;
+   dereference_unknown_address = snapshot->dereference_unknown_address;
+   pointer_type_conversion = snapshot->pointer_type_conversion;
+   unaligned_accesses = snapshot->unaligned_accesses;
+   has_globals = snapshot->has_globals;
+   has_undefined_function_receiveing_pointers = snapshot->has_undefined_function_receiveing_pointers;
+   pipelining_enabled = snapshot->pipelining_enabled;
+   UpdateBBVersion();
+   UpdateBitValueVersion();
+}
+
 #if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)
 #pragma GCC diagnostic pop
 #endif
@@ -78,6 +78,7 @@ CONSTREF_FORWARD_DECL(BBGraph);
 REF_FORWARD_DECL(BBGraphsCollection);
 REF_FORWARD_DECL(BehavioralHelper);
 CONSTREF_FORWARD_DECL(BehavioralHelper);
+REF_FORWARD_DECL(ReachabilityIndex);
 REF_FORWARD_DECL(EpdGraphsCollection);
 REF_FORWARD_DECL(EpdGraph);
 REF_FORWARD_DECL(extended_pdg_constructor);
@@ -120,6 +121,24 @@ struct memory_access
 };
 typedef refcount<memory_access> memory_accessRef;
 
+/// The information of a FunctionBehavior saved by FunctionBehavior::CreateSnapshot; graphs are not saved since they are rebuilt when the versions change
+struct FunctionBehaviorSnapshot
+{
+   CustomOrderedSet<unsigned int> mem_nodeID;
+   CustomOrderedSet<unsigned int> dynamic_address;
+   CustomOrderedSet<unsigned int> parm_decl_copied;
+   CustomOrderedSet<unsigned int> parm_decl_loaded;
+   CustomOrderedSet<unsigned int> parm_decl_stored;
+   CustomOrderedSet<unsigned int> state_variables;
+   bool dereference_unknown_address;
+   bool pointer_type_conversion;
+   bool unaligned_accesses;
+   bool has_globals;
+   bool has_undefined_function_receiveing_pointers;
+   bool pipelining_enabled;
+};
+typedef refcount<const FunctionBehaviorSnapshot> FunctionBehaviorSnapshotConstRef;
+
 /// The access type to a variable
 enum class FunctionBehavior_VariableAccessType
 {
@@ -479,10 +498,10 @@ class FunctionBehavior
    };
 
    /// Mutual exclusion between basic blocks (based on control flow graph with flow edges)
-   CustomUnorderedMapStable<vertex, CustomUnorderedSet<vertex>> bb_reachability;
+   ReachabilityIndexRef bb_reachability;
 
-   /// Reachability between basic blocks based on control flow graph with feedback
-   CustomUnorderedMapStable<vertex, CustomUnorderedSet<vertex>> feedback_bb_reachability;
+   /// Reachability between basic blocks based on control flow graph with feedback; it includes bb_reachability
+   ReachabilityIndexRef feedback_bb_reachability;
 
    /// reference to the operations graph constructor
    const operations_graph_constructorRef ogc;
@@ -910,6 +929,19 @@ class FunctionBehavior
     * @return the new version
     */
    unsigned int UpdateBitValueVersion();
+
+   /**
+    * Save the information about the function which can be modified by frontend transformations; it has to be used together with tree_manager::CreateSnapshot
+    * @return the snapshot
+    */
+   FunctionBehaviorSnapshotConstRef CreateSnapshot() const;
+
+   /**
+    * Restore the information saved in a snapshot
+    * The versions are updated rather than restored, so that the steps executed after the snapshot are executed again on the restored intermediate representation
+    * @param snapshot is the snapshot to be restored
+    */
+   void RestoreSnapshot(const FunctionBehaviorSnapshotConstRef& snapshot);
 };
 
 typedef refcount<FunctionBehavior> FunctionBehaviorRef;
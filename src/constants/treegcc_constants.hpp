@@ -64,6 +64,9 @@
 /// bitcode LLVM temporary file
 #define STR_CST_llvm_obj_file "run-%%%%-%%%%-%%%%-%%%%.bc"
 
+/// preprocessed temporary file used to compute the key of the compiler cache
+#define STR_CST_gcc_preprocessed_file ".preprocessed-%%%%-%%%%-%%%%-%%%%.i"
+
 /// concatenated C temporary file
 #define STR_CST_concat_c_file ".concat-%%%%-%%%%-%%%%-%%%%.c"
 
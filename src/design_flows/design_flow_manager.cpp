@@ -43,24 +43,33 @@
 #include "design_flow_manager.hpp"
 
 #include "config_HAVE_ASSERTS.hpp"   // for HAVE_ASSERTS
+#include "config_HAVE_OPENMP.hpp"    // for HAVE_OPENMP
 #include "config_HAVE_UNORDERED.hpp" // for HAVE_UNORDERED
 
+#include <boost/filesystem.hpp>               // for exists, rename
 #include <boost/graph/adjacency_list.hpp>     // for adjacency_list, source
 #include <boost/graph/filtered_graph.hpp>     // for in_edges, num_vertices
 #include <boost/iterator/filter_iterator.hpp> // for filter_iterator
 #include <boost/iterator/iterator_facade.hpp> // for operator!=, operator++
 #include <boost/lexical_cast.hpp>             // for lexical_cast
 #include <boost/tuple/tuple.hpp>              // for tie
+#include <ctime>                              // for clock_gettime
+#include <exception>                          // for exception_ptr
+#include <fstream>                            // for ofstream
+#include <functional>                         // for hash
 #include <iterator>                           // for advance
 #include <list>                               // for list
+#include <sstream>                            // for stringstream
+#include <vector>                             // for vector
 #if !HAVE_UNORDERED
 #ifndef NDEBUG
 #include <random> // for uniform_int_distrib...
 #endif
 #endif
-#include "Parameter.hpp" // for Parameter, OPT_test...
-#include "cpu_stats.hpp" // for PrintVirtualDataMem...
-#include "cpu_time.hpp"  // for START_TIME, STOP_TIME
+#include "Parameter.hpp"            // for Parameter, OPT_test...
+#include "concurrent_execution.hpp" // for ConcurrentExecution
+#include "cpu_stats.hpp"            // for PrintVirtualDataMem...
+#include "cpu_time.hpp"             // for START_TIME, STOP_TIME
 #include "custom_set.hpp"
 #include "dbgPrintHelper.hpp"           // for DEBUG_LEVEL_VERY_PE...
 #include "design_flow_aux_step.hpp"     // for AuxDesignFlowStep
@@ -71,6 +80,110 @@
 #include "string_manipulation.hpp"      // for STR GET_CLASS
 #include <utility>                      // for pair
 
+/**
+ * Return the cpu time spent by the calling thread
+ * @return the cpu time in milliseconds
+ */
+static long GetThreadCpuTime()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+   struct timespec now
+   {
+   };
+   if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0)
+   {
+      return static_cast<long>(now.tv_sec) * 1000 + static_cast<long>(now.tv_nsec / 1000000);
+   }
+#endif
+   return p_cpu_time();
+}
+
+/**
+ * Return the textual representation of a step status
+ */
+static std::string PrintStatus(const DesignFlowStep_Status status)
+{
+   switch(status)
+   {
+      case DesignFlowStep_Status::ABORTED:
+         return "ABORTED";
+      case DesignFlowStep_Status::EMPTY:
+         return "EMPTY";
+      case DesignFlowStep_Status::NONEXISTENT:
+         return "NONEXISTENT";
+      case DesignFlowStep_Status::SKIPPED:
+         return "SKIPPED";
+      case DesignFlowStep_Status::SUCCESS:
+         return "SUCCESS";
+      case DesignFlowStep_Status::UNCHANGED:
+         return "UNCHANGED";
+      case DesignFlowStep_Status::UNEXECUTED:
+         return "UNEXECUTED";
+      case DesignFlowStep_Status::UNNECESSARY:
+         return "UNNECESSARY";
+      default:
+         THROW_UNREACHABLE("");
+   }
+   return "";
+}
+
+/**
+ * Escape a string to be used as JSON string
+ */
+static std::string JsonEscape(const std::string& input)
+{
+   std::string ret;
+   for(const auto c : input)
+   {
+      switch(c)
+      {
+         case '"':
+            ret += "\\\"";
+            break;
+         case '\\':
+            ret += "\\\\";
+            break;
+         case '\n':
+            ret += "\\n";
+            break;
+         case '\t':
+            ret += "\\t";
+            break;
+         default:
+            if(static_cast<unsigned char>(c) < 0x20)
+            {
+               ret += " ";
+            }
+            else
+            {
+               ret += c;
+            }
+      }
+   }
+   return ret;
+}
+
+/**
+ * Escape a string to be used as CSV field
+ */
+static std::string CsvEscape(const std::string& input)
+{
+   if(input.find_first_of(",\"\n") == std::string::npos)
+   {
+      return input;
+   }
+   std::string ret = "\"";
+   for(const auto c : input)
+   {
+      if(c == '"')
+      {
+         ret += '"';
+      }
+      ret += c;
+   }
+   return ret + "\"";
+}
+
 DesignFlowStepNecessitySorter::DesignFlowStepNecessitySorter(const DesignFlowGraphConstRef _design_flow_graph) : design_flow_graph(_design_flow_graph)
 {
 }
@@ -114,8 +227,16 @@ DesignFlowManager::DesignFlowManager(const ParameterConstRef _parameters)
       design_flow_graph(new DesignFlowGraph(design_flow_graphs_collection, DesignFlowGraph::DEPENDENCE_SELECTOR | DesignFlowGraph::PRECEDENCE_SELECTOR | DesignFlowGraph::AUX_SELECTOR)),
       feedback_design_flow_graph(new DesignFlowGraph(design_flow_graphs_collection, DesignFlowGraph::DEPENDENCE_SELECTOR | DesignFlowGraph::PRECEDENCE_SELECTOR | DesignFlowGraph::AUX_SELECTOR | DesignFlowGraph::DEPENDENCE_FEEDBACK_SELECTOR)),
       possibly_ready(std::set<vertex, DesignFlowStepNecessitySorter>(DesignFlowStepNecessitySorter(design_flow_graph))),
+      profile_prefix(_parameters->isOption(OPT_dfm_profile) ? _parameters->getOption<std::string>(OPT_dfm_profile) : ""),
+      profile_origin(std::chrono::steady_clock::now()),
       parameters(_parameters),
-      output_level(_parameters->getOption<int>(OPT_output_level))
+      output_level(_parameters->getOption<int>(OPT_output_level)),
+#if HAVE_OPENMP
+      jobs(_parameters->getOption<size_t>(OPT_jobs)),
+#else
+      jobs(1),
+#endif
+      step_cache_directory(_parameters->getOption<std::string>(OPT_step_cache_directory))
 {
    debug_level = parameters->get_class_debug_level(GET_CLASS(*this));
    const DesignFlowGraphInfoRef design_flow_graph_info = design_flow_graph->GetDesignFlowGraphInfo();
@@ -408,7 +529,7 @@ void DesignFlowManager::Exec()
    size_t skipped_passes = 0;
    size_t graph_changes = 0;
    long design_flow_manager_time = 0;
-   while(possibly_ready.size())
+   while(possibly_ready.size() or parallel_executions.size())
    {
       const size_t initial_number_vertices = boost::num_vertices(*feedback_design_flow_graph);
       const size_t initial_number_edges = boost::num_vertices(*feedback_design_flow_graph);
@@ -424,6 +545,11 @@ void DesignFlowManager::Exec()
 #endif
       INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--");
       const vertex next = [&]() -> vertex {
+         /// The other steps of the last parallel batch have already been executed and are completed before anything else
+         if(parallel_executions.size())
+         {
+            return parallel_executions.begin()->first;
+         }
 #if !HAVE_UNORDERED
 #ifndef NDEBUG
          if(parameters->isOption(OPT_test_single_non_deterministic_flow))
@@ -439,10 +565,11 @@ void DesignFlowManager::Exec()
 #endif
          return *(possibly_ready.begin());
       }();
+      const bool parallel_executed = parallel_executions.find(next) != parallel_executions.end();
 #if HAVE_ASSERTS
       const auto erased_elements =
 #endif
-          possibly_ready.erase(next);
+          parallel_executed ? static_cast<size_t>(1) : possibly_ready.erase(next);
       const DesignFlowStepInfoRef design_flow_step_info = design_flow_graph->GetDesignFlowStepInfo(next);
       const DesignFlowStepRef step = design_flow_step_info->design_flow_step;
       INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Beginning iteration number " + boost::lexical_cast<std::string>(step_counter) + " - Considering step " + step->GetName());
@@ -456,84 +583,8 @@ void DesignFlowManager::Exec()
       INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--");
       THROW_ASSERT(erased_elements == 1, "Number of erased elements is " + STR(erased_elements));
 
-      /// Now check if next is actually ready
-      /// First of all check if there are new dependence to add
-      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Recomputing dependences");
-      DesignFlowStepSet pre_dependence_steps, pre_precedence_steps;
-      step->ComputeRelationships(pre_dependence_steps, DesignFlowStep::DEPENDENCE_RELATIONSHIP);
-      RecursivelyAddSteps(pre_dependence_steps, design_flow_step_info->status == DesignFlowStep_Status::UNNECESSARY);
-      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Recomputed dependences");
-      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Recompuring precedences");
-      step->ComputeRelationships(pre_precedence_steps, DesignFlowStep::PRECEDENCE_RELATIONSHIP);
-      RecursivelyAddSteps(pre_precedence_steps, true);
-      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Recomputed precedences");
-      bool current_ready = true;
-      DesignFlowStepSet::const_iterator pre_dependence_step, pre_dependence_step_end = pre_dependence_steps.end();
-      for(pre_dependence_step = pre_dependence_steps.begin(); pre_dependence_step != pre_dependence_step_end; ++pre_dependence_step)
-      {
-         const vertex pre_dependence_vertex = design_flow_graph->GetDesignFlowStep((*pre_dependence_step)->GetSignature());
-         design_flow_graphs_collection->AddDesignFlowDependence(pre_dependence_vertex, next, DesignFlowGraph::DEPENDENCE_SELECTOR);
-         const DesignFlowStepInfoRef pre_info = design_flow_graph->GetDesignFlowStepInfo(pre_dependence_vertex);
-         switch(pre_info->status)
-         {
-            case DesignFlowStep_Status::ABORTED:
-            case DesignFlowStep_Status::EMPTY:
-            case DesignFlowStep_Status::SKIPPED:
-            case DesignFlowStep_Status::SUCCESS:
-            case DesignFlowStep_Status::UNCHANGED:
-            {
-               break;
-            }
-            case DesignFlowStep_Status::UNNECESSARY:
-            case DesignFlowStep_Status::UNEXECUTED:
-            {
-               current_ready = false;
-               break;
-            }
-            case DesignFlowStep_Status::NONEXISTENT:
-            {
-               THROW_UNREACHABLE("Step with nonexitent status");
-               break;
-            }
-            default:
-            {
-               THROW_UNREACHABLE("");
-            }
-         }
-      }
-      /// Now iterate on ingoing precedence edge
-      for(auto pre_precedence_step : pre_precedence_steps)
-      {
-         const vertex pre_precedence_vertex = design_flow_graph->GetDesignFlowStep((pre_precedence_step)->GetSignature());
-         design_flow_graphs_collection->AddDesignFlowDependence(pre_precedence_vertex, next, DesignFlowGraph::PRECEDENCE_SELECTOR);
-         const DesignFlowStepInfoRef pre_info = design_flow_graph->GetDesignFlowStepInfo(pre_precedence_vertex);
-         switch(pre_info->status)
-         {
-            case DesignFlowStep_Status::ABORTED:
-            case DesignFlowStep_Status::EMPTY:
-            case DesignFlowStep_Status::SKIPPED:
-            case DesignFlowStep_Status::SUCCESS:
-            case DesignFlowStep_Status::UNCHANGED:
-            {
-               break;
-            }
-            case DesignFlowStep_Status::UNNECESSARY:
-            case DesignFlowStep_Status::UNEXECUTED:
-            {
-               current_ready = false;
-               break;
-            }
-            case DesignFlowStep_Status::NONEXISTENT:
-            {
-               THROW_UNREACHABLE("Step with nonexitent status");
-               break;
-            }
-            default:
-            {
-               THROW_UNREACHABLE("");
-            }
-         }
-      }
+      /// Now check if next is actually ready; the readiness of a step executed in a parallel batch has been checked before its execution
+      const bool current_ready = parallel_executed or UpdateReadiness(next);
       if(not current_ready)
       {
          if(debug_level >= DEBUG_LEVEL_VERY_PEDANTIC)
@@ -569,31 +620,70 @@ void DesignFlowManager::Exec()
       }
       STOP_TIME(before_time);
       design_flow_manager_time += before_time;
-      if(design_flow_step_info->status == DesignFlowStep_Status::UNNECESSARY)
+      if(not parallel_executed and design_flow_step_info->status == DesignFlowStep_Status::UNNECESSARY)
       {
          INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Skipping execution of " + step->GetName() + " since unnecessary");
          design_flow_step_info->status = DesignFlowStep_Status::SKIPPED;
       }
-      else if(step->HasToBeExecuted())
+      else if(parallel_executed or step->HasToBeExecuted())
       {
 #ifndef NDEBUG
          size_t indentation_before = indentation;
 #endif
          INDENT_OUT_MEX(OUTPUT_LEVEL_VERY_PEDANTIC, output_level, "-->Starting execution of " + step->GetName());
          long step_execution_time;
-         START_TIME(step_execution_time);
-         step->Initialize();
-         if(step->CGetDebugLevel() >= DEBUG_LEVEL_VERY_PEDANTIC)
+         StepExecutionProfile profile{};
+         DesignFlowStep_Status step_status;
+         if(jobs > 1 and not parallel_executed and step->IsParallelizable())
          {
-            step->PrintInitialIR();
+            ExecuteParallelSteps(next);
          }
-         design_flow_step_info->status = step->Exec();
-         executed_passes++;
-         if(step->CGetDebugLevel() >= DEBUG_LEVEL_VERY_PEDANTIC)
+         if(parallel_executions.find(next) != parallel_executions.end())
+         {
+            /// The step has already been executed together with other steps and its status has already been set: it could
+            /// have been invalidated since then by another step of the same batch and in this case it will be executed again
+            step_status = parallel_executions.find(next)->second.first;
+            step_execution_time = parallel_executions.find(next)->second.second;
+            parallel_executions.erase(next);
+            if(not profile_prefix.empty())
+            {
+               profile = parallel_profiles.at(next);
+               parallel_profiles.erase(next);
+            }
+         }
+         else
+         {
+            if(not profile_prefix.empty())
+            {
+               profile.start = GetProfileTime();
+               profile.peak_rss_delta = GetPeakResidentSetSize();
+            }
+            START_TIME(step_execution_time);
+            step->Initialize();
+            if(step->CGetDebugLevel() >= DEBUG_LEVEL_VERY_PEDANTIC)
+            {
+               step->PrintInitialIR();
+            }
+            design_flow_step_info->status = ExecuteCachedStep(step);
+            step_status = design_flow_step_info->status;
+            if(step->CGetDebugLevel() >= DEBUG_LEVEL_VERY_PEDANTIC)
+            {
+               step->PrintFinalIR();
+            }
+            STOP_TIME(step_execution_time);
+            if(not profile_prefix.empty())
+            {
+               profile.wall_time = GetProfileTime() - profile.start;
+               profile.cpu_time = step_execution_time;
+               profile.peak_rss_delta = GetPeakResidentSetSize() - profile.peak_rss_delta;
+            }
+         }
+         if(not profile_prefix.empty())
          {
-            step->PrintFinalIR();
+            profile.status = step_status;
+            RecordExecution(next, profile);
          }
-         STOP_TIME(step_execution_time);
+         executed_passes++;
          const std::string memory_usage =
 #ifndef NDEBUG
              std::string(" - Virtual Memory: ") + PrintVirtualDataMemoryUsage()
@@ -605,11 +695,11 @@ void DesignFlowManager::Exec()
          if(parameters->IsParameter("profile_steps"))
          {
             accumulated_execution_time[next] += step_execution_time;
-            if(design_flow_step_info->status == DesignFlowStep_Status::SUCCESS)
+            if(step_status == DesignFlowStep_Status::SUCCESS)
             {
                success_executions[next]++;
             }
-            else if(design_flow_step_info->status == DesignFlowStep_Status::UNCHANGED)
+            else if(step_status == DesignFlowStep_Status::UNCHANGED)
             {
                unchanged_executions[next]++;
             }
@@ -632,6 +722,7 @@ void DesignFlowManager::Exec()
          }
 #endif
       }
+      triggers.erase(next);
       long after_time;
       START_TIME(after_time);
       bool invalidations = false;
@@ -652,7 +743,7 @@ void DesignFlowManager::Exec()
             if(design_flow_graph->IsReachable(relationship_vertex, next))
             {
                design_flow_graphs_collection->AddDesignFlowDependence(next, relationship_vertex, DesignFlowGraph::DEPENDENCE_FEEDBACK_SELECTOR);
-               DeExecute(relationship_vertex, true);
+               DeExecute(relationship_vertex, true, next);
             }
             else
             {
@@ -740,6 +831,11 @@ void DesignFlowManager::Exec()
          {
             INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Adding " + design_flow_graph->CGetDesignFlowStepInfo(target)->design_flow_step->GetName() + " to list of ready steps");
             possibly_ready.insert(target);
+            /// A pending invalidation is a more relevant cause of the next execution than the last executed predecessor
+            if(not profile_prefix.empty() and (triggers.find(target) == triggers.end() or not triggers.find(target)->second.second))
+            {
+               triggers[target] = std::make_pair(next, false);
+            }
          }
          INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--");
       }
@@ -875,10 +971,287 @@ void DesignFlowManager::Exec()
       INDENT_OUT_MEX(OUTPUT_LEVEL_NONE, output_level, "<--");
    }
 #endif
+   if(not profile_prefix.empty())
+   {
+      WriteProfile();
+   }
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Total number of iterations: " + STR(step_counter));
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Ended execution of design flow");
 }
 
+bool DesignFlowManager::UpdateReadiness(const vertex step_vertex)
+{
+   const DesignFlowStepInfoRef design_flow_step_info = design_flow_graph->GetDesignFlowStepInfo(step_vertex);
+   /// First of all check if there are new dependence to add
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Recomputing dependences");
+   DesignFlowStepSet pre_dependence_steps, pre_precedence_steps;
+   design_flow_step_info->design_flow_step->ComputeRelationships(pre_dependence_steps, DesignFlowStep::DEPENDENCE_RELATIONSHIP);
+   RecursivelyAddSteps(pre_dependence_steps, design_flow_step_info->status == DesignFlowStep_Status::UNNECESSARY);
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Recomputed dependences");
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Recompuring precedences");
+   design_flow_step_info->design_flow_step->ComputeRelationships(pre_precedence_steps, DesignFlowStep::PRECEDENCE_RELATIONSHIP);
+   RecursivelyAddSteps(pre_precedence_steps, true);
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Recomputed precedences");
+   bool current_ready = true;
+   DesignFlowStepSet::const_iterator pre_dependence_step, pre_dependence_step_end = pre_dependence_steps.end();
+   for(pre_dependence_step = pre_dependence_steps.begin(); pre_dependence_step != pre_dependence_step_end; ++pre_dependence_step)
+   {
+      const vertex pre_dependence_vertex = design_flow_graph->GetDesignFlowStep((*pre_dependence_step)->GetSignature());
+      design_flow_graphs_collection->AddDesignFlowDependence(pre_dependence_vertex, step_vertex, DesignFlowGraph::DEPENDENCE_SELECTOR);
+      const DesignFlowStepInfoRef pre_info = design_flow_graph->GetDesignFlowStepInfo(pre_dependence_vertex);
+      switch(pre_info->status)
+      {
+         case DesignFlowStep_Status::ABORTED:
+         case DesignFlowStep_Status::EMPTY:
+         case DesignFlowStep_Status::SKIPPED:
+         case DesignFlowStep_Status::SUCCESS:
+         case DesignFlowStep_Status::UNCHANGED:
+         {
+            break;
+         }
+         case DesignFlowStep_Status::UNNECESSARY:
+         case DesignFlowStep_Status::UNEXECUTED:
+         {
+            current_ready = false;
+            break;
+         }
+         case DesignFlowStep_Status::NONEXISTENT:
+         {
+            THROW_UNREACHABLE("Step with nonexitent status");
+            break;
+         }
+         default:
+         {
+            THROW_UNREACHABLE("");
+         }
+      }
+   }
+   /// Now iterate on ingoing precedence edge
+   for(auto pre_precedence_step : pre_precedence_steps)
+   {
+      const vertex pre_precedence_vertex = design_flow_graph->GetDesignFlowStep((pre_precedence_step)->GetSignature());
+      design_flow_graphs_collection->AddDesignFlowDependence(pre_precedence_vertex, step_vertex, DesignFlowGraph::PRECEDENCE_SELECTOR);
+      const DesignFlowStepInfoRef pre_info = design_flow_graph->GetDesignFlowStepInfo(pre_precedence_vertex);
+      switch(pre_info->status)
+      {
+         case DesignFlowStep_Status::ABORTED:
+         case DesignFlowStep_Status::EMPTY:
+         case DesignFlowStep_Status::SKIPPED:
+         case DesignFlowStep_Status::SUCCESS:
+         case DesignFlowStep_Status::UNCHANGED:
+         {
+            break;
+         }
+         case DesignFlowStep_Status::UNNECESSARY:
+         case DesignFlowStep_Status::UNEXECUTED:
+         {
+            current_ready = false;
+            break;
+         }
+         case DesignFlowStep_Status::NONEXISTENT:
+         {
+            THROW_UNREACHABLE("Step with nonexitent status");
+            break;
+         }
+         default:
+         {
+            THROW_UNREACHABLE("");
+         }
+      }
+   }
+   return current_ready;
+}
+
+void DesignFlowManager::ExecuteParallelSteps(const vertex next)
+{
+   std::vector<vertex> batch;
+   batch.push_back(next);
+   /// The groups of the steps in the batch
+   CustomUnorderedSet<std::string> groups;
+   groups.insert(design_flow_graph->CGetDesignFlowStepInfo(next)->design_flow_step->GetParallelGroup());
+   /// possibly_ready can be modified by UpdateReadiness, so candidates are copied
+   const std::vector<vertex> candidates(possibly_ready.begin(), possibly_ready.end());
+   for(const auto candidate : candidates)
+   {
+      if(batch.size() >= jobs)
+      {
+         break;
+      }
+      if(possibly_ready.find(candidate) == possibly_ready.end() or parallel_executions.find(candidate) != parallel_executions.end())
+      {
+         continue;
+      }
+      const DesignFlowStepInfoConstRef candidate_info = design_flow_graph->CGetDesignFlowStepInfo(candidate);
+      if(candidate_info->status == DesignFlowStep_Status::UNNECESSARY or not candidate_info->design_flow_step->IsParallelizable())
+      {
+         continue;
+      }
+      const auto group = candidate_info->design_flow_step->GetParallelGroup();
+      if(groups.find(group) != groups.end())
+      {
+         continue;
+      }
+      /// A step is admitted only when all its dependences, including the ones created by UpdateReadiness, have been executed:
+      /// since the statuses of the whole batch are set as soon as it ends, nothing can change them before its execution
+      possibly_ready.erase(candidate);
+      if(not UpdateReadiness(candidate))
+      {
+         /// As in the serial execution, the step will become again ready when its new dependences will be executed
+         continue;
+      }
+      if(candidate_info->design_flow_step->HasToBeExecuted())
+      {
+         batch.push_back(candidate);
+         groups.insert(group);
+      }
+      else
+      {
+         possibly_ready.insert(candidate);
+      }
+   }
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Executing in parallel " + STR(batch.size()) + " steps");
+   std::vector<DesignFlowStepRef> steps;
+   for(const auto step_vertex : batch)
+   {
+      const DesignFlowStepRef step = design_flow_graph->CGetDesignFlowStepInfo(step_vertex)->design_flow_step;
+      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---" + step->GetName());
+      step->Initialize();
+      if(step->CGetDebugLevel() >= DEBUG_LEVEL_VERY_PEDANTIC)
+      {
+         step->PrintInitialIR();
+      }
+      steps.push_back(step);
+   }
+   std::vector<DesignFlowStep_Status> statuses(steps.size(), DesignFlowStep_Status::UNEXECUTED);
+   std::vector<long> execution_times(steps.size(), 0);
+   std::vector<StepExecutionProfile> profiles(steps.size(), StepExecutionProfile());
+   std::vector<std::exception_ptr> exceptions(steps.size());
+   const long batch_peak_rss = profile_prefix.empty() ? 0 : GetPeakResidentSetSize();
+   const auto steps_number = static_cast<int>(steps.size());
+   {
+      /// The shared data structures are locked only from here until all the threads have been joined
+      const ConcurrentExecution::Batch concurrent_batch;
+#if HAVE_OPENMP
+#pragma omp parallel for num_threads(static_cast<int>(jobs)) schedule(dynamic)
+#endif
+      for(int index = 0; index < steps_number; index++)
+      {
+         try
+         {
+            /// CPU time is shared by all the threads of the process, so wall time is measured
+            START_WTIME(execution_times[static_cast<size_t>(index)]);
+            auto& profile = profiles[static_cast<size_t>(index)];
+            if(not profile_prefix.empty())
+            {
+               profile.start = GetProfileTime();
+               profile.cpu_time = GetThreadCpuTime();
+#if HAVE_OPENMP
+               profile.thread = omp_get_thread_num();
+#endif
+            }
+            statuses[static_cast<size_t>(index)] = ExecuteCachedStep(steps[static_cast<size_t>(index)]);
+            if(not profile_prefix.empty())
+            {
+               profile.wall_time = GetProfileTime() - profile.start;
+               profile.cpu_time = GetThreadCpuTime() - profile.cpu_time;
+            }
+            STOP_WTIME(execution_times[static_cast<size_t>(index)]);
+         }
+         catch(...)
+         {
+            exceptions[static_cast<size_t>(index)] = std::current_exception();
+         }
+      }
+   }
+   for(const auto& exception : exceptions)
+   {
+      if(exception)
+      {
+         std::rethrow_exception(exception);
+      }
+   }
+   const long batch_peak_rss_delta = profile_prefix.empty() ? 0 : GetPeakResidentSetSize() - batch_peak_rss;
+   for(size_t index = 0; index < steps.size(); index++)
+   {
+      if(steps[index]->CGetDebugLevel() >= DEBUG_LEVEL_VERY_PEDANTIC)
+      {
+         steps[index]->PrintFinalIR();
+      }
+      design_flow_graph->GetDesignFlowStepInfo(batch[index])->status = statuses[index];
+      parallel_executions[batch[index]] = std::make_pair(statuses[index], execution_times[index]);
+      if(not profile_prefix.empty())
+      {
+         profiles[index].peak_rss_delta = batch_peak_rss_delta;
+         parallel_profiles[batch[index]] = profiles[index];
+      }
+   }
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Executed in parallel " + STR(batch.size()) + " steps");
+}
+
+DesignFlowStep_Status DesignFlowManager::ExecuteCachedStep(const DesignFlowStepRef& step) const
+{
+   const std::string key = step_cache_directory.empty() ? "" : step->ComputeCacheKey();
+   if(key.empty())
+   {
+      return step->Exec();
+   }
+   std::stringstream hash;
+   hash << std::hex << std::hash<std::string>()(key) << "_" << key.size();
+   const std::string cache_file = step_cache_directory + "/" + hash.str();
+   if(boost::filesystem::exists(cache_file))
+   {
+      /// The entry starts with the size of the key and with the key itself, which must match the one of this step, followed by the result stored by the step
+      std::ifstream cache_entry(cache_file, std::ios::binary);
+      size_t stored_key_size = 0;
+      cache_entry >> stored_key_size;
+      cache_entry.get();
+      std::string stored_key(stored_key_size == key.size() ? stored_key_size : 0, '\0');
+      if(stored_key_size == key.size() and cache_entry.read(&stored_key[0], static_cast<std::streamsize>(stored_key_size)) and stored_key == key)
+      {
+         const boost::filesystem::path cached_result = boost::filesystem::unique_path(cache_file + "-%%%%-%%%%-%%%%-%%%%");
+         {
+            std::ofstream cached_result_file(cached_result.string(), std::ios::binary);
+            cached_result_file << cache_entry.rdbuf();
+         }
+         const auto loaded = step->LoadCachedResult(cached_result.string());
+         boost::filesystem::remove(cached_result);
+         if(loaded)
+         {
+            INDENT_OUT_MEX(OUTPUT_LEVEL_VERBOSE, output_level, "---Result of " + step->GetName() + " restored from step cache: " + cache_file);
+            return DesignFlowStep_Status::SUCCESS;
+         }
+      }
+      else
+      {
+         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Step cache entry " + cache_file + " belongs to a different step");
+      }
+   }
+   const auto status = step->Exec();
+   if(status == DesignFlowStep_Status::SUCCESS or status == DesignFlowStep_Status::UNCHANGED)
+   {
+      /// The entry is first written and then renamed so that concurrent executions never read a partial entry
+      const boost::filesystem::path temporary_result = boost::filesystem::unique_path(cache_file + "-%%%%-%%%%-%%%%-%%%%");
+      step->StoreCachedResult(temporary_result.string());
+      if(boost::filesystem::exists(temporary_result))
+      {
+         const boost::filesystem::path temporary_cache_file = boost::filesystem::unique_path(cache_file + "-%%%%-%%%%-%%%%-%%%%");
+         {
+            std::ifstream result_file(temporary_result.string(), std::ios::binary);
+            std::ofstream cache_entry(temporary_cache_file.string(), std::ios::binary);
+            cache_entry << key.size() << "\n" << key;
+            if(result_file.peek() != std::ifstream::traits_type::eof())
+            {
+               cache_entry << result_file.rdbuf();
+            }
+         }
+         boost::filesystem::remove(temporary_result);
+         boost::filesystem::rename(temporary_cache_file, cache_file);
+         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Result of " + step->GetName() + " stored in step cache: " + cache_file);
+      }
+   }
+   return status;
+}
+
 vertex DesignFlowManager::GetDesignFlowStep(const std::string& signature) const
 {
    return design_flow_graphs_collection->GetDesignFlowStep(signature);
@@ -895,11 +1268,16 @@ void DesignFlowManager::RegisterFactory(const DesignFlowStepFactoryConstRef fact
    design_flow_step_factories[factory->GetPrefix()] = factory;
 }
 
-void DesignFlowManager::DeExecute(const vertex starting_vertex, const bool force_execution)
+void DesignFlowManager::DeExecute(const vertex starting_vertex, const bool force_execution, const vertex source)
 {
    /// Set not executed on the starting vertex
    const DesignFlowStepInfoRef design_flow_step_info = design_flow_graph->GetDesignFlowStepInfo(starting_vertex);
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---DeExecuting " + design_flow_step_info->design_flow_step->GetName());
+   if(not profile_prefix.empty() and design_flow_step_info->status != DesignFlowStep_Status::UNEXECUTED and design_flow_step_info->status != DesignFlowStep_Status::UNNECESSARY)
+   {
+      invalidations_number[starting_vertex]++;
+      triggers[starting_vertex] = std::make_pair(source, true);
+   }
    switch(design_flow_step_info->status)
    {
       case DesignFlowStep_Status::SUCCESS:
@@ -991,7 +1369,7 @@ void DesignFlowManager::DeExecute(const vertex starting_vertex, const bool force
          case DesignFlowStep_Status::UNCHANGED:
          case DesignFlowStep_Status::SKIPPED:
          {
-            DeExecute(target, false);
+            DeExecute(target, false, starting_vertex);
             break;
          }
          case DesignFlowStep_Status::UNNECESSARY:
@@ -1012,6 +1390,114 @@ void DesignFlowManager::DeExecute(const vertex starting_vertex, const bool force
    }
 }
 
+long long DesignFlowManager::GetProfileTime() const
+{
+   return static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - profile_origin).count());
+}
+
+void DesignFlowManager::RecordExecution(const vertex step_vertex, StepExecutionProfile profile)
+{
+   profile.name = design_flow_graph->CGetDesignFlowStepInfo(step_vertex)->design_flow_step->GetName();
+   profile.invalidation = false;
+   if(triggers.find(step_vertex) != triggers.end())
+   {
+      const auto& trigger = triggers.find(step_vertex)->second;
+      profile.trigger = design_flow_graph->CGetDesignFlowStepInfo(trigger.first)->design_flow_step->GetName() + " -> " + profile.name;
+      profile.invalidation = trigger.second;
+   }
+   execution_profiles.push_back(profile);
+}
+
+void DesignFlowManager::WriteProfile() const
+{
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Writing profile of design flow in " + profile_prefix + ".json and " + profile_prefix + ".csv");
+   std::ofstream trace(profile_prefix + ".json");
+   if(not trace)
+   {
+      THROW_ERROR("Cannot open " + profile_prefix + ".json");
+   }
+   /// Number of the executions of each step
+   CustomMap<std::string, size_t> executions;
+   trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+   bool first = true;
+   for(const auto& profile : execution_profiles)
+   {
+      const auto execution = ++executions[profile.name];
+      trace << (first ? "\n" : ",\n");
+      first = false;
+      trace << "{\"name\":\"" << JsonEscape(profile.name) << "\",\"cat\":\"design_flow_step\",\"ph\":\"X\",\"pid\":0,\"tid\":" << profile.thread << ",\"ts\":" << profile.start << ",\"dur\":" << profile.wall_time;
+      trace << ",\"args\":{\"status\":\"" << PrintStatus(profile.status) << "\",\"execution\":" << execution << ",\"cpu_time_ms\":" << profile.cpu_time << ",\"peak_rss_delta_kb\":" << profile.peak_rss_delta;
+      trace << ",\"trigger\":\"" << JsonEscape(profile.trigger) << "\",\"trigger_kind\":\"" << (profile.trigger.empty() ? "none" : (profile.invalidation ? "invalidation" : "dependence")) << "\"}}";
+   }
+   trace << "\n]}\n";
+   trace.close();
+
+   /// The summary of a step
+   struct StepSummary
+   {
+      size_t executions;
+      size_t reexecutions;
+      size_t successes;
+      size_t unchanged;
+      size_t aborted;
+      long long wall_time;
+      long cpu_time;
+      long peak_rss_delta;
+      std::string last_trigger;
+   };
+   std::vector<std::string> order;
+   CustomUnorderedMap<std::string, StepSummary> summaries;
+   for(const auto& profile : execution_profiles)
+   {
+      if(summaries.find(profile.name) == summaries.end())
+      {
+         order.push_back(profile.name);
+         summaries[profile.name] = StepSummary();
+      }
+      auto& summary = summaries.find(profile.name)->second;
+      summary.executions++;
+      if(profile.invalidation)
+      {
+         summary.reexecutions++;
+      }
+      if(profile.status == DesignFlowStep_Status::SUCCESS)
+      {
+         summary.successes++;
+      }
+      else if(profile.status == DesignFlowStep_Status::UNCHANGED)
+      {
+         summary.unchanged++;
+      }
+      else if(profile.status == DesignFlowStep_Status::ABORTED)
+      {
+         summary.aborted++;
+      }
+      summary.wall_time += profile.wall_time;
+      summary.cpu_time += profile.cpu_time;
+      summary.peak_rss_delta += profile.peak_rss_delta;
+      summary.last_trigger = profile.trigger;
+   }
+   /// Invalidations are counted on vertices, while executions on names
+   CustomUnorderedMap<std::string, size_t> invalidations;
+   for(const auto& invalidation : invalidations_number)
+   {
+      invalidations[design_flow_graph->CGetDesignFlowStepInfo(invalidation.first)->design_flow_step->GetName()] += invalidation.second;
+   }
+   std::ofstream summary_file(profile_prefix + ".csv");
+   if(not summary_file)
+   {
+      THROW_ERROR("Cannot open " + profile_prefix + ".csv");
+   }
+   summary_file << "step,executions,reexecutions,invalidations,successes,unchanged,aborted,wall_time_us,cpu_time_ms,peak_rss_delta_kb,last_trigger\n";
+   for(const auto& name : order)
+   {
+      const auto& summary = summaries.find(name)->second;
+      summary_file << CsvEscape(name) << "," << summary.executions << "," << summary.reexecutions << "," << (invalidations.find(name) != invalidations.end() ? invalidations.find(name)->second : 0) << "," << summary.successes << "," << summary.unchanged << ","
+                   << summary.aborted << "," << summary.wall_time << "," << summary.cpu_time << "," << summary.peak_rss_delta << "," << CsvEscape(summary.last_trigger) << "\n";
+   }
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Written profile of design flow");
+}
+
 DesignFlowStep_Status DesignFlowManager::GetStatus(const std::string& signature) const
 {
    const vertex step = GetDesignFlowStep(signature);
@@ -46,10 +46,13 @@
 #include "custom_map.hpp"
 #include "graph.hpp"    // for vertex, Paramete...
 #include "refcount.hpp" // for REF_FORWARD_DECL
+#include <chrono>       // for steady_clock
 #include <cstddef>      // for size_t
 #include <functional>   // for binary_function
 #include <set>          // for set
 #include <string>       // for string
+#include <utility>      // for pair
+#include <vector>       // for vector
 
 class DesignFlowStepSet;
 CONSTREF_FORWARD_DECL(DesignFlowGraph);
@@ -109,6 +112,9 @@ class DesignFlowManager
    /// The set of potentially ready steps; when a step is added to set is ready to be executed, but it can become unready because of new added vertices
    std::set<vertex, DesignFlowStepNecessitySorter> possibly_ready;
 
+   /// The steps executed by the last parallel batch whose invalidations and successors have not yet been processed: the value is the pair status - execution time
+   CustomMap<vertex, std::pair<DesignFlowStep_Status, long>> parallel_executions;
+
    /// The registered factories
    CustomUnorderedMap<std::string, DesignFlowStepFactoryConstRef> design_flow_step_factories;
 
@@ -142,6 +148,55 @@ class DesignFlowManager
    CustomMap<vertex, size_t> skipped_executions;
 #endif
 
+   /// The information collected about a single execution of a step when profiling is enabled
+   struct StepExecutionProfile
+   {
+      /// The name of the executed step
+      std::string name;
+
+      /// The edge which made the step ready in the form "source -> target" (empty if the step was ready since its creation)
+      std::string trigger;
+
+      /// True if the step has been made ready by an invalidation
+      bool invalidation;
+
+      /// The status returned by the step
+      DesignFlowStep_Status status;
+
+      /// The starting time in microseconds since the creation of the manager
+      long long start;
+
+      /// The wall time in microseconds
+      long long wall_time;
+
+      /// The cpu time in milliseconds
+      long cpu_time;
+
+      /// The increase of the peak resident set size in KB; for steps executed in parallel it refers to the whole batch
+      long peak_rss_delta;
+
+      /// The thread which executed the step
+      int thread;
+   };
+
+   /// The prefix of the files where profiling information is written; profiling is disabled if empty
+   const std::string profile_prefix;
+
+   /// The time origin of the profiling information
+   const std::chrono::steady_clock::time_point profile_origin;
+
+   /// The profile of each execution of a step, in commit order
+   std::vector<StepExecutionProfile> execution_profiles;
+
+   /// The profiles of the steps in parallel_executions
+   CustomMap<vertex, StepExecutionProfile> parallel_profiles;
+
+   /// For each step which is going to be executed, the source of the edge which made it ready and if the edge is an invalidation
+   CustomUnorderedMap<vertex, std::pair<vertex, bool>> triggers;
+
+   /// The number of times each step has been invalidated after its execution
+   CustomUnorderedMap<vertex, size_t> invalidations_number;
+
    /// The set of input parameters
    const ParameterConstRef parameters;
 
@@ -151,6 +206,12 @@ class DesignFlowManager
    /// The debug level
    int debug_level;
 
+   /// The maximum number of steps which can be executed concurrently
+   const size_t jobs;
+
+   /// The directory of the persistent step cache; the cache is disabled if empty
+   const std::string step_cache_directory;
+
    /**
     * Recursively add steps and corresponding dependencies to the design flow
     * @param steps is the set of steps to be added
@@ -162,8 +223,49 @@ class DesignFlowManager
     * Recursively remove executed flag starting from a vertex
     * @param starting_vertex is the starting vertex
     * @param force_execution specifies if a skipped vertex has to be changed into a unexecuted
+    * @param source is the step whose execution (or invalidation) caused the invalidation of starting_vertex
+    */
+   void DeExecute(const vertex starting_vertex, bool force_execution, const vertex source);
+
+   /**
+    * Add the dependencies and the precedences of a step which have been created after its insertion and check if it is ready
+    * @param step_vertex is the vertex of the step
+    * @return true if all the steps which the step depends on have been executed
+    */
+   bool UpdateReadiness(const vertex step_vertex);
+
+   /**
+    * Execute concurrently a step and the other parallelizable steps which are ready; their statuses are set at once and the steps are
+    * stored in parallel_executions, so that the main loop processes them before any other step
+    * @param next is the step selected for the current iteration
+    */
+   void ExecuteParallelSteps(const vertex next);
+
+   /**
+    * Execute a step, unless its result can be restored from the persistent step cache; a newly computed result is stored in the cache
+    * together with the full key of the step, which is compared with the one of the step before a stored result is restored
+    * @param step is the step to be executed
+    * @return the status of the step
+    */
+   DesignFlowStep_Status ExecuteCachedStep(const DesignFlowStepRef& step) const;
+
+   /**
+    * Return the time elapsed since the creation of the manager
+    * @return the elapsed time in microseconds
+    */
+   long long GetProfileTime() const;
+
+   /**
+    * Store the profile of an execution of a step
+    * @param step_vertex is the executed step
+    * @param profile is the profile of the execution; name and trigger are filled by this method
+    */
+   void RecordExecution(const vertex step_vertex, StepExecutionProfile profile);
+
+   /**
+    * Write the collected profiles as Chrome trace events (<prefix>.json) and as a summary for each step (<prefix>.csv)
     */
-   void DeExecute(const vertex starting_vertex, bool force_execution);
+   void WriteProfile() const;
 
    /**
     * Connect source and sink vertices to entry and exit
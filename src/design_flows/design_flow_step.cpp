@@ -63,6 +63,30 @@ bool DesignFlowStep::IsComposed() const
    return composed;
 }
 
+bool DesignFlowStep::IsParallelizable() const
+{
+   return false;
+}
+
+std::string DesignFlowStep::GetParallelGroup() const
+{
+   return GetSignature();
+}
+
+std::string DesignFlowStep::ComputeCacheKey() const
+{
+   return "";
+}
+
+bool DesignFlowStep::LoadCachedResult(const std::string&)
+{
+   return false;
+}
+
+void DesignFlowStep::StoreCachedResult(const std::string&) const
+{
+}
+
 void DesignFlowStep::Initialize()
 {
 }
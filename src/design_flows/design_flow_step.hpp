@@ -162,6 +162,39 @@ class DesignFlowStep
     */
    virtual bool HasToBeExecuted() const = 0;
 
+   /**
+    * Check if Exec of this step can be executed concurrently with Exec of other parallelizable steps
+    * Note that Initialize, PrintInitialIR and PrintFinalIR are always serially executed
+    * @return true if the step does not modify data structures shared with other steps
+    */
+   virtual bool IsParallelizable() const;
+
+   /**
+    * Return the group of this step: parallelizable steps belonging to the same group are never executed concurrently
+    * @return the group of this step; by default each step has its own group
+    */
+   virtual std::string GetParallelGroup() const;
+
+   /**
+    * Compute the key of the result of this step in the persistent step cache
+    * The key must identify the step, the content of all its inputs and the options it depends on, so that executions with the same key produce the same result
+    * @return the key; if empty the result of this step is never cached
+    */
+   virtual std::string ComputeCacheKey() const;
+
+   /**
+    * Restore the result of this step from the persistent step cache instead of executing it
+    * @param cache_file is the file storing the result
+    * @return true if the result has been restored, false if the step has to be executed
+    */
+   virtual bool LoadCachedResult(const std::string& cache_file);
+
+   /**
+    * Store the result of the last execution of this step in the persistent step cache
+    * @param cache_file is the file where the result has to be written
+    */
+   virtual void StoreCachedResult(const std::string& cache_file) const;
+
    /**
     * Initialize the step (i.e., like a constructor, but executed just before exec
     */
@@ -45,6 +45,9 @@
 /// Header include
 #include "load_default_technology.hpp"
 
+///. include
+#include "Parameter.hpp"
+
 /// parser/polixml include
 #include "xml_dom_parser.hpp"
 
@@ -122,7 +125,7 @@ DesignFlowStep_Status LoadDefaultTechnology::Exec()
       for(i = 0; i < sizeof(builtin_resources_data) / sizeof(char*); ++i)
       {
          XMLDomParser parser("builtin_resource_data[" + STR(i) + "]", builtin_resources_data[i]);
-         parser.Exec();
+         parser.Exec(parameters->getOption<std::string>(OPT_technology_cache_directory));
          if(parser)
          {
             // Walk the tree:
@@ -104,7 +104,7 @@ DesignFlowStep_Status LoadDeviceTechnology::Exec()
       try
       {
          XMLDomParser parser(fn);
-         parser.Exec();
+         parser.Exec(parameters->getOption<std::string>(OPT_technology_cache_directory));
          if(parser)
          {
             target->xload(target, parser.get_document()->get_root_node());
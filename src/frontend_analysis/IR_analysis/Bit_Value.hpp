@@ -161,7 +161,7 @@ class Bit_Value : public FunctionFrontendFlowStep, public BitLatticeManipulator
    /**
     * Applies the forward algorithm, as described in the paper, analyzing each assignment statement following the program order, and each phi.
     * Uses the forward_transfer() function to compute the output's bitstring, that stores in current.
-    * The algorithm loops until current is modified.
+    * The algorithm loops until current is modified; in each iteration only the statements whose inputs changed since their last evaluation are analyzed again.
     * @see forward_transfer()
     */
    void forward();
@@ -169,7 +169,7 @@ class Bit_Value : public FunctionFrontendFlowStep, public BitLatticeManipulator
    /**
     * Applies the backward algorithm, as described in the paper, analyzing each assignment statement starting from the output, going up to the inputs, and each phi.
     * Uses the backward_transfer() function to compute the output's bitstring, that stores in current.
-    * The algorithm loops until current is modified.
+    * The algorithm loops until current is modified; in each iteration only the variables whose uses involve a changed variable are analyzed again.
     * @see backward_transfer()
     */
    void backward();
@@ -53,8 +53,10 @@
 
 // include boost range adaptors
 #include "dbgPrintHelper.hpp" // for DEBUG_LEVEL_
+#include "custom_set.hpp"
 #include "string_manipulation.hpp"
 #include <boost/range/adaptors.hpp>
+#include <deque>
 
 std::deque<bit_lattice> Bit_Value::backward_compute_result_from_uses(const ssa_name& ssa, const statement_list& sl, unsigned int bb_loop_id) const
 {
@@ -207,88 +209,96 @@ void Bit_Value::backward()
    THROW_ASSERT(fd && fd->body, "Node is not a function or it hasn't a body");
    const auto* sl = GetPointer<const statement_list>(GET_NODE(fd->body));
 
-   bool current_updated = true;
-
-   while(current_updated)
+   /// A variable is analyzed again only when a variable involved in its uses is updated: the def-use chains drive a worklist seeded with all the variables
+   CustomUnorderedMap<unsigned int, std::pair<const ssa_name*, unsigned int>> analyzed_vars;
+   std::deque<unsigned int> worklist;
+   CustomUnorderedSet<unsigned int> in_worklist;
+   const auto push = [&](const unsigned int var_uid) {
+      if(analyzed_vars.find(var_uid) != analyzed_vars.end() and in_worklist.insert(var_uid).second)
+         worklist.push_back(var_uid);
+   };
+   CustomUnorderedMap<unsigned int, std::vector<unsigned int>> stmt_ssa_uses;
+   const auto push_ssa_uses = [&](const tree_nodeRef& stmt) {
+      auto ssa_uses = stmt_ssa_uses.find(stmt->index);
+      if(ssa_uses == stmt_ssa_uses.end())
+      {
+         std::vector<unsigned int> vars;
+         for(const auto& ssa_use : tree_helper::ComputeSsaUses(stmt))
+            vars.push_back(ssa_use.first->index);
+         ssa_uses = stmt_ssa_uses.insert(std::make_pair(stmt->index, std::move(vars))).first;
+      }
+      for(const auto var : ssa_uses->second)
+         push(var);
+   };
+   const auto mark_updated = [&](const ssa_name* ssa) {
+      /// the variable itself, the operands of its definition and the other operands of its uses
+      push(ssa->index);
+      push_ssa_uses(ssa->CGetDefStmt());
+      for(const auto& use_stmt : ssa->CGetUseStmts())
+         push_ssa_uses(use_stmt.first);
+   };
+   // for each basic block B in CFG do > Consider all blocks successively
+   for(const auto& B_it : sl->list_of_bloc)
    {
-      current_updated = false;
-      // for each basic block B in CFG do > Consider all blocks successively
-      for(const auto& B_it : sl->list_of_bloc)
+      blocRef B = B_it.second;
+      for(const auto& stmt : boost::adaptors::reverse(B->CGetStmtList()))
       {
-         blocRef B = B_it.second;
-         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Analyzing BB" + STR(B->number));
-         for(const auto& stmt : boost::adaptors::reverse(B->CGetStmtList()))
+         const auto* ga = GetPointer<const gimple_assign>(GET_NODE(stmt));
+         const auto* ssa = ga ? GetPointer<const ssa_name>(GET_NODE(ga->op0)) : nullptr;
+         if(ssa)
          {
-            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Analyzing statement " + STR(stmt));
-            const tree_nodeRef s = GET_NODE(stmt);
-            const auto stmt_kind = s->get_kind();
-            if(stmt_kind == gimple_assign_K)
+            if(not is_handled_by_bitvalue(ssa->index))
             {
-               auto* ga = GetPointer<gimple_assign>(s);
-               unsigned int output_uid = GET_INDEX_NODE(ga->op0);
-               auto* ssa = GetPointer<ssa_name>(GET_NODE(ga->op0));
-
-               if(ssa)
-               {
-                  if(not is_handled_by_bitvalue(output_uid))
-                  {
-                     INDENT_DBG_MEX(DEBUG_LEVEL_PEDANTIC, debug_level, "<--variable " + STR(ssa) + " of type " + STR(tree_helper::CGetType(GET_NODE(ga->op0))) + " not considered id: " + STR(output_uid));
-                     continue;
-                  }
-
-                  THROW_ASSERT(best.find(output_uid) != best.end(), "unexpected condition");
-                  if(current.find(output_uid) == current.end())
-                  {
-                     current[output_uid] = best.at(output_uid);
-                  }
-
-                  if(bitstring_constant(current[output_uid]))
-                  {
-                     INDENT_DBG_MEX(DEBUG_LEVEL_PEDANTIC, debug_level, "<--variable has been proven to be constant: " + STR(output_uid));
-                     continue;
-                  }
-                  std::deque<bit_lattice> res = backward_compute_result_from_uses(*ssa, *sl, B->loop_id);
-                  current_updated = update_current(std::move(res), output_uid) or current_updated;
-               }
+               INDENT_DBG_MEX(DEBUG_LEVEL_PEDANTIC, debug_level, "---variable " + STR(ssa) + " of type " + STR(tree_helper::CGetType(GET_NODE(ga->op0))) + " not considered id: " + STR(ssa->index));
+               continue;
             }
-            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Analyzed statement " + STR(stmt));
+            analyzed_vars[ssa->index] = std::make_pair(ssa, B->loop_id);
+            push(ssa->index);
          }
-
-         for(const auto& stmt : boost::adaptors::reverse(B->CGetPhiList()))
+      }
+      for(const auto& stmt : boost::adaptors::reverse(B->CGetPhiList()))
+      {
+         const auto* gp = GetPointer<const gimple_phi>(GET_NODE(stmt));
+         if(not gp->virtual_flag)
          {
-            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Analyzing Phi " + STR(stmt));
-            auto* gp = GetPointer<gimple_phi>(GET_NODE(stmt));
-            bool is_virtual = gp->virtual_flag;
-
-            if(!is_virtual)
+            const auto* ssa = GetPointer<const ssa_name>(GET_NODE(gp->res));
+            if(not is_handled_by_bitvalue(ssa->index))
             {
-               unsigned int output_uid = GET_INDEX_NODE(gp->res);
-               auto* ssa = GetPointer<ssa_name>(GET_NODE(gp->res));
-               if(not is_handled_by_bitvalue(output_uid))
-               {
-                  INDENT_DBG_MEX(DEBUG_LEVEL_PEDANTIC, debug_level, "<--variable " + STR(ssa) + " of type " + STR(tree_helper::CGetType(GET_NODE(gp->res))) + " not considered id: " + STR(output_uid));
-                  continue;
-               }
-
-               THROW_ASSERT(best.find(output_uid) != best.end(), "unexpected condition");
-               if(current.find(output_uid) == current.end())
-               {
-                  current[output_uid] = best.at(output_uid);
-               }
-
-               if(bitstring_constant(current[output_uid]))
-               {
-                  INDENT_DBG_MEX(DEBUG_LEVEL_PEDANTIC, debug_level, "<--variable has been proven to be constant: " + STR(output_uid));
-                  continue;
-               }
-               std::deque<bit_lattice> res = backward_compute_result_from_uses(*ssa, *sl, B->loop_id);
-               current_updated = update_current(std::move(res), output_uid) or current_updated;
+               INDENT_DBG_MEX(DEBUG_LEVEL_PEDANTIC, debug_level, "---variable " + STR(ssa) + " of type " + STR(tree_helper::CGetType(GET_NODE(gp->res))) + " not considered id: " + STR(ssa->index));
+               continue;
             }
-            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Analyzed Phi " + STR(stmt));
+            analyzed_vars[ssa->index] = std::make_pair(ssa, B->loop_id);
+            push(ssa->index);
          }
-         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Analyzed BB" + STR(B->number));
       }
    }
+
+   while(not worklist.empty())
+   {
+      const auto output_uid = worklist.front();
+      worklist.pop_front();
+      in_worklist.erase(output_uid);
+      const auto* ssa = analyzed_vars.at(output_uid).first;
+      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Analyzing " + STR(ssa));
+      THROW_ASSERT(best.find(output_uid) != best.end(), "unexpected condition");
+      if(current.find(output_uid) == current.end())
+      {
+         current[output_uid] = best.at(output_uid);
+         mark_updated(ssa);
+      }
+
+      if(bitstring_constant(current[output_uid]))
+      {
+         INDENT_DBG_MEX(DEBUG_LEVEL_PEDANTIC, debug_level, "<--variable has been proven to be constant: " + STR(output_uid));
+         continue;
+      }
+      std::deque<bit_lattice> res = backward_compute_result_from_uses(*ssa, *sl, analyzed_vars.at(output_uid).second);
+      if(update_current(std::move(res), output_uid))
+      {
+         mark_updated(ssa);
+      }
+      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Analyzed " + STR(ssa));
+   }
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Performed backward transfer");
 }
 
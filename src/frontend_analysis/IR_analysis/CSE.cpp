@@ -153,6 +153,11 @@ const CustomUnorderedSet<std::pair<FrontendFlowStepType, FrontendFlowStep::Funct
    return relationships;
 }
 
+bool CSE::IsFunctionLocal() const
+{
+   return true;
+}
+
 bool CSE::check_loads(const gimple_assign* ga, unsigned int right_part_index, tree_nodeRef right_part)
 {
    const CustomOrderedSet<unsigned int>& fun_mem_data = function_behavior->get_function_mem();
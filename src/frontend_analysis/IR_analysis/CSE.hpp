@@ -103,6 +103,11 @@ class CSE : public FunctionFrontendFlowStep
 
    const CustomUnorderedSet<std::pair<FrontendFlowStepType, FunctionRelationship>> ComputeFrontendRelationships(const DesignFlowStep::RelationshipType relationship_type) const override;
 
+   /**
+    * Check if InternalExec only modifies the intermediate representation of the analyzed function
+    */
+   bool IsFunctionLocal() const override;
+
    /// define the type of the unique table key
    typedef std::pair<enum kind, std::vector<unsigned int>> CSE_tuple_key_type;
 
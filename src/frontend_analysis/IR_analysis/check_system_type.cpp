@@ -290,7 +290,7 @@ void CheckSystemType::recursive_examinate(const tree_nodeRef& curr_tn, const uns
             {
                auto* in = GetPointer<identifier_node>(GET_NODE(fd->name));
 #if HAVE_LEON3
-               if(not_supported_leon3_functions.find(in->strg) != not_supported_leon3_functions.end())
+               if(not_supported_leon3_functions.find(in->strg.str()) != not_supported_leon3_functions.end())
                {
                   if(parameters->getOption<bool>(OPT_without_operating_system))
                   {
@@ -298,8 +298,8 @@ void CheckSystemType::recursive_examinate(const tree_nodeRef& curr_tn, const uns
                   }
                }
 #endif
-               if(rename_function.find(in->strg) != rename_function.end())
-                  in->strg = rename_function.find(in->strg)->second;
+               if(rename_function.find(in->strg.str()) != rename_function.end())
+                  in->strg = rename_function.find(in->strg.str())->second;
             }
          }
          // Checking for type
@@ -165,7 +165,7 @@ DesignFlowStep_Status constant_flop_wrapper::InternalExec()
          const identifier_node* in = GetPointer<identifier_node>(i);
 
          // the following three lines check if the functions written by this class are being analyzed multiple times (to avoid infinite loop)
-         bool function_already_scanned = operations.find(in->strg) != operations.end();
+         bool function_already_scanned = operations.find(in->strg.str()) != operations.end();
          if(function_already_scanned)
          {
             THROW_ASSERT(function_already_scanned, "Inconsistent behaviour: the same function is being analyzed multiple times.");
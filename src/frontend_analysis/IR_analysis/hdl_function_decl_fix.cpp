@@ -98,7 +98,7 @@ DesignFlowStep_Status HDLFunctionDeclFix::Exec()
       if(not fd->name)
          continue;
       auto in = GetPointer<identifier_node>(GET_NODE(fd->name));
-      const auto identifier = hdl_writer_type == HDLWriter_Language::VHDL ? boost::to_upper_copy<std::string>(in->strg) : in->strg;
+      const auto identifier = hdl_writer_type == HDLWriter_Language::VHDL ? boost::to_upper_copy<std::string>(in->strg) : in->strg.str();
       if(found_names.find(identifier) != found_names.end())
       {
          std::map<TreeVocabularyTokenTypes_TokenEnum, std::string> IR_schema;
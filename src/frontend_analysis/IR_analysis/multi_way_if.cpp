@@ -141,6 +141,11 @@ const CustomUnorderedSet<std::pair<FrontendFlowStepType, FrontendFlowStep::Funct
    return relationships;
 }
 
+bool multi_way_if::IsFunctionLocal() const
+{
+   return true;
+}
+
 void multi_way_if::Initialize()
 {
    bb_modified = false;
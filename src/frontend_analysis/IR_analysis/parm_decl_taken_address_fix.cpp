@@ -125,7 +125,7 @@ DesignFlowStep_Status parm_decl_taken_address_fix::InternalExec()
       THROW_ASSERT(pd, "unexpected condition");
       const tree_nodeRef p_type = pd->type;
       const std::string srcp = pd->include_name + ":" + STR(pd->line_number) + ":" + STR(pd->column_number);
-      const std::string original_param_name = pd->name ? GetPointer<const identifier_node>(GET_NODE(pd->name))->strg : STR(par_index);
+      const std::string original_param_name = pd->name ? GetPointer<const identifier_node>(GET_NODE(pd->name))->strg.str() : STR(par_index);
       const std::string local_var_name = "bambu_artificial_local_parameter_copy_" + original_param_name;
       const auto local_var_identifier = IRman->create_identifier_node(local_var_name);
       const auto new_local_var_decl = IRman->create_var_decl(local_var_identifier, p_type, pd->scpe, pd->size, tree_nodeRef(), tree_nodeRef(), srcp, GetPointer<const type_node>(GET_NODE(p_type))->algn, pd->used);
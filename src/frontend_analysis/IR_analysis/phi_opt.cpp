@@ -175,6 +175,11 @@ const CustomUnorderedSet<std::pair<FrontendFlowStepType, FunctionFrontendFlowSte
    return relationships;
 }
 
+bool PhiOpt::IsFunctionLocal() const
+{
+   return true;
+}
+
 DesignFlowStep_Status PhiOpt::InternalExec()
 {
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Merging phis");
@@ -189,6 +189,11 @@ class PhiOpt : public FunctionFrontendFlowStep
     */
    const CustomUnorderedSet<std::pair<FrontendFlowStepType, FunctionRelationship>> ComputeFrontendRelationships(const DesignFlowStep::RelationshipType relationship_type) const override;
 
+   /**
+    * Check if InternalExec only modifies the intermediate representation of the analyzed function
+    */
+   bool IsFunctionLocal() const override;
+
  public:
    /**
     * Constructor.
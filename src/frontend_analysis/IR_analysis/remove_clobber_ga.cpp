@@ -98,6 +98,11 @@ const CustomUnorderedSet<std::pair<FrontendFlowStepType, FunctionFrontendFlowSte
    return relationships;
 }
 
+bool remove_clobber_ga::IsFunctionLocal() const
+{
+   return true;
+}
+
 DesignFlowStep_Status remove_clobber_ga::InternalExec()
 {
    const tree_managerRef TM = AppM->get_tree_manager();
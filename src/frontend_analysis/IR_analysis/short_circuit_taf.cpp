@@ -169,6 +169,11 @@ const CustomUnorderedSet<std::pair<FrontendFlowStepType, FrontendFlowStep::Funct
    return relationships;
 }
 
+bool short_circuit_taf::IsFunctionLocal() const
+{
+   return true;
+}
+
 void short_circuit_taf::Initialize()
 {
 }
@@ -92,6 +92,11 @@ class short_circuit_taf : public FunctionFrontendFlowStep
     */
    const CustomUnorderedSet<std::pair<FrontendFlowStepType, FunctionRelationship>> ComputeFrontendRelationships(const DesignFlowStep::RelationshipType relationship_type) const override;
 
+   /**
+    * Check if InternalExec only modifies the intermediate representation of the analyzed function
+    */
+   bool IsFunctionLocal() const override;
+
    /**
     * @brief check if phi could create problem to the short circuit collapsing
     * @param curr_bb is the basic block that merge the two or more flows
@@ -76,7 +76,9 @@
 
 /// utility include
 #include "dbgPrintHelper.hpp"      // for DEBUG_LEVEL_
+#include "exceptions.hpp"          // for exit_code
 #include "string_manipulation.hpp" // for GET_CLASS
+#include <algorithm>               // for find_if
 #include <boost/algorithm/string/replace.hpp>
 std::string ToString(Transformation transformation)
 {
@@ -1313,138 +1315,158 @@ DesignFlowStep_Status Vectorize::InternalExec()
    /// Classify loop
    ClassifyLoop(function_behavior->GetLoops()->GetLoop(0), 0);
 
-   /// Add the guards
-   AddGuards();
-#ifndef NDEBUG
-   if(debug_level > DEBUG_LEVEL_VERY_PEDANTIC)
+   /// Save the intermediate representation, so that the function is left scalar when the loops contain a pattern which cannot be vectorized
+   const auto simd_loop = std::find_if(simd_loop_type.begin(), simd_loop_type.end(), [](const std::pair<const unsigned int, SimdLoop>& loop) { return loop.second != SIMD_NONE; });
+   const auto tree_manager_snapshot = simd_loop != simd_loop_type.end() ? TM->CreateSnapshot() : TreeManagerSnapshotConstRef();
+   const auto function_behavior_snapshot = simd_loop != simd_loop_type.end() ? function_behavior->CreateSnapshot() : FunctionBehaviorSnapshotConstRef();
+   const auto previous_exit_code = exit_code;
+   try
    {
-      WriteBBGraphDot("BB_Inside_" + GetName() + "_Guards.dot");
-   }
+      /// Add the guards
+      AddGuards();
+#ifndef NDEBUG
+      if(debug_level > DEBUG_LEVEL_VERY_PEDANTIC)
+      {
+         WriteBBGraphDot("BB_Inside_" + GetName() + "_Guards.dot");
+      }
 #endif
 
-   /// Fix the phi
-   FixPhis();
+      /// Fix the phi
+      FixPhis();
 #ifndef NDEBUG
-   if(debug_level > DEBUG_LEVEL_VERY_PEDANTIC)
-   {
-      WriteBBGraphDot("BB_Inside_" + GetName() + "_FixPhis.dot");
-   }
+      if(debug_level > DEBUG_LEVEL_VERY_PEDANTIC)
+      {
+         WriteBBGraphDot("BB_Inside_" + GetName() + "_FixPhis.dot");
+      }
 #endif
-   /// Predicate instructions which cannot be speculated
-   SetPredication();
+      /// Predicate instructions which cannot be speculated
+      SetPredication();
 #ifndef NDEBUG
-   if(debug_level > DEBUG_LEVEL_VERY_PEDANTIC)
-   {
-      WriteBBGraphDot("BB_Inside_" + GetName() + "_Predicated.dot");
-   }
+      if(debug_level > DEBUG_LEVEL_VERY_PEDANTIC)
+      {
+         WriteBBGraphDot("BB_Inside_" + GetName() + "_Predicated.dot");
+      }
 #endif
 
-   /// Classify statement
-   const BBGraphRef bb_graph = function_behavior->GetBBGraph(FunctionBehavior::BB);
-   VertexIterator bb, bb_end;
-   for(boost::tie(bb, bb_end) = boost::vertices(*bb_graph); bb != bb_end; bb++)
-   {
-      const BBNodeInfoConstRef bb_node_info = bb_graph->CGetBBNodeInfo(*bb);
-      if(simd_loop_type[bb_node_info->loop_id] != SIMD_NONE)
+      /// Classify statement
+      const BBGraphRef bb_graph = function_behavior->GetBBGraph(FunctionBehavior::BB);
+      VertexIterator bb, bb_end;
+      for(boost::tie(bb, bb_end) = boost::vertices(*bb_graph); bb != bb_end; bb++)
       {
-         const blocRef block = bb_node_info->block;
-         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Classifying statement of BB" + STR(block->number));
-         for(const auto& statement : block->CGetStmtList())
-         {
-            ClassifyTreeNode(bb_node_info->loop_id, GET_CONST_NODE(statement));
-         }
-         for(const auto& phi : block->CGetPhiList())
+         const BBNodeInfoConstRef bb_node_info = bb_graph->CGetBBNodeInfo(*bb);
+         if(simd_loop_type[bb_node_info->loop_id] != SIMD_NONE)
          {
-            ClassifyTreeNode(bb_node_info->loop_id, GET_CONST_NODE(phi));
+            const blocRef block = bb_node_info->block;
+            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Classifying statement of BB" + STR(block->number));
+            for(const auto& statement : block->CGetStmtList())
+            {
+               ClassifyTreeNode(bb_node_info->loop_id, GET_CONST_NODE(statement));
+            }
+            for(const auto& phi : block->CGetPhiList())
+            {
+               ClassifyTreeNode(bb_node_info->loop_id, GET_CONST_NODE(phi));
+            }
+            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Classified statement of BB" + STR(block->number));
          }
-         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Classified statement of BB" + STR(block->number));
       }
-   }
 
-   /// Duplicate the increment operation when necessary
-   for(boost::tie(bb, bb_end) = boost::vertices(*bb_graph); bb != bb_end; bb++)
-   {
-      const BBNodeInfoConstRef bb_node_info = bb_graph->CGetBBNodeInfo(*bb);
-      if(simd_loop_type[bb_node_info->loop_id] != SIMD_NONE)
+      /// Duplicate the increment operation when necessary
+      for(boost::tie(bb, bb_end) = boost::vertices(*bb_graph); bb != bb_end; bb++)
       {
-         const blocRef block = bb_node_info->block;
-         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Transforming increment statement of BB" + STR(block->number));
-         for(const auto& statement : block->CGetStmtList())
+         const BBNodeInfoConstRef bb_node_info = bb_graph->CGetBBNodeInfo(*bb);
+         if(simd_loop_type[bb_node_info->loop_id] != SIMD_NONE)
          {
-            if(transformations.find(statement->index)->second == INC)
+            const blocRef block = bb_node_info->block;
+            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Transforming increment statement of BB" + STR(block->number));
+            for(const auto& statement : block->CGetStmtList())
             {
-               if(debug_level >= DEBUG_LEVEL_VERY_PEDANTIC)
+               if(transformations.find(statement->index)->second == INC)
                {
-                  const std::string file_name = parameters->getOption<std::string>(OPT_output_temporary_directory) + "before_" + STR(statement->index) + "_expansion.gimple";
-                  std::ofstream gimple_file(file_name.c_str());
-                  TM->PrintGimple(gimple_file, false);
-                  gimple_file.close();
-               }
-               const auto new_statement = DuplicateIncrement(bb_node_info->loop_id, GET_NODE(statement));
-               block->PushBefore(TM->GetTreeReindex(new_statement), statement);
-               ClassifyTreeNode(bb_node_info->loop_id, TM->get_tree_node_const(new_statement));
-               transformations[new_statement] = INC;
-               if(debug_level >= DEBUG_LEVEL_VERY_PEDANTIC)
-               {
-                  const std::string file_name = parameters->getOption<std::string>(OPT_output_temporary_directory) + "after_" + STR(statement->index) + "_expansion.gimple";
-                  std::ofstream gimple_file(file_name.c_str());
-                  TM->PrintGimple(gimple_file, false);
-                  gimple_file.close();
+                  if(debug_level >= DEBUG_LEVEL_VERY_PEDANTIC)
+                  {
+                     const std::string file_name = parameters->getOption<std::string>(OPT_output_temporary_directory) + "before_" + STR(statement->index) + "_expansion.gimple";
+                     std::ofstream gimple_file(file_name.c_str());
+                     TM->PrintGimple(gimple_file, false);
+                     gimple_file.close();
+                  }
+                  const auto new_statement = DuplicateIncrement(bb_node_info->loop_id, GET_NODE(statement));
+                  block->PushBefore(TM->GetTreeReindex(new_statement), statement);
+                  ClassifyTreeNode(bb_node_info->loop_id, TM->get_tree_node_const(new_statement));
+                  transformations[new_statement] = INC;
+                  if(debug_level >= DEBUG_LEVEL_VERY_PEDANTIC)
+                  {
+                     const std::string file_name = parameters->getOption<std::string>(OPT_output_temporary_directory) + "after_" + STR(statement->index) + "_expansion.gimple";
+                     std::ofstream gimple_file(file_name.c_str());
+                     TM->PrintGimple(gimple_file, false);
+                     gimple_file.close();
+                  }
                }
             }
+            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Transformed increment statement of BB" + STR(block->number));
          }
-         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Transformed increment statement of BB" + STR(block->number));
       }
-   }
 #ifndef NDEBUG
-   if(debug_level > DEBUG_LEVEL_VERY_PEDANTIC)
-   {
-      WriteBBGraphDot("BB_Inside_" + GetName() + "_Duplicated.dot");
-   }
+      if(debug_level > DEBUG_LEVEL_VERY_PEDANTIC)
+      {
+         WriteBBGraphDot("BB_Inside_" + GetName() + "_Duplicated.dot");
+      }
 #endif
 
-   /// Perform the transformation
-   for(boost::tie(bb, bb_end) = boost::vertices(*bb_graph); bb != bb_end; bb++)
-   {
-      const BBNodeInfoConstRef bb_node_info = bb_graph->CGetBBNodeInfo(*bb);
-      if(simd_loop_type[bb_node_info->loop_id] != SIMD_NONE)
+      /// Perform the transformation
+      for(boost::tie(bb, bb_end) = boost::vertices(*bb_graph); bb != bb_end; bb++)
       {
-         const blocRef block = bb_node_info->block;
-         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Transforming statement of BB" + STR(block->number) + " - Loop " + STR(bb_node_info->loop_id) + " - Parallel degree " + STR(loop_parallel_degree[bb_node_info->loop_id]));
-         std::list<tree_nodeRef> new_statement_list;
-         std::vector<tree_nodeRef> new_phi_list;
-         for(const auto& statement : block->CGetStmtList())
-         {
-            TM->GetTreeReindex(Transform(statement->index, loop_parallel_degree[bb_node_info->loop_id], 0, new_statement_list, new_phi_list));
-         }
-         for(const auto& phi : block->CGetPhiList())
-         {
-            TM->GetTreeReindex(Transform(phi->index, loop_parallel_degree[bb_node_info->loop_id], 0, new_statement_list, new_phi_list));
-         }
-         /// Remove old statements
-         const auto& old_statement_list = block->CGetStmtList();
-         while(old_statement_list.size())
-            block->RemoveStmt(old_statement_list.front());
-         /// Remove old phis
-         const auto& old_phi_list = block->CGetPhiList();
-         while(old_phi_list.size())
-            block->RemovePhi(old_phi_list.front());
-         /// Add new statements
-         for(const auto& new_stmt : new_statement_list)
-         {
-            block->PushBack(new_stmt);
-         }
-         /// Add new phis
-         for(const auto& new_phi : new_phi_list)
+         const BBNodeInfoConstRef bb_node_info = bb_graph->CGetBBNodeInfo(*bb);
+         if(simd_loop_type[bb_node_info->loop_id] != SIMD_NONE)
          {
-            block->AddPhi(new_phi);
+            const blocRef block = bb_node_info->block;
+            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Transforming statement of BB" + STR(block->number) + " - Loop " + STR(bb_node_info->loop_id) + " - Parallel degree " + STR(loop_parallel_degree[bb_node_info->loop_id]));
+            std::list<tree_nodeRef> new_statement_list;
+            std::vector<tree_nodeRef> new_phi_list;
+            for(const auto& statement : block->CGetStmtList())
+            {
+               TM->GetTreeReindex(Transform(statement->index, loop_parallel_degree[bb_node_info->loop_id], 0, new_statement_list, new_phi_list));
+            }
+            for(const auto& phi : block->CGetPhiList())
+            {
+               TM->GetTreeReindex(Transform(phi->index, loop_parallel_degree[bb_node_info->loop_id], 0, new_statement_list, new_phi_list));
+            }
+            /// Remove old statements
+            const auto& old_statement_list = block->CGetStmtList();
+            while(old_statement_list.size())
+               block->RemoveStmt(old_statement_list.front());
+            /// Remove old phis
+            const auto& old_phi_list = block->CGetPhiList();
+            while(old_phi_list.size())
+               block->RemovePhi(old_phi_list.front());
+            /// Add new statements
+            for(const auto& new_stmt : new_statement_list)
+            {
+               block->PushBack(new_stmt);
+            }
+            /// Add new phis
+            for(const auto& new_phi : new_phi_list)
+            {
+               block->AddPhi(new_phi);
+            }
+            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Transformed statement of BB" + STR(block->number));
          }
-         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Transformed statement of BB" + STR(block->number));
       }
-   }
 
-   function_behavior->UpdateBBVersion();
-   return DesignFlowStep_Status::SUCCESS;
+      function_behavior->UpdateBBVersion();
+      return DesignFlowStep_Status::SUCCESS;
+   }
+   catch(const std::string& msg)
+   {
+      if(not tree_manager_snapshot)
+      {
+         throw;
+      }
+      INDENT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "---Loops of " + function_behavior->CGetBehavioralHelper()->get_function_name() + " are not vectorized: " + msg);
+      TM->RestoreSnapshot(tree_manager_snapshot);
+      function_behavior->RestoreSnapshot(function_behavior_snapshot);
+      exit_code = previous_exit_code;
+      return DesignFlowStep_Status::SUCCESS;
+   }
 }
 
 unsigned int Vectorize::Transform(const unsigned int tree_node_index, const size_t parallel_degree, const size_t scalar_index, std::list<tree_nodeRef>& new_stmt_list, std::vector<tree_nodeRef>& new_phi_list)
@@ -2523,7 +2545,7 @@ unsigned int Vectorize::Transform(const unsigned int tree_node_index, const size
                if(in->operator_flag)
                   tree_node_schema[TOK(TOK_OPERATOR)] = STR(in->operator_flag);
                else
-                  tree_node_schema[TOK(TOK_STRG)] = "vector_" + boost::replace_all_copy(in->strg, " ", "_");
+                  tree_node_schema[TOK(TOK_STRG)] = "vector_" + boost::replace_all_copy(in->strg.str(), " ", "_");
                unsigned int new_tree_node_id = TM->new_tree_node_id();
                TM->create_tree_node(new_tree_node_id, identifier_node_K, tree_node_schema);
                return_value = new_tree_node_id;
@@ -57,6 +57,7 @@
 
 /// graph includes
 #include "graph.hpp"
+#include "reachability_index.hpp"
 
 /// tree includes
 #include "tree_basic_block.hpp"
@@ -80,8 +81,8 @@ void BBReachabilityComputation::Initialize()
 {
    if(bb_version != 0 and bb_version != function_behavior->GetBBVersion())
    {
-      function_behavior->bb_reachability.clear();
-      function_behavior->feedback_bb_reachability.clear();
+      function_behavior->bb_reachability = ReachabilityIndexRef();
+      function_behavior->feedback_bb_reachability = ReachabilityIndexRef();
    }
 }
 
@@ -115,26 +116,12 @@ DesignFlowStep_Status BBReachabilityComputation::InternalExec()
    const BBGraphConstRef ecfg = function_behavior->CGetBBGraph(FunctionBehavior::EBB);
 
    /// The reachability among basic blocks
-   auto& bb_reachability = function_behavior->bb_reachability;
-   auto& feedback_bb_reachability = function_behavior->feedback_bb_reachability;
+   const ReachabilityIndexRef bb_reachability(new ReachabilityIndex(*ecfg));
+   function_behavior->bb_reachability = bb_reachability;
 
-   std::deque<vertex> container;
-   boost::topological_sort(*ecfg, std::back_inserter(container));
-   std::deque<vertex>::const_iterator it, it_end;
-   it_end = container.end();
-   for(it = container.begin(); it != it_end; ++it)
-   {
-      PRINT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "  Examining basic block " + boost::lexical_cast<std::string>(ecfg->CGetBBNodeInfo(*it)->block->number));
-      OutEdgeIterator eo, eo_end;
-      for(boost::tie(eo, eo_end) = boost::out_edges(*it, *ecfg); eo != eo_end; eo++)
-      {
-         vertex previous = boost::target(*eo, *ecfg);
-         bb_reachability[*it].insert(previous);
-         bb_reachability[*it].insert(bb_reachability[previous].begin(), bb_reachability[previous].end());
-      }
-   }
-
-   feedback_bb_reachability = bb_reachability;
+   /// The reachability with feedback is obtained by making all the blocks of a loop reachable from each other
+   const ReachabilityIndexRef feedback_bb_reachability(new ReachabilityIndex(*bb_reachability));
+   function_behavior->feedback_bb_reachability = feedback_bb_reachability;
 
    /// Get first level loops
    const LoopConstRef zero_loop = function_behavior->CGetLoops()->CGetLoop(0);
@@ -144,11 +131,7 @@ DesignFlowStep_Status BBReachabilityComputation::InternalExec()
    {
       CustomUnorderedSet<vertex> loop_blocks;
       (*first_level_loop)->get_recursively_bb(loop_blocks);
-      CustomUnorderedSet<vertex>::const_iterator loop_block, loop_block_end = loop_blocks.end();
-      for(loop_block = loop_blocks.begin(); loop_block != loop_block_end; ++loop_block)
-      {
-         feedback_bb_reachability[*loop_block].insert(loop_blocks.begin(), loop_blocks.end());
-      }
+      feedback_bb_reachability->AddReachability(loop_blocks, loop_blocks);
    }
    return DesignFlowStep_Status::SUCCESS;
 }
@@ -74,6 +74,7 @@
 #include <boost/lexical_cast.hpp>             // for lexical_cast
 #include <boost/tuple/tuple.hpp>              // for tie
 #include <iostream>                           // for ios_base::fai...
+#include <limits>                             // for numeric_limits
 #include <utility>                            // for pair
 
 FunctionFrontendFlowStep::FunctionFrontendFlowStep(const application_managerRef _AppM, const unsigned int _function_id, const FrontendFlowStepType _frontend_flow_step_type, const DesignFlowManagerConstRef _design_flow_manager,
@@ -249,6 +250,43 @@ bool FunctionFrontendFlowStep::HasToBeExecuted() const
    return bb_version != function_behavior->GetBBVersion();
 }
 
+bool FunctionFrontendFlowStep::IsFunctionLocal() const
+{
+   return false;
+}
+
+bool FunctionFrontendFlowStep::IsParallelizable() const
+{
+   if(not IsFunctionLocal())
+   {
+      return false;
+   }
+#ifndef NDEBUG
+   /// transformations have to be applied in a deterministic order to be counted
+   if(parameters->getOption<size_t>(OPT_cfg_max_transformations) != std::numeric_limits<size_t>::max())
+   {
+      return false;
+   }
+#endif
+   /// steps reading the intermediate representation of other functions could see it while it is modified
+   for(const auto relationship_type : {DEPENDENCE_RELATIONSHIP, PRECEDENCE_RELATIONSHIP})
+   {
+      for(const auto& frontend_relationship : ComputeFrontendRelationships(relationship_type))
+      {
+         if(frontend_relationship.second == CALLED_FUNCTIONS or frontend_relationship.second == CALLING_FUNCTIONS)
+         {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+std::string FunctionFrontendFlowStep::GetParallelGroup() const
+{
+   return "Frontend::" + STR(function_id);
+}
+
 void FunctionFrontendFlowStep::WriteBBGraphDot(const std::string& filename) const
 {
    auto bb_graph_info = BBGraphInfoRef(new BBGraphInfo(AppM, function_id));
@@ -96,6 +96,13 @@ class FunctionFrontendFlowStep : public FrontendFlowStep
     */
    void WriteBBGraphDot(const std::string& filename) const;
 
+   /**
+    * Check if InternalExec only modifies the intermediate representation of the analyzed function and creates nodes through the tree_manager
+    * Steps returning true can be executed concurrently with steps analyzing other functions
+    * @return true if the step does not touch data of other functions or global data structures other than the tree_manager
+    */
+   virtual bool IsFunctionLocal() const;
+
  public:
    /**
     * Constructor
@@ -150,6 +157,17 @@ class FunctionFrontendFlowStep : public FrontendFlowStep
     */
    bool HasToBeExecuted() const override;
 
+   /**
+    * Check if this step can be executed concurrently with steps analyzing other functions
+    * @return true if the step is function local and it does not depend on steps of other functions
+    */
+   bool IsParallelizable() const override;
+
+   /**
+    * Return the group of this step: steps analyzing the same function are never executed concurrently
+    */
+   std::string GetParallelGroup() const override;
+
    /**
     * @return on which bb version this step has been executed last time
     */
@@ -423,7 +423,7 @@ DesignFlowStep_Status CreateAddressTranslation::Exec()
       {
          const auto pd = GetPointer<const parm_decl>(GET_NODE(arg));
          const auto id = GetPointer<const identifier_node>(GET_NODE(pd->name));
-         const auto param_name = id->strg;
+         const auto param_name = id->strg.str();
          parameter_to_type[param_name] = tree_helper::CGetType(GET_NODE(arg))->index;
       }
       const auto ft = GetPointer<const function_type>(GET_NODE(fd->type));
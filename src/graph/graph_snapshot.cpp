@@ -0,0 +1,158 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file graph_snapshot.cpp
+ * @brief Immutable compressed sparse row snapshot of a filtered graph
+ *
+ */
+
+/// Header include
+#include "graph_snapshot.hpp"
+
+/// STL include
+#include <deque>
+
+GraphSnapshot::GraphSnapshot(const graph& g)
+{
+   Build(g);
+}
+
+GraphSnapshot::GraphSnapshot(graphs_collection* collection, const int selector)
+{
+   const graph filtered(collection, selector);
+   Build(filtered);
+}
+
+void GraphSnapshot::Build(const graph& g)
+{
+   boost::graph_traits<graph>::vertex_iterator v, v_end;
+   for(boost::tie(v, v_end) = boost::vertices(g); v != v_end; v++)
+   {
+      vertex_to_index[*v] = index_to_vertex.size();
+      index_to_vertex.push_back(*v);
+   }
+   const auto vertices_number = index_to_vertex.size();
+   out_offsets.reserve(vertices_number + 1);
+   out_offsets.push_back(0);
+   std::vector<size_t> in_degrees(vertices_number, 0);
+   for(const auto source : index_to_vertex)
+   {
+      boost::graph_traits<graph>::out_edge_iterator oe, oe_end;
+      for(boost::tie(oe, oe_end) = boost::out_edges(source, g); oe != oe_end; oe++)
+      {
+         const auto target = vertex_to_index.find(boost::target(*oe, g));
+         THROW_ASSERT(target != vertex_to_index.end(), "Target of an edge not in the graph");
+         out_targets.push_back(target->second);
+         out_edges.push_back(*oe);
+         out_selectors.push_back(g.GetSelector(*oe));
+         in_degrees[target->second]++;
+      }
+      out_offsets.push_back(out_targets.size());
+   }
+
+   /// Incoming edges are grouped by target with a counting sort, so that they are sorted by source
+   in_offsets.resize(vertices_number + 1, 0);
+   for(size_t index = 0; index < vertices_number; index++)
+   {
+      in_offsets[index + 1] = in_offsets[index] + in_degrees[index];
+   }
+   in_sources.resize(out_targets.size());
+   in_edges.resize(out_targets.size());
+   std::vector<size_t> next_position(in_offsets.begin(), in_offsets.end() - 1);
+   for(size_t source = 0; source < vertices_number; source++)
+   {
+      for(size_t position = out_offsets[source]; position < out_offsets[source + 1]; position++)
+      {
+         const auto target = out_targets[position];
+         in_sources[next_position[target]] = source;
+         in_edges[next_position[target]] = position;
+         next_position[target]++;
+      }
+   }
+}
+
+void GraphSnapshot::TopologicalSort(std::vector<size_t>& sorted_vertices) const
+{
+   const auto vertices_number = NumVertices();
+   sorted_vertices.clear();
+   sorted_vertices.reserve(vertices_number);
+   std::vector<size_t> in_degrees(vertices_number);
+   for(size_t index = 0; index < vertices_number; index++)
+   {
+      in_degrees[index] = InDegree(index);
+      if(in_degrees[index] == 0)
+      {
+         sorted_vertices.push_back(index);
+      }
+   }
+   /// sorted_vertices is used also as queue of the vertices whose predecessors have all been sorted
+   for(size_t current = 0; current < sorted_vertices.size(); current++)
+   {
+      const auto successors = Successors(sorted_vertices[current]);
+      for(auto successor = successors.first; successor != successors.second; successor++)
+      {
+         if(--in_degrees[*successor] == 0)
+         {
+            sorted_vertices.push_back(*successor);
+         }
+      }
+   }
+   THROW_ASSERT(sorted_vertices.size() == vertices_number, "Graph is not acyclic");
+}
+
+bool GraphSnapshot::IsReachable(const size_t x, const size_t y) const
+{
+   std::vector<bool> encountered(NumVertices(), false);
+   std::deque<size_t> running_vertices;
+   running_vertices.push_back(x);
+   encountered[x] = true;
+   while(not running_vertices.empty())
+   {
+      const auto current = running_vertices.front();
+      running_vertices.pop_front();
+      const auto successors = Successors(current);
+      for(auto successor = successors.first; successor != successors.second; successor++)
+      {
+         if(*successor == y)
+         {
+            return true;
+         }
+         if(not encountered[*successor])
+         {
+            encountered[*successor] = true;
+            running_vertices.push_back(*successor);
+         }
+      }
+   }
+   return false;
+}
@@ -0,0 +1,259 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file graph_snapshot.hpp
+ * @brief Immutable compressed sparse row snapshot of a filtered graph
+ *
+ * A GraphSnapshot stores the vertices of a graph with dense indices and the
+ * edges in contiguous arrays, so that read-only analyses can visit
+ * predecessors and successors without re-evaluating the edge selectors of
+ * the filtered graph. The snapshot is not updated when the original graph
+ * is modified.
+ *
+ */
+#ifndef GRAPH_SNAPSHOT_HPP
+#define GRAPH_SNAPSHOT_HPP
+
+/// Graph include
+#include "graph.hpp"
+
+/// STL include
+#include "custom_map.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/// Utility include
+#include "refcount.hpp"
+
+class GraphSnapshot
+{
+ public:
+   /// The type of the vertices of the original graph
+   typedef boost::graph_traits<graphs_collection>::vertex_descriptor vertex_type;
+
+   /// The type of the edges of the original graph
+   typedef boost::graph_traits<graphs_collection>::edge_descriptor edge_type;
+
+   /// A range of dense vertex indices
+   typedef std::pair<const size_t*, const size_t*> IndexRange;
+
+ private:
+   /// The vertices of the original graph indexed by dense index
+   std::vector<vertex_type> index_to_vertex;
+
+   /// The dense index of each vertex
+   CustomUnorderedMap<vertex_type, size_t> vertex_to_index;
+
+   /// The position in out_targets of the first outgoing edge of each vertex; it has one more element than the vertices
+   std::vector<size_t> out_offsets;
+
+   /// The targets of the outgoing edges grouped by source
+   std::vector<size_t> out_targets;
+
+   /// The outgoing edges of the original graph, in the same order of out_targets
+   std::vector<edge_type> out_edges;
+
+   /// The selectors of the outgoing edges, in the same order of out_targets
+   std::vector<int> out_selectors;
+
+   /// The position in in_sources of the first incoming edge of each vertex; it has one more element than the vertices
+   std::vector<size_t> in_offsets;
+
+   /// The sources of the incoming edges grouped by target
+   std::vector<size_t> in_sources;
+
+   /// The position in out_edges of each incoming edge, in the same order of in_sources
+   std::vector<size_t> in_edges;
+
+   /**
+    * Fill the arrays starting from a filtered graph
+    * @param g is the graph to be copied
+    */
+   void Build(const graph& g);
+
+ public:
+   /**
+    * Constructor
+    * @param g is the filtered graph (possibly restricted to a subset of vertices) to be copied
+    */
+   explicit GraphSnapshot(const graph& g);
+
+   /**
+    * Constructor
+    * @param collection is the bulk graph
+    * @param selector is the selector of the edges to be copied
+    */
+   GraphSnapshot(graphs_collection* collection, const int selector);
+
+   /**
+    * Return the number of vertices
+    */
+   inline size_t NumVertices() const
+   {
+      return index_to_vertex.size();
+   }
+
+   /**
+    * Return the number of edges
+    */
+   inline size_t NumEdges() const
+   {
+      return out_targets.size();
+   }
+
+   /**
+    * Return true if the vertex belongs to the snapshot
+    * @param v is the vertex of the original graph
+    */
+   inline bool IsIn(const vertex_type v) const
+   {
+      return vertex_to_index.find(v) != vertex_to_index.end();
+   }
+
+   /**
+    * Return the dense index of a vertex
+    * @param v is the vertex of the original graph
+    */
+   inline size_t GetIndex(const vertex_type v) const
+   {
+      THROW_ASSERT(IsIn(v), "Vertex not in the snapshot");
+      return vertex_to_index.find(v)->second;
+   }
+
+   /**
+    * Return the vertex of the original graph corresponding to a dense index
+    * @param index is the dense index
+    */
+   inline vertex_type GetVertex(const size_t index) const
+   {
+      return index_to_vertex[index];
+   }
+
+   /**
+    * Return the vertices of the original graph sorted by dense index
+    */
+   inline const std::vector<vertex_type>& CGetVertices() const
+   {
+      return index_to_vertex;
+   }
+
+   /**
+    * Return the dense indices of the successors of a vertex
+    * @param index is the dense index of the vertex
+    */
+   inline IndexRange Successors(const size_t index) const
+   {
+      const size_t* base = out_targets.data();
+      return IndexRange(base + out_offsets[index], base + out_offsets[index + 1]);
+   }
+
+   /**
+    * Return the dense indices of the predecessors of a vertex
+    * @param index is the dense index of the vertex
+    */
+   inline IndexRange Predecessors(const size_t index) const
+   {
+      const size_t* base = in_sources.data();
+      return IndexRange(base + in_offsets[index], base + in_offsets[index + 1]);
+   }
+
+   /**
+    * Return the number of outgoing edges of a vertex
+    * @param index is the dense index of the vertex
+    */
+   inline size_t OutDegree(const size_t index) const
+   {
+      return out_offsets[index + 1] - out_offsets[index];
+   }
+
+   /**
+    * Return the number of incoming edges of a vertex
+    * @param index is the dense index of the vertex
+    */
+   inline size_t InDegree(const size_t index) const
+   {
+      return in_offsets[index + 1] - in_offsets[index];
+   }
+
+   /**
+    * Return an outgoing edge of a vertex
+    * @param index is the dense index of the vertex
+    * @param position is the position of the edge among the outgoing edges of the vertex
+    * @return the edge of the original graph
+    */
+   inline edge_type GetOutEdge(const size_t index, const size_t position) const
+   {
+      THROW_ASSERT(position < OutDegree(index), "Edge out of range");
+      return out_edges[out_offsets[index] + position];
+   }
+
+   /**
+    * Return the selector of an outgoing edge of a vertex, already masked with the selector of the copied graph
+    * @param index is the dense index of the vertex
+    * @param position is the position of the edge among the outgoing edges of the vertex
+    */
+   inline int GetOutSelector(const size_t index, const size_t position) const
+   {
+      THROW_ASSERT(position < OutDegree(index), "Edge out of range");
+      return out_selectors[out_offsets[index] + position];
+   }
+
+   /**
+    * Return an incoming edge of a vertex
+    * @param index is the dense index of the vertex
+    * @param position is the position of the edge among the incoming edges of the vertex
+    * @return the edge of the original graph
+    */
+   inline edge_type GetInEdge(const size_t index, const size_t position) const
+   {
+      THROW_ASSERT(position < InDegree(index), "Edge out of range");
+      return out_edges[in_edges[in_offsets[index] + position]];
+   }
+
+   /**
+    * Compute a topological order of the vertices; the graph must be acyclic
+    * @param sorted_vertices is where the dense indices of the sorted vertices will be stored
+    */
+   void TopologicalSort(std::vector<size_t>& sorted_vertices) const;
+
+   /**
+    * Compute if a vertex is reachable from another one
+    * @param x is the dense index of the source vertex
+    * @param y is the dense index of the target vertex
+    * @return true if there is a non empty path from x to y
+    */
+   bool IsReachable(const size_t x, const size_t y) const;
+};
+typedef refcount<const GraphSnapshot> GraphSnapshotConstRef;
+#endif
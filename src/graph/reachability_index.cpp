@@ -0,0 +1,98 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file reachability_index.cpp
+ * @brief Transitive reachability among the vertices of a graph stored as dense bitsets
+ *
+ */
+
+/// Header include
+#include "reachability_index.hpp"
+
+/// Graph include
+#include "graph_snapshot.hpp"
+
+ReachabilityIndex::ReachabilityIndex(const graph& g)
+{
+   const GraphSnapshot snapshot(g);
+   index_to_vertex = snapshot.CGetVertices();
+   for(size_t index = 0; index < index_to_vertex.size(); index++)
+   {
+      vertex_to_index[index_to_vertex[index]] = index;
+   }
+   rows.assign(NumVertices(), boost::dynamic_bitset<>(NumVertices()));
+   std::vector<size_t> sorted_vertices;
+   snapshot.TopologicalSort(sorted_vertices);
+   /// Vertices are visited in reverse topological order, so the rows of the successors are already complete
+   for(auto sorted_vertex = sorted_vertices.rbegin(); sorted_vertex != sorted_vertices.rend(); ++sorted_vertex)
+   {
+      auto& row = rows[*sorted_vertex];
+      const auto successors = snapshot.Successors(*sorted_vertex);
+      for(auto successor = successors.first; successor != successors.second; successor++)
+      {
+         row.set(*successor);
+         row |= rows[*successor];
+      }
+   }
+}
+
+void ReachabilityIndex::AddReachability(const CustomUnorderedSet<vertex>& sources, const CustomUnorderedSet<vertex>& targets)
+{
+   boost::dynamic_bitset<> targets_row(NumVertices());
+   for(const auto target : targets)
+   {
+      const auto target_index = GetIndex(target);
+      THROW_ASSERT(target_index < NumVertices(), "Vertex not in the index");
+      targets_row.set(target_index);
+   }
+   for(const auto source : sources)
+   {
+      const auto source_index = GetIndex(source);
+      THROW_ASSERT(source_index < NumVertices(), "Vertex not in the index");
+      rows[source_index] |= targets_row;
+   }
+}
+
+void ReachabilityIndex::GetReachables(const vertex source, CustomUnorderedSet<vertex>& reachables) const
+{
+   const auto source_index = GetIndex(source);
+   if(source_index == NumVertices())
+   {
+      return;
+   }
+   const auto& row = rows[source_index];
+   for(auto index = row.find_first(); index != boost::dynamic_bitset<>::npos; index = row.find_next(index))
+   {
+      reachables.insert(index_to_vertex[index]);
+   }
+}
@@ -0,0 +1,152 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file reachability_index.hpp
+ * @brief Transitive reachability among the vertices of a graph stored as dense bitsets
+ *
+ * Each vertex of the indexed graph gets a dense index; the set of vertices reachable
+ * from it is stored as a dynamic bitset, so that a query is a single bit test
+ * and set operations among rows are performed one word at a time.
+ *
+ */
+#ifndef REACHABILITY_INDEX_HPP
+#define REACHABILITY_INDEX_HPP
+
+/// Graph include
+#include "graph.hpp"
+
+/// STL include
+#include "custom_map.hpp"
+#include "custom_set.hpp"
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <vector>
+
+/// Utility include
+#include "refcount.hpp"
+
+class ReachabilityIndex
+{
+ private:
+   /// The dense index of each vertex
+   CustomUnorderedMap<vertex, size_t> vertex_to_index;
+
+   /// The vertices sorted by dense index
+   std::vector<vertex> index_to_vertex;
+
+   /// The rows of the vertices: bit j of row i is set if vertex j is reachable from vertex i
+   std::vector<boost::dynamic_bitset<>> rows;
+
+ public:
+   /**
+    * Constructor: compute the transitive closure of an acyclic graph
+    * @param g is the graph
+    */
+   explicit ReachabilityIndex(const graph& g);
+
+   /**
+    * Return the number of vertices of the index
+    */
+   inline size_t NumVertices() const
+   {
+      return index_to_vertex.size();
+   }
+
+   /**
+    * Return the dense index of a vertex or NumVertices() if the vertex does not belong to the index
+    * @param v is the vertex
+    */
+   inline size_t GetIndex(const vertex v) const
+   {
+      const auto it = vertex_to_index.find(v);
+      return it == vertex_to_index.end() ? NumVertices() : it->second;
+   }
+
+   /**
+    * Return the vertex corresponding to a dense index
+    * @param index is the dense index
+    */
+   inline vertex GetVertex(const size_t index) const
+   {
+      return index_to_vertex[index];
+   }
+
+   /**
+    * Return the row of a vertex
+    * @param index is the dense index of the vertex
+    */
+   inline const boost::dynamic_bitset<>& CGetRow(const size_t index) const
+   {
+      return rows[index];
+   }
+
+   /**
+    * Check if a vertex is reachable from another one through a non empty path
+    * @param source is the dense index of the first vertex
+    * @param target is the dense index of the second vertex
+    */
+   inline bool IsReachable(const size_t source, const size_t target) const
+   {
+      THROW_ASSERT(source < NumVertices() and target < NumVertices(), "Vertex out of range");
+      return rows[source].test(target);
+   }
+
+   /**
+    * Check if a vertex is reachable from another one through a non empty path; vertices not belonging to the index are not reachable
+    * @param source is the first vertex
+    * @param target is the second vertex
+    */
+   inline bool IsReachable(const vertex source, const vertex target) const
+   {
+      const auto source_index = GetIndex(source);
+      const auto target_index = GetIndex(target);
+      return source_index < NumVertices() and target_index < NumVertices() and IsReachable(source_index, target_index);
+   }
+
+   /**
+    * Make all the vertices of a set reachable from each vertex of another set
+    * @param sources is the set of the sources
+    * @param targets is the set of the targets
+    */
+   void AddReachability(const CustomUnorderedSet<vertex>& sources, const CustomUnorderedSet<vertex>& targets);
+
+   /**
+    * Return the set of the vertices reachable from a vertex
+    * @param source is the vertex
+    * @param reachables is where the reachable vertices are added
+    */
+   void GetReachables(const vertex source, CustomUnorderedSet<vertex>& reachables) const;
+};
+typedef refcount<ReachabilityIndex> ReachabilityIndexRef;
+typedef refcount<const ReachabilityIndex> ReachabilityIndexConstRef;
+#endif
@@ -0,0 +1,350 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file test_graph_snapshot.cpp
+ * @brief Test unit comparing GraphSnapshot with the filtered boost graph it is built from.
+ *
+ * The program has to be linked with lib_graph.la, global_variables.cpp and the utility library; it takes as optional arguments
+ * the number of random graphs and the seed of the random generator.
+ * Each random acyclic graph has edges with different selectors; for each selector mask, with and without a restriction to a
+ * subset of the vertices, it checks that:
+ * - the snapshot has the same vertices and the same edges of the filtered graph;
+ * - successors, predecessors, edges and masked selectors of each vertex are the ones returned by the boost graph;
+ * - the snapshot built from the bulk graph and a selector is the same of the one built from the filtered graph;
+ * - TopologicalSort returns a permutation of the vertices compatible with the edges;
+ * - IsReachable agrees with a visit of the boost graph.
+ *
+ */
+#include "graph_snapshot.hpp"
+
+#include "edge_info.hpp"
+#include "graph_info.hpp"
+#include "node_info.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// The selectors used for the edges of the random graphs
+static const int selectors[] = {1, 2, 4};
+
+/// The masks used to filter the random graphs
+static const int masks[] = {1, 2, 4, 3, 5, 7};
+
+/**
+ * Create a random acyclic graph; the vertices are added in random order with respect to the topological order
+ * @param generator is the random generator
+ * @param collection is the bulk graph to be filled
+ * @return the created vertices
+ */
+static std::vector<vertex> random_dag(std::mt19937& generator, graphs_collection& collection)
+{
+   const auto num_vertices = std::uniform_int_distribution<size_t>(1, 24)(generator);
+   std::vector<vertex> vertices;
+   for(size_t index = 0; index < num_vertices; index++)
+   {
+      vertices.push_back(collection.AddVertex(NodeInfoRef(new NodeInfo())));
+   }
+   std::vector<vertex> topological_order(vertices);
+   std::shuffle(topological_order.begin(), topological_order.end(), generator);
+   std::uniform_int_distribution<int> percent(0, 99);
+   std::uniform_int_distribution<size_t> selector(0, 2);
+   const auto density = std::uniform_int_distribution<int>(5, 50)(generator);
+   for(size_t source = 0; source < num_vertices; source++)
+   {
+      for(size_t target = source + 1; target < num_vertices; target++)
+      {
+         if(percent(generator) < density)
+         {
+            auto edge_selector = selectors[selector(generator)];
+            if(percent(generator) < 30)
+            {
+               edge_selector |= selectors[selector(generator)];
+            }
+            const auto edge = collection.InternalAddEdge(topological_order[source], topological_order[target], edge_selector, EdgeInfoRef(new EdgeInfo()));
+            /// Edges with no selector left have to be filtered out by every graph
+            if(percent(generator) < 5)
+            {
+               collection.RemoveSelector(edge);
+            }
+         }
+      }
+   }
+   return vertices;
+}
+
+/**
+ * Compute the vertices reachable from a vertex through a non empty path by visiting the boost graph
+ * @param g is the graph
+ * @param source is the vertex
+ */
+static CustomUnorderedSet<vertex> reachables(const graph& g, vertex source)
+{
+   CustomUnorderedSet<vertex> visited;
+   std::vector<vertex> to_visit(1, source);
+   while(not to_visit.empty())
+   {
+      const auto current = to_visit.back();
+      to_visit.pop_back();
+      boost::graph_traits<graph>::out_edge_iterator oe, oe_end;
+      for(boost::tie(oe, oe_end) = boost::out_edges(current, g); oe != oe_end; oe++)
+      {
+         if(visited.insert(boost::target(*oe, g)).second)
+         {
+            to_visit.push_back(boost::target(*oe, g));
+         }
+      }
+   }
+   return visited;
+}
+
+/**
+ * Check that two snapshots are identical
+ */
+static bool same_snapshot(const GraphSnapshot& first, const GraphSnapshot& second)
+{
+   if(first.CGetVertices() != second.CGetVertices() or first.NumEdges() != second.NumEdges())
+   {
+      return false;
+   }
+   for(size_t index = 0; index < first.NumVertices(); index++)
+   {
+      const auto first_successors = first.Successors(index);
+      const auto second_successors = second.Successors(index);
+      if(not std::equal(first_successors.first, first_successors.second, second_successors.first, second_successors.second))
+      {
+         return false;
+      }
+      for(size_t position = 0; position < first.OutDegree(index); position++)
+      {
+         if(first.GetOutEdge(index, position) != second.GetOutEdge(index, position) or first.GetOutSelector(index, position) != second.GetOutSelector(index, position))
+         {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+/**
+ * Compare a snapshot with the graph it has been built from
+ * @param g is the graph
+ * @param snapshot is the snapshot
+ * @return the empty string if the check passed, the description of the mismatch otherwise
+ */
+static std::string check_snapshot(const graph& g, const GraphSnapshot& snapshot)
+{
+   std::vector<vertex> graph_vertices;
+   boost::graph_traits<graph>::vertex_iterator v, v_end;
+   for(boost::tie(v, v_end) = boost::vertices(g); v != v_end; v++)
+   {
+      graph_vertices.push_back(*v);
+   }
+   if(snapshot.CGetVertices() != graph_vertices)
+   {
+      return "different vertices";
+   }
+   size_t num_edges = 0;
+   for(size_t index = 0; index < snapshot.NumVertices(); index++)
+   {
+      const auto current = snapshot.GetVertex(index);
+      if(snapshot.GetIndex(current) != index)
+      {
+         return "wrong index of vertex " + std::to_string(index);
+      }
+
+      std::vector<vertex> graph_successors, snapshot_successors;
+      std::vector<EdgeDescriptor> graph_out_edges, snapshot_out_edges;
+      boost::graph_traits<graph>::out_edge_iterator oe, oe_end;
+      for(boost::tie(oe, oe_end) = boost::out_edges(current, g); oe != oe_end; oe++)
+      {
+         graph_successors.push_back(boost::target(*oe, g));
+         graph_out_edges.push_back(*oe);
+      }
+      const auto successors = snapshot.Successors(index);
+      for(auto successor = successors.first; successor != successors.second; successor++)
+      {
+         snapshot_successors.push_back(snapshot.GetVertex(*successor));
+      }
+      for(size_t position = 0; position < snapshot.OutDegree(index); position++)
+      {
+         const auto edge = snapshot.GetOutEdge(index, position);
+         snapshot_out_edges.push_back(edge);
+         if(snapshot.GetOutSelector(index, position) != g.GetSelector(edge) or snapshot.GetOutSelector(index, position) == 0)
+         {
+            return "wrong selector of an edge of vertex " + std::to_string(index);
+         }
+      }
+      if(graph_successors != snapshot_successors or graph_out_edges != snapshot_out_edges)
+      {
+         return "different successors of vertex " + std::to_string(index);
+      }
+      num_edges += graph_out_edges.size();
+
+      std::vector<vertex> graph_predecessors, snapshot_predecessors;
+      std::vector<EdgeDescriptor> graph_in_edges, snapshot_in_edges;
+      boost::graph_traits<graph>::in_edge_iterator ie, ie_end;
+      for(boost::tie(ie, ie_end) = boost::in_edges(current, g); ie != ie_end; ie++)
+      {
+         graph_predecessors.push_back(boost::source(*ie, g));
+         graph_in_edges.push_back(*ie);
+      }
+      const auto predecessors = snapshot.Predecessors(index);
+      for(auto predecessor = predecessors.first; predecessor != predecessors.second; predecessor++)
+      {
+         snapshot_predecessors.push_back(snapshot.GetVertex(*predecessor));
+      }
+      for(size_t position = 0; position < snapshot.InDegree(index); position++)
+      {
+         snapshot_in_edges.push_back(snapshot.GetInEdge(index, position));
+      }
+      /// The order of the incoming edges is not the same of the boost graph
+      std::sort(graph_predecessors.begin(), graph_predecessors.end());
+      std::sort(snapshot_predecessors.begin(), snapshot_predecessors.end());
+      if(graph_predecessors != snapshot_predecessors or graph_in_edges.size() != snapshot_in_edges.size())
+      {
+         return "different predecessors of vertex " + std::to_string(index);
+      }
+      for(const auto& edge : snapshot_in_edges)
+      {
+         if(boost::target(edge, g) != current or std::find(graph_in_edges.begin(), graph_in_edges.end(), edge) == graph_in_edges.end())
+         {
+            return "wrong incoming edge of vertex " + std::to_string(index);
+         }
+      }
+   }
+   if(snapshot.NumEdges() != num_edges)
+   {
+      return "different number of edges";
+   }
+
+   std::vector<size_t> sorted_vertices;
+   snapshot.TopologicalSort(sorted_vertices);
+   std::vector<size_t> positions(snapshot.NumVertices(), snapshot.NumVertices());
+   for(size_t position = 0; position < sorted_vertices.size(); position++)
+   {
+      positions[sorted_vertices[position]] = position;
+   }
+   if(sorted_vertices.size() != snapshot.NumVertices() or std::count(positions.begin(), positions.end(), snapshot.NumVertices()))
+   {
+      return "topological sort is not a permutation";
+   }
+   for(size_t index = 0; index < snapshot.NumVertices(); index++)
+   {
+      const auto successors = snapshot.Successors(index);
+      for(auto successor = successors.first; successor != successors.second; successor++)
+      {
+         if(positions[index] >= positions[*successor])
+         {
+            return "topological sort violates an edge of vertex " + std::to_string(index);
+         }
+      }
+   }
+
+   for(size_t source = 0; source < snapshot.NumVertices(); source++)
+   {
+      const auto graph_reachables = reachables(g, snapshot.GetVertex(source));
+      for(size_t target = 0; target < snapshot.NumVertices(); target++)
+      {
+         if(snapshot.IsReachable(source, target) != (graph_reachables.find(snapshot.GetVertex(target)) != graph_reachables.end()))
+         {
+            return "wrong reachability from " + std::to_string(source) + " to " + std::to_string(target);
+         }
+      }
+   }
+   return "";
+}
+
+int main(int argc, char* argv[])
+{
+   const size_t num_graphs = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 300;
+   std::mt19937 generator(argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 0);
+   std::uniform_int_distribution<int> percent(0, 99);
+   size_t failures = 0;
+   for(size_t index = 0; index < num_graphs; index++)
+   {
+      graphs_collection collection(GraphInfoRef(new GraphInfo()), ParameterConstRef());
+      const auto vertices = random_dag(generator, collection);
+      /// A non empty subset of the vertices; an empty one would select the whole graph
+      CustomUnorderedSet<vertex> subset;
+      for(const auto v : vertices)
+      {
+         if(subset.empty() or percent(generator) < 60)
+         {
+            subset.insert(v);
+         }
+      }
+      bool passed = true;
+      for(const auto mask : masks)
+      {
+         try
+         {
+            const graph filtered(&collection, mask);
+            const GraphSnapshot snapshot(filtered);
+            auto error = check_snapshot(filtered, snapshot);
+            if(error.empty() and not same_snapshot(snapshot, GraphSnapshot(&collection, mask)))
+            {
+               error = "snapshot of the bulk graph differs from the one of the filtered graph";
+            }
+            if(error.empty())
+            {
+               const graph restricted(&collection, mask, subset);
+               error = check_snapshot(restricted, GraphSnapshot(restricted));
+               if(not error.empty())
+               {
+                  error = "restricted graph: " + error;
+               }
+            }
+            if(not error.empty())
+            {
+               std::cerr << "Graph " << index << " selector " << mask << ": " << error << std::endl;
+               passed = false;
+            }
+         }
+         catch(const std::string& msg)
+         {
+            std::cerr << "Graph " << index << " selector " << mask << ": " << msg << std::endl;
+            passed = false;
+         }
+      }
+      if(not passed)
+      {
+         failures++;
+      }
+   }
+   std::cout << num_graphs - failures << "/" << num_graphs << " graphs passed" << std::endl;
+   return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
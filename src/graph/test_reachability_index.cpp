@@ -0,0 +1,327 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file test_reachability_index.cpp
+ * @brief Test unit comparing ReachabilityIndex with visits of the filtered boost graph it is built from.
+ *
+ * The program has to be linked with lib_graph.la, global_variables.cpp and the utility library; it takes as optional arguments
+ * the number of random graphs and the seed of the random generator.
+ * Each random acyclic graph has edges with different selectors; for each selector mask, with and without a restriction to a
+ * subset of the vertices, it checks that:
+ * - IsReachable and GetReachables agree with a visit of the boost graph, and vertices outside the graph are never reachable;
+ * - after AddReachability on the blocks of a loop, as done for the feedback reachability of the basic blocks, the vertices
+ *   of the loop reach each other as in the graph with the feedback edge, the other pairs are unchanged and the original
+ *   index is not modified.
+ *
+ */
+#include "reachability_index.hpp"
+
+#include "edge_info.hpp"
+#include "graph_info.hpp"
+#include "node_info.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// The selectors used for the edges of the random graphs
+static const int selectors[] = {1, 2, 4};
+
+/// The masks used to filter the random graphs
+static const int masks[] = {1, 2, 4, 3, 5, 7};
+
+/// The selector of the feedback edges
+static const int feedback_selector = 8;
+
+/**
+ * Create a random acyclic graph; the vertices are added in random order with respect to the topological order
+ * @param generator is the random generator
+ * @param collection is the bulk graph to be filled
+ * @return the created vertices
+ */
+static std::vector<vertex> random_dag(std::mt19937& generator, graphs_collection& collection)
+{
+   const auto num_vertices = std::uniform_int_distribution<size_t>(1, 24)(generator);
+   std::vector<vertex> vertices;
+   for(size_t index = 0; index < num_vertices; index++)
+   {
+      vertices.push_back(collection.AddVertex(NodeInfoRef(new NodeInfo())));
+   }
+   std::vector<vertex> topological_order(vertices);
+   std::shuffle(topological_order.begin(), topological_order.end(), generator);
+   std::uniform_int_distribution<int> percent(0, 99);
+   std::uniform_int_distribution<size_t> selector(0, 2);
+   const auto density = std::uniform_int_distribution<int>(5, 50)(generator);
+   for(size_t source = 0; source < num_vertices; source++)
+   {
+      for(size_t target = source + 1; target < num_vertices; target++)
+      {
+         if(percent(generator) < density)
+         {
+            auto edge_selector = selectors[selector(generator)];
+            if(percent(generator) < 30)
+            {
+               edge_selector |= selectors[selector(generator)];
+            }
+            collection.InternalAddEdge(topological_order[source], topological_order[target], edge_selector, EdgeInfoRef(new EdgeInfo()));
+         }
+      }
+   }
+   return vertices;
+}
+
+/**
+ * Compute the vertices reachable from a vertex through a non empty path by visiting the boost graph
+ * @param g is the graph
+ * @param source is the vertex
+ */
+static CustomUnorderedSet<vertex> reachables(const graph& g, vertex source)
+{
+   CustomUnorderedSet<vertex> visited;
+   std::vector<vertex> to_visit(1, source);
+   while(not to_visit.empty())
+   {
+      const auto current = to_visit.back();
+      to_visit.pop_back();
+      boost::graph_traits<graph>::out_edge_iterator oe, oe_end;
+      for(boost::tie(oe, oe_end) = boost::out_edges(current, g); oe != oe_end; oe++)
+      {
+         if(visited.insert(boost::target(*oe, g)).second)
+         {
+            to_visit.push_back(boost::target(*oe, g));
+         }
+      }
+   }
+   return visited;
+}
+
+/**
+ * Compare an index with the graph it has been built from
+ * @param g is the graph
+ * @param index is the reachability index
+ * @param vertices are all the vertices of the bulk graph
+ * @return the empty string if the check passed, the description of the mismatch otherwise
+ */
+static std::string check_index(const graph& g, const ReachabilityIndex& index, const std::vector<vertex>& vertices)
+{
+   size_t num_vertices = 0;
+   boost::graph_traits<graph>::vertex_iterator v, v_end;
+   for(boost::tie(v, v_end) = boost::vertices(g); v != v_end; v++)
+   {
+      num_vertices++;
+   }
+   if(index.NumVertices() != num_vertices)
+   {
+      return "different number of vertices";
+   }
+   for(const auto source : vertices)
+   {
+      const auto source_index = index.GetIndex(source);
+      CustomUnorderedSet<vertex> index_reachables;
+      index.GetReachables(source, index_reachables);
+      if(not g.is_in_subset(source))
+      {
+         if(source_index != index.NumVertices() or not index_reachables.empty())
+         {
+            return "vertex outside the graph belongs to the index";
+         }
+         for(const auto target : vertices)
+         {
+            if(index.IsReachable(source, target) or index.IsReachable(target, source))
+            {
+               return "vertex outside the graph is reachable";
+            }
+         }
+         continue;
+      }
+      if(source_index == index.NumVertices() or index.GetVertex(source_index) != source)
+      {
+         return "wrong index of a vertex";
+      }
+      const auto graph_reachables = reachables(g, source);
+      if(index_reachables != graph_reachables or index.CGetRow(source_index).count() != graph_reachables.size())
+      {
+         return "different reachables from vertex " + std::to_string(source_index);
+      }
+      for(const auto target : vertices)
+      {
+         if(not g.is_in_subset(target))
+         {
+            continue;
+         }
+         const auto expected = graph_reachables.find(target) != graph_reachables.end();
+         if(index.IsReachable(source, target) != expected or index.IsReachable(source_index, index.GetIndex(target)) != expected)
+         {
+            return "wrong reachability from " + std::to_string(source_index) + " to " + std::to_string(index.GetIndex(target));
+         }
+      }
+   }
+   return "";
+}
+
+/**
+ * Add a loop to a graph and check the feedback reachability computed by AddReachability
+ * @param generator is the random generator
+ * @param collection is the bulk graph
+ * @param mask is the selector of the acyclic graph
+ * @param index is the reachability index of the acyclic graph
+ * @param vertices are all the vertices of the bulk graph
+ * @return the empty string if the check passed, the description of the mismatch otherwise
+ */
+static std::string check_feedback(std::mt19937& generator, graphs_collection& collection, const int mask, const ReachabilityIndex& index, const std::vector<vertex>& vertices)
+{
+   const graph acyclic(&collection, mask);
+   /// The loop is closed by a feedback edge from a latch to a header; its blocks are the ones on a path from the header to the latch
+   const auto header = vertices[std::uniform_int_distribution<size_t>(0, vertices.size() - 1)(generator)];
+   std::vector<vertex> latches(1, header);
+   for(const auto v : reachables(acyclic, header))
+   {
+      latches.push_back(v);
+   }
+   std::sort(latches.begin(), latches.end());
+   const auto latch = latches[std::uniform_int_distribution<size_t>(0, latches.size() - 1)(generator)];
+   CustomUnorderedSet<vertex> loop_blocks;
+   const auto header_reachables = reachables(acyclic, header);
+   for(const auto v : vertices)
+   {
+      if(v == header or v == latch or (header_reachables.count(v) and reachables(acyclic, v).count(latch)))
+      {
+         loop_blocks.insert(v);
+      }
+   }
+
+   std::vector<bool> original_rows;
+   for(const auto source : vertices)
+   {
+      for(const auto target : vertices)
+      {
+         original_rows.push_back(index.IsReachable(source, target));
+      }
+   }
+   const ReachabilityIndexRef feedback_index(new ReachabilityIndex(index));
+   feedback_index->AddReachability(loop_blocks, loop_blocks);
+
+   const auto feedback_edge = collection.InternalAddEdge(latch, header, feedback_selector, EdgeInfoRef(new EdgeInfo()));
+   const graph cyclic(&collection, mask | feedback_selector);
+   std::string error;
+   size_t position = 0;
+   for(const auto source : vertices)
+   {
+      const auto cyclic_reachables = reachables(cyclic, source);
+      const auto acyclic_reachables = reachables(acyclic, source);
+      for(const auto target : vertices)
+      {
+         const auto in_loop = loop_blocks.count(source) and loop_blocks.count(target);
+         const auto expected = in_loop ? cyclic_reachables.count(target) != 0 : acyclic_reachables.count(target) != 0;
+         if(error.empty() and (in_loop and not expected))
+         {
+            error = "blocks of the loop do not reach each other in the graph with the feedback edge";
+         }
+         if(error.empty() and feedback_index->IsReachable(source, target) != expected)
+         {
+            error = "wrong feedback reachability";
+         }
+         if(error.empty() and index.IsReachable(source, target) != original_rows[position])
+         {
+            error = "AddReachability modified the original index";
+         }
+         position++;
+      }
+   }
+   boost::remove_edge(feedback_edge, collection);
+   return error;
+}
+
+int main(int argc, char* argv[])
+{
+   const size_t num_graphs = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 300;
+   std::mt19937 generator(argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 0);
+   std::uniform_int_distribution<int> percent(0, 99);
+   size_t failures = 0;
+   for(size_t index = 0; index < num_graphs; index++)
+   {
+      graphs_collection collection(GraphInfoRef(new GraphInfo()), ParameterConstRef());
+      const auto vertices = random_dag(generator, collection);
+      /// A non empty subset of the vertices; an empty one would select the whole graph
+      CustomUnorderedSet<vertex> subset;
+      for(const auto v : vertices)
+      {
+         if(subset.empty() or percent(generator) < 60)
+         {
+            subset.insert(v);
+         }
+      }
+      bool passed = true;
+      for(const auto mask : masks)
+      {
+         try
+         {
+            const graph filtered(&collection, mask);
+            const ReachabilityIndex reachability(filtered);
+            auto error = check_index(filtered, reachability, vertices);
+            if(error.empty())
+            {
+               const graph restricted(&collection, mask, subset);
+               error = check_index(restricted, ReachabilityIndex(restricted), vertices);
+               if(not error.empty())
+               {
+                  error = "restricted graph: " + error;
+               }
+            }
+            if(error.empty())
+            {
+               error = check_feedback(generator, collection, mask, reachability, vertices);
+            }
+            if(not error.empty())
+            {
+               std::cerr << "Graph " << index << " selector " << mask << ": " << error << std::endl;
+               passed = false;
+            }
+         }
+         catch(const std::string& msg)
+         {
+            std::cerr << "Graph " << index << " selector " << mask << ": " << msg << std::endl;
+            passed = false;
+         }
+      }
+      if(not passed)
+      {
+         failures++;
+      }
+   }
+   std::cout << num_graphs - failures << "/" << num_graphs << " graphs passed" << std::endl;
+   return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
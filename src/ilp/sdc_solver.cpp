@@ -0,0 +1,470 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file sdc_solver.cpp
+ * @brief Implementation of the native solver for systems of difference constraints
+ *
+ */
+#include "sdc_solver.hpp"
+
+#include "dbgPrintHelper.hpp"
+#include "exceptions.hpp"
+#include "string_manipulation.hpp" // for STR
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <utility>
+
+sdc_solver::sdc_solver(supported_solvers _fallback_type)
+    : fallback_type(_fallback_type), num_variables(0), objective_dir(min), is_difference_system(true), solved(false), use_fallback_solution(false)
+{
+}
+
+sdc_solver::~sdc_solver() = default;
+
+/**
+ * Convert a constant of the model into an integer one
+ * @param value is the constant
+ * @param result is where the converted value is stored
+ * @return true if the constant is integral
+ */
+static bool to_integer(double value, long long& result)
+{
+   if(std::isnan(value) or std::abs(value) >= static_cast<double>(std::numeric_limits<long long>::max() / 4))
+   {
+      return false;
+   }
+   const double rounded = std::floor(value + 0.5);
+   if(std::abs(value - rounded) > 1e-9)
+   {
+      return false;
+   }
+   result = static_cast<long long>(rounded);
+   return true;
+}
+
+void sdc_solver::make(int nvars)
+{
+   THROW_ASSERT(nvars >= 0, "expected a non-negative number of variables");
+   num_variables = static_cast<size_t>(nvars);
+   rows.clear();
+   objective.clear();
+   objective_dir = min;
+   col_names.assign(num_variables, "");
+   integer_variables.assign(num_variables, false);
+   edges.assign(num_variables, std::vector<edge>());
+   values.assign(num_variables, 0);
+   row_lower_bounds.assign(num_variables, std::numeric_limits<long long>::min());
+   row_upper_bounds.assign(num_variables, std::numeric_limits<long long>::max());
+   pending.clear();
+   is_pending.assign(num_variables, false);
+   lower_bounds.clear();
+   upper_bounds.clear();
+   is_difference_system = true;
+   solved = false;
+   fallback_solution.clear();
+   use_fallback_solution = false;
+}
+
+int sdc_solver::add_empty_column()
+{
+   const auto var = num_variables++;
+   col_names.push_back("");
+   integer_variables.push_back(false);
+   edges.push_back(std::vector<edge>());
+   values.push_back(0);
+   row_lower_bounds.push_back(std::numeric_limits<long long>::min());
+   row_upper_bounds.push_back(std::numeric_limits<long long>::max());
+   is_pending.push_back(false);
+   /// A fresh column has no lower bound: the warm start is no more meaningful
+   solved = false;
+   return static_cast<int>(var);
+}
+
+void sdc_solver::raise(size_t var, long long bound)
+{
+   if(solved and values[var] < bound)
+   {
+      values[var] = bound;
+      if(not is_pending[var])
+      {
+         is_pending[var] = true;
+         pending.push_back(var);
+      }
+   }
+}
+
+void sdc_solver::add_edge(size_t source, size_t target, long long weight)
+{
+   edges[source].push_back(edge{target, weight});
+   if(solved)
+   {
+      raise(target, values[source] + weight);
+   }
+}
+
+void sdc_solver::add_row(std::map<int, double>& i_coeffs, double i_rhs, ilp_sign i_sign, const std::string& name)
+{
+   rows.push_back(row{i_coeffs, i_rhs, i_sign, name});
+   if(not is_difference_system)
+   {
+      return;
+   }
+   std::vector<std::pair<size_t, double>> terms;
+   for(const auto& coeff : i_coeffs)
+   {
+      THROW_ASSERT(coeff.first >= 0 and static_cast<size_t>(coeff.first) < num_variables, "Variable " + STR(coeff.first) + " does not exist");
+      if(coeff.second != 0.0)
+      {
+         terms.push_back(std::make_pair(static_cast<size_t>(coeff.first), coeff.second));
+      }
+   }
+   long long rhs;
+   if(not to_integer(i_rhs, rhs))
+   {
+      is_difference_system = false;
+      return;
+   }
+   if(terms.size() == 1 and (terms.front().second == 1.0 or terms.front().second == -1.0))
+   {
+      /// Bound on a single variable: normalize to x (sign) rhs
+      const auto var = terms.front().first;
+      auto sign = i_sign;
+      if(terms.front().second < 0)
+      {
+         rhs = -rhs;
+         sign = sign == G ? L : (sign == L ? G : E);
+      }
+      if(sign == G or sign == E)
+      {
+         row_lower_bounds[var] = std::max(row_lower_bounds[var], rhs);
+         raise(var, rhs);
+      }
+      if(sign == L or sign == E)
+      {
+         row_upper_bounds[var] = std::min(row_upper_bounds[var], rhs);
+      }
+      return;
+   }
+   if(terms.size() == 2 and terms.front().second == -terms.back().second and (terms.front().second == 1.0 or terms.front().second == -1.0))
+   {
+      /// Difference constraint: normalize to x_positive - x_negative (sign) rhs
+      const auto positive = terms.front().second > 0 ? terms.front().first : terms.back().first;
+      const auto negative = terms.front().second > 0 ? terms.back().first : terms.front().first;
+      if(i_sign == G or i_sign == E)
+      {
+         add_edge(negative, positive, rhs);
+      }
+      if(i_sign == L or i_sign == E)
+      {
+         add_edge(positive, negative, -rhs);
+      }
+      return;
+   }
+   is_difference_system = false;
+}
+
+void sdc_solver::objective_add(std::map<int, double>& i_coeffs, ilp_dir dir)
+{
+   objective = i_coeffs;
+   objective_dir = dir;
+}
+
+void sdc_solver::set_int(int i)
+{
+   integer_variables[static_cast<size_t>(i)] = true;
+}
+
+void sdc_solver::set_bnds(int var, double lowbo, double upbo)
+{
+   set_lowbo(var, lowbo);
+   set_upbo(var, upbo);
+}
+
+void sdc_solver::set_lowbo(int var, double bound)
+{
+   if(solved and lower_bounds.find(var) != lower_bounds.end() and bound < lower_bounds.find(var)->second)
+   {
+      /// The feasible region has been enlarged: the warm start is no more meaningful
+      solved = false;
+   }
+   meilp_solver::set_lowbo(var, bound);
+   long long int_bound;
+   if(to_integer(bound, int_bound))
+   {
+      raise(static_cast<size_t>(var), int_bound);
+   }
+}
+
+void sdc_solver::set_upbo(int var, double bound)
+{
+   meilp_solver::set_upbo(var, bound);
+}
+
+void sdc_solver::set_all_bounds()
+{
+   /// Bounds are directly read from lower_bounds and upper_bounds during the solution
+}
+
+bool sdc_solver::is_native() const
+{
+   if(not is_difference_system)
+   {
+      return false;
+   }
+   /// The least solution exists only if every variable is bounded from below
+   for(size_t var = 0; var < num_variables; var++)
+   {
+      const auto lower_bound = lower_bounds.find(static_cast<int>(var));
+      long long int_bound;
+      if(lower_bound == lower_bounds.end() or not to_integer(lower_bound->second, int_bound))
+      {
+         return false;
+      }
+   }
+   /// The least solution is optimal only if the objective is non-decreasing in every variable
+   for(const auto& coeff : objective)
+   {
+      if((objective_dir == min and coeff.second < 0.0) or (objective_dir == max and coeff.second > 0.0))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+bool sdc_solver::propagate()
+{
+   /// Queue based Bellman-Ford: in absence of positive cycles no variable can be raised more than num_variables times
+   std::vector<size_t> raised(num_variables, 0);
+   while(not pending.empty())
+   {
+      const auto source = pending.front();
+      pending.pop_front();
+      is_pending[source] = false;
+      const auto source_value = values[source];
+      for(const auto& out_edge : edges[source])
+      {
+         const auto candidate = source_value + out_edge.weight;
+         if(candidate > values[out_edge.target])
+         {
+            values[out_edge.target] = candidate;
+            if(++raised[out_edge.target] > num_variables)
+            {
+               return false;
+            }
+            if(not is_pending[out_edge.target])
+            {
+               is_pending[out_edge.target] = true;
+               pending.push_back(out_edge.target);
+            }
+         }
+      }
+   }
+   return true;
+}
+
+int sdc_solver::solve_fallback(bool integer)
+{
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERBOSE, debug_level, "---Model is not a system of difference constraints: using fallback solver");
+   const auto fallback = create_solver(fallback_type);
+   fallback->set_debug_level(debug_level);
+   if(MAX_time)
+   {
+      fallback->setMaximumSeconds(MAX_time);
+   }
+   fallback->set_priority(priority);
+   fallback->make(static_cast<int>(num_variables));
+   for(size_t var = 0; var < num_variables; var++)
+   {
+      if(col_names[var] != "")
+      {
+         fallback->set_col_name(static_cast<int>(var), col_names[var]);
+      }
+      if(integer_variables[var])
+      {
+         fallback->set_int(static_cast<int>(var));
+      }
+   }
+   for(const auto& lower_bound : lower_bounds)
+   {
+      fallback->set_lowbo(lower_bound.first, lower_bound.second);
+   }
+   for(const auto& upper_bound : upper_bounds)
+   {
+      fallback->set_upbo(upper_bound.first, upper_bound.second);
+   }
+   for(auto& current_row : rows)
+   {
+      fallback->add_row(current_row.coeffs, current_row.rhs, current_row.sign, current_row.name);
+   }
+   fallback->objective_add(objective, objective_dir);
+   const auto result = integer ? fallback->solve_ilp() : fallback->solve();
+   fallback->get_vars_solution(fallback_solution);
+   use_fallback_solution = true;
+   return result;
+}
+
+int sdc_solver::solve()
+{
+   if(not is_native())
+   {
+      return solve_fallback(false);
+   }
+   use_fallback_solution = false;
+   if(not solved)
+   {
+      /// Cold start: every variable starts from its lower bound
+      pending.clear();
+      for(size_t var = 0; var < num_variables; var++)
+      {
+         long long lower_bound = 0;
+         to_integer(lower_bounds.find(static_cast<int>(var))->second, lower_bound);
+         values[var] = std::max(lower_bound, row_lower_bounds[var]);
+         is_pending[var] = true;
+         pending.push_back(var);
+      }
+   }
+   /// Otherwise warm start: only the variables raised by the rows added after the last solution have to be propagated
+   solved = true;
+   if(not propagate())
+   {
+      INDENT_DBG_MEX(DEBUG_LEVEL_VERBOSE, debug_level, "---Positive cycle in the constraint graph: model is infeasible");
+      pending.clear();
+      is_pending.assign(num_variables, false);
+      solved = false;
+      return 1;
+   }
+   for(size_t var = 0; var < num_variables; var++)
+   {
+      const auto upper_bound = upper_bounds.find(static_cast<int>(var));
+      if(values[var] > row_upper_bounds[var] or (upper_bound != upper_bounds.end() and static_cast<double>(values[var]) > upper_bound->second))
+      {
+         /// Every feasible point is not smaller than the least one
+         INDENT_DBG_MEX(DEBUG_LEVEL_VERBOSE, debug_level, "---Upper bound of variable " + STR(var) + " violated: model is infeasible");
+         return 1;
+      }
+   }
+   return 0;
+}
+
+int sdc_solver::solve_ilp()
+{
+   if(not is_native())
+   {
+      return solve_fallback(true);
+   }
+   /// With integer constants the least solution is integral
+   return solve();
+}
+
+void sdc_solver::get_vars_solution(std::map<int, double>& vars) const
+{
+   if(use_fallback_solution)
+   {
+      vars = fallback_solution;
+      return;
+   }
+   vars.clear();
+   for(size_t var = 0; var < num_variables; var++)
+   {
+      vars[static_cast<int>(var)] = static_cast<double>(values[var]);
+   }
+}
+
+int sdc_solver::get_number_constraints() const
+{
+   return static_cast<int>(rows.size());
+}
+
+int sdc_solver::get_number_variables() const
+{
+   return static_cast<int>(num_variables);
+}
+
+void sdc_solver::set_col_name(int var, const std::string& name)
+{
+   col_names[static_cast<size_t>(var)] = name + "_" + STR(var);
+}
+
+std::string sdc_solver::get_col_name(int var)
+{
+   const auto& name = col_names[static_cast<size_t>(var)];
+   return name != "" ? name : "x_" + STR(var);
+}
+
+void sdc_solver::print(std::ostream& os)
+{
+   /// CPLEX LP format
+   const auto print_terms = [&](const std::map<int, double>& coeffs) {
+      for(const auto& coeff : coeffs)
+      {
+         os << " " << (coeff.second < 0 ? "- " : "+ ") << std::abs(coeff.second) << " " << get_col_name(coeff.first);
+      }
+   };
+   os << (objective_dir == min ? "Minimize" : "Maximize") << "\n obj:";
+   print_terms(objective);
+   os << "\nSubject To\n";
+   size_t row_index = 0;
+   for(const auto& current_row : rows)
+   {
+      os << " " << (current_row.name != "" ? current_row.name : "r_" + STR(row_index)) << ":";
+      print_terms(current_row.coeffs);
+      os << (current_row.sign == G ? " >= " : (current_row.sign == L ? " <= " : " = ")) << current_row.rhs << "\n";
+      row_index++;
+   }
+   os << "Bounds\n";
+   for(size_t var = 0; var < num_variables; var++)
+   {
+      const auto lower_bound = lower_bounds.find(static_cast<int>(var));
+      const auto upper_bound = upper_bounds.find(static_cast<int>(var));
+      os << " " << (lower_bound != lower_bounds.end() ? STR(lower_bound->second) : "-inf") << " <= " << get_col_name(static_cast<int>(var)) << " <= " << (upper_bound != upper_bounds.end() ? STR(upper_bound->second) : "+inf") << "\n";
+   }
+   os << "Generals\n";
+   for(size_t var = 0; var < num_variables; var++)
+   {
+      if(integer_variables[var])
+      {
+         os << " " << get_col_name(static_cast<int>(var)) << "\n";
+      }
+   }
+   os << "End\n";
+}
+
+void sdc_solver::print_to_file(const std::string& file_name)
+{
+   std::ofstream out((file_name + ".lp").c_str());
+   print(out);
+}
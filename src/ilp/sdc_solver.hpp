@@ -0,0 +1,204 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file sdc_solver.hpp
+ * @brief Native solver for systems of difference constraints
+ *
+ * SDC formulations only contain rows of the form x_i - x_j (>=,<=,=) c and bounds on single variables; the feasible
+ * region of such a system is closed under component-wise minimum, so the least feasible point is optimal for any
+ * objective minimizing a non-negatively weighted sum of variables. This solver computes that point as longest paths
+ * over the constraint graph and falls back to a real ILP solver when the model does not fit this shape.
+ *
+ */
+#ifndef SDC_SOLVER_HPP
+#define SDC_SOLVER_HPP
+
+#include "meilp_solver.hpp"
+
+#include <deque>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+class sdc_solver : public meilp_solver
+{
+ private:
+   /// A row of the model as passed by the user; kept to print the model and to feed the fallback solver
+   struct row
+   {
+      std::map<int, double> coeffs;
+      double rhs;
+      ilp_sign sign;
+      std::string name;
+   };
+
+   /// An edge of the constraint graph: x_target >= x_source + weight
+   struct edge
+   {
+      size_t target;
+      long long weight;
+   };
+
+   /// The solver used when the model is not a system of difference constraints
+   const supported_solvers fallback_type;
+
+   /// The number of variables
+   size_t num_variables;
+
+   /// The rows of the model
+   std::vector<row> rows;
+
+   /// The objective function
+   std::map<int, double> objective;
+
+   /// The direction of the objective function
+   ilp_dir objective_dir;
+
+   /// The names of the columns
+   std::vector<std::string> col_names;
+
+   /// The integer variables
+   std::vector<bool> integer_variables;
+
+   /// The outgoing edges of each variable
+   std::vector<std::vector<edge>> edges;
+
+   /// The lower bounds imposed by single variable rows
+   std::vector<long long> row_lower_bounds;
+
+   /// The upper bounds imposed by single variable rows
+   std::vector<long long> row_upper_bounds;
+
+   /// The current (least) values of the variables
+   std::vector<long long> values;
+
+   /// The variables whose value has been raised and whose outgoing edges have still to be relaxed
+   std::deque<size_t> pending;
+
+   /// Membership flags of pending
+   std::vector<bool> is_pending;
+
+   /// True if the model is still a system of difference constraints with integer constants
+   bool is_difference_system;
+
+   /// True if values contains the least solution of the rows added so far
+   bool solved;
+
+   /// The solution computed by the fallback solver
+   std::map<int, double> fallback_solution;
+
+   /// True if the last solution has been computed by the fallback solver
+   bool use_fallback_solution;
+
+   /**
+    * Add an edge to the constraint graph, updating the pending variables if the graph has already been solved
+    * @param source is the source variable
+    * @param target is the target variable
+    * @param weight is the minimum distance between source and target
+    */
+   void add_edge(size_t source, size_t target, long long weight);
+
+   /**
+    * Raise the value of a variable to a new lower bound
+    * @param var is the variable
+    * @param bound is the new lower bound
+    */
+   void raise(size_t var, long long bound);
+
+   /**
+    * Propagate the pending variables along the constraint graph
+    * @return true if no positive cycle has been found
+    */
+   bool propagate();
+
+   /**
+    * Check if the current model can be solved by the native algorithm
+    * @return true if the rows, the bounds and the objective fit a system of difference constraints
+    */
+   bool is_native() const;
+
+   /**
+    * Solve the model with the fallback solver
+    * @param integer tells if the integrality of the variables has to be enforced
+    * @return the result of the fallback solver
+    */
+   int solve_fallback(bool integer);
+
+ protected:
+   void set_all_bounds() override;
+
+   void print(std::ostream& os) override;
+
+ public:
+   /**
+    * Constructor
+    * @param fallback_type is the solver used for the models which are not systems of difference constraints
+    */
+   explicit sdc_solver(supported_solvers fallback_type);
+
+   ~sdc_solver() override;
+
+   void make(int nvars) override;
+
+   int solve() override;
+
+   int solve_ilp() override;
+
+   void add_row(std::map<int, double>& i_coeffs, double i_rhs, ilp_sign i_sign, const std::string& name) override;
+
+   void objective_add(std::map<int, double>& i_coeffs, ilp_dir dir) override;
+
+   void set_int(int i) override;
+
+   void set_bnds(int var, double lowbo, double upbo) override;
+
+   void set_lowbo(int var, double bound) override;
+
+   void set_upbo(int var, double bound) override;
+
+   void get_vars_solution(std::map<int, double>& vars) const override;
+
+   int get_number_constraints() const override;
+
+   int get_number_variables() const override;
+
+   void set_col_name(int var, const std::string& name) override;
+
+   std::string get_col_name(int var) override;
+
+   int add_empty_column() override;
+
+   void print_to_file(const std::string& file_name) override;
+};
+#endif
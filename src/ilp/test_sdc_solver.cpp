@@ -0,0 +1,336 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2015-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file test_sdc_solver.cpp
+ * @brief Test unit comparing sdc_solver with GLPK on random systems of difference constraints.
+ *
+ * The program has to be linked with lib_ilp.la, global_variables.cpp and the utility library; it takes as optional arguments
+ * the number of systems and the seed of the random generator.
+ * For each system it checks that:
+ * - sdc_solver and GLPK agree on the feasibility and on the optimal value of the objective;
+ * - the solution of sdc_solver satisfies every row and every bound;
+ * - the solution of sdc_solver is not larger than the GLPK one in any variable, since it is the least feasible point;
+ * - adding rows after a solution (warm start) gives the same solution as solving the whole model from scratch;
+ * - a model containing a row which is not a difference is solved by the fallback with the same optimum as GLPK.
+ *
+ */
+#include "config_HAVE_GLPK.hpp"
+
+#include "meilp_solver.hpp"
+#include "sdc_solver.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#if HAVE_GLPK
+/// A row of a random model
+struct test_row
+{
+   std::map<int, double> coeffs;
+   double rhs;
+   meilp_solver::ilp_sign sign;
+};
+
+/// A random model
+struct test_model
+{
+   int num_variables;
+   int upper_bound;
+   std::vector<test_row> rows;
+   std::map<int, double> objective;
+};
+
+/**
+ * Create a random system of difference constraints shaped like an SDC scheduling formulation
+ * @param generator is the random generator
+ * @param difference_only tells if all the rows have to be differences
+ */
+static test_model random_model(std::mt19937& generator, bool difference_only)
+{
+   test_model model;
+   model.num_variables = std::uniform_int_distribution<int>(2, 8)(generator);
+   model.upper_bound = std::uniform_int_distribution<int>(5, 40)(generator);
+   std::uniform_int_distribution<int> variable(0, model.num_variables - 1);
+   std::uniform_int_distribution<int> constant(-4, 4);
+   std::uniform_int_distribution<int> percent(0, 99);
+   const auto num_rows = std::uniform_int_distribution<int>(model.num_variables, 3 * model.num_variables)(generator);
+   for(int index = 0; index < num_rows; index++)
+   {
+      test_row row;
+      const auto first = variable(generator);
+      const auto second = variable(generator);
+      const auto kind = percent(generator);
+      row.sign = kind < 60 ? meilp_solver::G : (kind < 90 ? meilp_solver::L : meilp_solver::E);
+      row.rhs = constant(generator);
+      if(first == second or percent(generator) < 10)
+      {
+         /// Bound on a single variable
+         row.coeffs[first] = 1.0;
+         row.rhs = std::abs(row.rhs);
+      }
+      else
+      {
+         row.coeffs[first] = 1.0;
+         row.coeffs[second] = -1.0;
+      }
+      model.rows.push_back(row);
+   }
+   if(not difference_only)
+   {
+      test_row row;
+      const auto first = variable(generator);
+      auto second = variable(generator);
+      if(second == first)
+      {
+         second = (first + 1) % model.num_variables;
+      }
+      row.coeffs[first] = 2.0;
+      row.coeffs[second] = 1.0;
+      row.rhs = std::uniform_int_distribution<int>(1, 10)(generator);
+      row.sign = meilp_solver::G;
+      model.rows.push_back(row);
+   }
+   for(int var = 0; var < model.num_variables; var++)
+   {
+      if(percent(generator) < 50)
+      {
+         model.objective[var] = std::uniform_int_distribution<int>(1, 5)(generator);
+      }
+   }
+   return model;
+}
+
+/**
+ * Load the variables of a model into a solver
+ * @param solver is the solver
+ * @param model is the model
+ */
+static void load_variables(const meilp_solverRef& solver, const test_model& model)
+{
+   solver->make(model.num_variables);
+   for(int var = 0; var < model.num_variables; var++)
+   {
+      solver->set_int(var);
+      solver->set_lowbo(var, 0);
+      solver->set_upbo(var, model.upper_bound);
+   }
+}
+
+/**
+ * Load the rows of a model into a solver
+ * @param solver is the solver
+ * @param model is the model
+ * @param begin is the index of the first row to be loaded
+ * @param end is the index after the last row to be loaded
+ */
+static void load_rows(const meilp_solverRef& solver, const test_model& model, size_t begin, size_t end)
+{
+   for(size_t index = begin; index < end; index++)
+   {
+      auto coeffs = model.rows[index].coeffs;
+      solver->add_row(coeffs, model.rows[index].rhs, model.rows[index].sign, "row_" + std::to_string(index));
+   }
+}
+
+/**
+ * Solve a model
+ * @param solver is the solver
+ * @param model is the model
+ * @param solution is where the solution is stored
+ * @return true if the model is feasible
+ */
+static bool solve(const meilp_solverRef& solver, const test_model& model, std::map<int, double>& solution)
+{
+   auto objective = model.objective;
+   solver->objective_add(objective, meilp_solver::min);
+   if(solver->solve_ilp() != 0)
+   {
+      return false;
+   }
+   solver->get_vars_solution(solution);
+   return true;
+}
+
+/**
+ * Compute the value of the objective function
+ */
+static double objective_value(const test_model& model, const std::map<int, double>& solution)
+{
+   double value = 0.0;
+   for(const auto& coeff : model.objective)
+   {
+      value += coeff.second * solution.at(coeff.first);
+   }
+   return value;
+}
+
+/**
+ * Check that a solution satisfies every row and every bound of a model
+ */
+static bool is_feasible(const test_model& model, const std::map<int, double>& solution)
+{
+   for(int var = 0; var < model.num_variables; var++)
+   {
+      if(solution.at(var) < -1e-6 or solution.at(var) > model.upper_bound + 1e-6)
+      {
+         return false;
+      }
+   }
+   for(const auto& row : model.rows)
+   {
+      double lhs = 0.0;
+      for(const auto& coeff : row.coeffs)
+      {
+         lhs += coeff.second * solution.at(coeff.first);
+      }
+      if((row.sign == meilp_solver::G and lhs < row.rhs - 1e-6) or (row.sign == meilp_solver::L and lhs > row.rhs + 1e-6) or (row.sign == meilp_solver::E and std::abs(lhs - row.rhs) > 1e-6))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+/**
+ * Compare sdc_solver and GLPK on a model
+ * @param model is the model
+ * @param index is the index of the model used in the messages
+ * @return true if the check passed
+ */
+static bool check_model(const test_model& model, size_t index)
+{
+   const meilp_solverRef reference = meilp_solver::create_solver(meilp_solver::GLPK);
+   load_variables(reference, model);
+   load_rows(reference, model, 0, model.rows.size());
+   std::map<int, double> reference_solution;
+   const auto reference_feasible = solve(reference, model, reference_solution);
+
+   const meilp_solverRef native(new sdc_solver(meilp_solver::GLPK));
+   load_variables(native, model);
+   load_rows(native, model, 0, model.rows.size());
+   std::map<int, double> native_solution;
+   const auto native_feasible = solve(native, model, native_solution);
+
+   if(reference_feasible != native_feasible)
+   {
+      std::cerr << "Model " << index << ": GLPK feasible " << reference_feasible << " sdc_solver feasible " << native_feasible << std::endl;
+      return false;
+   }
+   if(not native_feasible)
+   {
+      return true;
+   }
+   if(not is_feasible(model, native_solution))
+   {
+      std::cerr << "Model " << index << ": sdc_solver solution violates the model" << std::endl;
+      return false;
+   }
+   if(std::abs(objective_value(model, native_solution) - objective_value(model, reference_solution)) > 1e-6)
+   {
+      std::cerr << "Model " << index << ": GLPK optimum " << objective_value(model, reference_solution) << " sdc_solver optimum " << objective_value(model, native_solution) << std::endl;
+      return false;
+   }
+   bool difference_only = true;
+   for(const auto& row : model.rows)
+   {
+      for(const auto& coeff : row.coeffs)
+      {
+         if(std::abs(coeff.second) != 1.0)
+         {
+            difference_only = false;
+         }
+      }
+   }
+   if(not difference_only)
+   {
+      return true;
+   }
+   for(int var = 0; var < model.num_variables; var++)
+   {
+      if(native_solution.at(var) > reference_solution.at(var) + 1e-6)
+      {
+         std::cerr << "Model " << index << ": sdc_solver solution is not the least one in variable " << var << std::endl;
+         return false;
+      }
+   }
+
+   /// Warm start: solve half of the rows, then add the other ones
+   const meilp_solverRef incremental(new sdc_solver(meilp_solver::GLPK));
+   load_variables(incremental, model);
+   load_rows(incremental, model, 0, model.rows.size() / 2);
+   std::map<int, double> incremental_solution;
+   solve(incremental, model, incremental_solution);
+   load_rows(incremental, model, model.rows.size() / 2, model.rows.size());
+   if(not solve(incremental, model, incremental_solution) or incremental_solution != native_solution)
+   {
+      std::cerr << "Model " << index << ": warm start differs from the cold start" << std::endl;
+      return false;
+   }
+   return true;
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+#if HAVE_GLPK
+   const size_t num_models = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 1000;
+   std::mt19937 generator(argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 0);
+   size_t failures = 0;
+   for(size_t index = 0; index < num_models; index++)
+   {
+      try
+      {
+         if(not check_model(random_model(generator, index % 4 != 3), index))
+         {
+            failures++;
+         }
+      }
+      catch(const std::string& msg)
+      {
+         std::cerr << "Model " << index << ": " << msg << std::endl;
+         failures++;
+      }
+   }
+   std::cout << num_models - failures << "/" << num_models << " models passed" << std::endl;
+   return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+#else
+   printf("GLPK is not available: the reference solver is missing.\n");
+   return EXIT_FAILURE;
+#endif
+}
@@ -42,11 +42,288 @@
 /// Header include
 #include "xml_dom_parser.hpp"
 
+/// polixml include
+#include "polixml.hpp"
+
+/// STD include
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
 #include <utility>
+#include <vector>
+
+/// boost include
+#include <boost/filesystem.hpp>
 
 /// Utility include
+#include "custom_map.hpp"
 #include "fileIO.hpp"
 
+/// The string at the beginning of the binary images of xml documents; it has to be changed every time the format of the images is changed
+#define XML_BINARY_IMAGE_MAGIC "PANDA-XML-IMAGE-1"
+
+/// The suffix of the binary images of xml documents
+#define XML_BINARY_IMAGE_SUFFIX ".xmlimage"
+
+/// The tag of the elements in the binary images
+#define XML_BINARY_IMAGE_ELEMENT 'E'
+
+/// The tag of the text nodes in the binary images
+#define XML_BINARY_IMAGE_TEXT 'T'
+
+/**
+ * Writer of binary images of xml documents; each string is written only once and then referred by its index
+ */
+class XMLBinaryImageWriter
+{
+ private:
+   /// The stream where the image is written
+   std::ostream& os;
+
+   /// The strings already written with their index
+   CustomUnorderedMap<std::string, uint32_t> string_table;
+
+ public:
+   /**
+    * Constructor
+    * @param _os is the stream where the image is written
+    */
+   explicit XMLBinaryImageWriter(std::ostream& _os) : os(_os)
+   {
+   }
+
+   /**
+    * Write an integer
+    * @param value is the value to be written
+    */
+   void WriteInteger(const uint32_t value)
+   {
+      os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+   }
+
+   /**
+    * Write a string: 0 followed by size and characters the first time the string is written, its index plus one the other times
+    * @param str is the string to be written
+    */
+   void WriteString(const std::string& str)
+   {
+      const auto string_index = string_table.find(str);
+      if(string_index != string_table.end())
+      {
+         WriteInteger(string_index->second + 1);
+         return;
+      }
+      const auto index = static_cast<uint32_t>(string_table.size());
+      string_table[str] = index;
+      WriteInteger(0);
+      WriteInteger(static_cast<uint32_t>(str.size()));
+      os.write(str.data(), static_cast<std::streamsize>(str.size()));
+   }
+
+   /**
+    * Write an element with its attributes and its descendants; only elements and text nodes are stored
+    * @param element is the element to be written
+    */
+   void WriteElement(const xml_element* element)
+   {
+      os.put(XML_BINARY_IMAGE_ELEMENT);
+      WriteInteger(static_cast<uint32_t>(element->get_line()));
+      WriteString(element->get_name());
+      const auto& attributes = element->get_attributes();
+      WriteInteger(static_cast<uint32_t>(attributes.size()));
+      for(const auto attribute : attributes)
+      {
+         WriteString(attribute->get_name());
+         WriteString(attribute->get_value());
+      }
+      uint32_t children_number = 0;
+      for(const auto& child : element->get_children())
+      {
+         if(GetPointer<const xml_element>(child) or GetPointer<const xml_text_node>(child))
+         {
+            children_number++;
+         }
+      }
+      WriteInteger(children_number);
+      for(const auto& child : element->get_children())
+      {
+         const auto* child_element = GetPointer<const xml_element>(child);
+         if(child_element)
+         {
+            WriteElement(child_element);
+            continue;
+         }
+         const auto* child_text = GetPointer<const xml_text_node>(child);
+         if(child_text)
+         {
+            os.put(XML_BINARY_IMAGE_TEXT);
+            WriteInteger(static_cast<uint32_t>(child_text->get_line()));
+            WriteString(child_text->get_content());
+         }
+      }
+   }
+};
+
+/**
+ * Reader of binary images of xml documents; all the methods return false if the image is malformed
+ */
+class XMLBinaryImageReader
+{
+ private:
+   /// The content of the image
+   const std::string& buffer;
+
+   /// The current position in the buffer
+   size_t position;
+
+   /// The strings already read
+   std::vector<std::string> string_table;
+
+ public:
+   /**
+    * Constructor
+    * @param _buffer is the content of the image
+    * @param _position is the position of the first byte to be read
+    */
+   XMLBinaryImageReader(const std::string& _buffer, const size_t _position) : buffer(_buffer), position(_position)
+   {
+   }
+
+   /**
+    * Read an integer
+    * @param value is where the read value is stored
+    */
+   bool ReadInteger(uint32_t& value)
+   {
+      if(position + sizeof(value) > buffer.size())
+      {
+         return false;
+      }
+      std::copy(buffer.data() + position, buffer.data() + position + sizeof(value), reinterpret_cast<char*>(&value));
+      position += sizeof(value);
+      return true;
+   }
+
+   /**
+    * Read a string
+    * @param str is where the read string is stored
+    */
+   bool ReadString(std::string& str)
+   {
+      uint32_t index;
+      if(not ReadInteger(index))
+      {
+         return false;
+      }
+      if(index != 0)
+      {
+         if(index > string_table.size())
+         {
+            return false;
+         }
+         str = string_table[index - 1];
+         return true;
+      }
+      uint32_t size;
+      if(not ReadInteger(size) or position + size > buffer.size())
+      {
+         return false;
+      }
+      str = buffer.substr(position, size);
+      position += size;
+      string_table.push_back(str);
+      return true;
+   }
+
+   /**
+    * Read the tag, the line and the name of a node
+    * @param tag is where the tag of the node is stored
+    * @param line is where the line of the node is stored
+    * @param name is where the name of the node is stored
+    */
+   bool ReadNodeHeader(char& tag, int& line, std::string& name)
+   {
+      if(position >= buffer.size())
+      {
+         return false;
+      }
+      tag = buffer[position++];
+      uint32_t read_line;
+      if(not ReadInteger(read_line))
+      {
+         return false;
+      }
+      line = static_cast<int>(read_line);
+      return ReadString(name);
+   }
+
+   /**
+    * Read the attributes and the descendants of an element
+    * @param element is the element to be filled
+    */
+   bool ReadElementBody(xml_element* element)
+   {
+      uint32_t attributes_number;
+      if(not ReadInteger(attributes_number))
+      {
+         return false;
+      }
+      for(uint32_t attribute_index = 0; attribute_index < attributes_number; attribute_index++)
+      {
+         std::string name, value;
+         if(not ReadString(name) or not ReadString(value))
+         {
+            return false;
+         }
+         element->set_attribute(name, value);
+      }
+      uint32_t children_number;
+      if(not ReadInteger(children_number))
+      {
+         return false;
+      }
+      for(uint32_t child_index = 0; child_index < children_number; child_index++)
+      {
+         char tag;
+         int line;
+         std::string name;
+         if(not ReadNodeHeader(tag, line, name))
+         {
+            return false;
+         }
+         if(tag == XML_BINARY_IMAGE_ELEMENT)
+         {
+            auto* child = element->add_child_element(name);
+            child->set_line(line);
+            if(not ReadElementBody(child))
+            {
+               return false;
+            }
+         }
+         else if(tag == XML_BINARY_IMAGE_TEXT)
+         {
+            element->add_child_text(name)->set_line(line);
+         }
+         else
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   /**
+    * Return true if the whole image has been read
+    */
+   bool IsCompleted() const
+   {
+      return position == buffer.size();
+   }
+};
+
 XMLDomParser::XMLDomParser(std::string _name, std::string string_to_be_parsed) : name(std::move(_name)), to_be_parsed(std::move(string_to_be_parsed))
 
 {
@@ -70,3 +347,133 @@ const xml_documentRef XMLDomParser::get_document() const
 {
    return doc;
 }
+
+std::string XMLDomParser::GetVersionKey() const
+{
+   std::stringstream key;
+   key << name << "|";
+   if(name == to_be_parsed)
+   {
+      /// File: a missing or unreadable file has no key, so that the error is reported by the uncached parsing
+      boost::system::error_code error;
+      if(not boost::filesystem::exists(to_be_parsed, error) or error)
+      {
+         return "";
+      }
+      const auto canonical_name = boost::filesystem::canonical(to_be_parsed, error);
+      if(error)
+      {
+         return "";
+      }
+      const auto size = boost::filesystem::file_size(to_be_parsed, error);
+      if(error)
+      {
+         return "";
+      }
+      const auto write_time = boost::filesystem::last_write_time(to_be_parsed, error);
+      if(error)
+      {
+         return "";
+      }
+      key << canonical_name.string() << "|" << size << "|" << write_time;
+   }
+   else
+   {
+      /// String
+      key << to_be_parsed.size() << "|" << std::hash<std::string>()(to_be_parsed);
+   }
+   return key.str();
+}
+
+bool XMLDomParser::LoadBinaryImage(const std::string& image_file_name, const std::string& version_key)
+{
+   std::ifstream image_file(image_file_name, std::ios::binary);
+   if(not image_file)
+   {
+      return false;
+   }
+   const std::string buffer((std::istreambuf_iterator<char>(image_file)), std::istreambuf_iterator<char>());
+   const std::string magic(XML_BINARY_IMAGE_MAGIC);
+   if(buffer.compare(0, magic.size(), magic) != 0)
+   {
+      return false;
+   }
+   XMLBinaryImageReader reader(buffer, magic.size());
+   std::string stored_version_key;
+   if(not reader.ReadString(stored_version_key) or stored_version_key != version_key)
+   {
+      return false;
+   }
+   char tag;
+   int line;
+   std::string root_name;
+   if(not reader.ReadNodeHeader(tag, line, root_name) or tag != XML_BINARY_IMAGE_ELEMENT)
+   {
+      return false;
+   }
+   const xml_documentRef loaded_doc(new xml_document());
+   auto* root = loaded_doc->create_root_node(root_name);
+   root->set_line(line);
+   if(not reader.ReadElementBody(root) or not reader.IsCompleted())
+   {
+      return false;
+   }
+   doc = loaded_doc;
+   return true;
+}
+
+void XMLDomParser::StoreBinaryImage(const std::string& image_file_name, const std::string& version_key) const
+{
+   /// The image is written into a temporary file which is then renamed, so that concurrent executions never read a partial image
+   const auto temporary_image_file_name = boost::filesystem::unique_path(image_file_name + "-%%%%-%%%%-%%%%-%%%%");
+   {
+      std::ofstream image_file(temporary_image_file_name.string(), std::ios::binary);
+      if(not image_file)
+      {
+         return;
+      }
+      image_file << XML_BINARY_IMAGE_MAGIC;
+      XMLBinaryImageWriter writer(image_file);
+      writer.WriteString(version_key);
+      writer.WriteElement(doc->get_root_node());
+      if(not image_file)
+      {
+         image_file.close();
+         boost::filesystem::remove(temporary_image_file_name);
+         return;
+      }
+   }
+   boost::system::error_code error_code;
+   boost::filesystem::rename(temporary_image_file_name, image_file_name, error_code);
+   if(error_code)
+   {
+      boost::filesystem::remove(temporary_image_file_name, error_code);
+   }
+}
+
+void XMLDomParser::Exec(const std::string& cache_directory)
+{
+   if(cache_directory == "")
+   {
+      Exec();
+      return;
+   }
+   const auto version_key = GetVersionKey();
+   if(version_key == "")
+   {
+      Exec();
+      return;
+   }
+   std::stringstream image_name;
+   image_name << std::hex << std::hash<std::string>()(version_key);
+   const auto image_file_name = cache_directory + "/" + image_name.str() + XML_BINARY_IMAGE_SUFFIX;
+   if(LoadBinaryImage(image_file_name, version_key))
+   {
+      return;
+   }
+   Exec();
+   if(doc and doc->get_root_node())
+   {
+      StoreBinaryImage(image_file_name, version_key);
+   }
+}
@@ -70,6 +70,27 @@ class XMLDomParser
    /// The data structure extracted from the file
    xml_documentRef doc;
 
+   /**
+    * Return the string identifying the version of the parsed data: it is the name and the size of the file plus its modification time or the hash of the string;
+    * it is empty when the file cannot be accessed
+    */
+   std::string GetVersionKey() const;
+
+   /**
+    * Load the document from a binary image
+    * @param image_file_name is the file containing the image
+    * @param version_key is the key which has to be stored in the image
+    * @return true if the image is valid and has been loaded
+    */
+   bool LoadBinaryImage(const std::string& image_file_name, const std::string& version_key);
+
+   /**
+    * Store the document into a binary image
+    * @param image_file_name is the file where image has to be written
+    * @param version_key is the key identifying the version of the parsed data
+    */
+   void StoreBinaryImage(const std::string& image_file_name, const std::string& version_key) const;
+
  public:
    /**
     * Constructor from string
@@ -89,6 +110,13 @@ class XMLDomParser
     */
    void Exec();
 
+   /**
+    * Parse an XML document exploiting the binary images stored in a cache directory:
+    * if a valid image exists it is loaded, otherwise the document is parsed and its image is stored
+    * @param cache_directory is the directory containing the binary images; if empty, the cache is not used
+    */
+   void Exec(const std::string& cache_directory);
+
    /** Test whether a document has been parsed.
     */
    operator bool() const;
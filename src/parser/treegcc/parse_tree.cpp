@@ -57,6 +57,7 @@
 
 /// tree include
 #include "tree_manager.hpp"
+#include "tree_node.hpp"
 
 /// Utility include
 #include "refcount.hpp"
@@ -64,12 +65,20 @@
 // exit_code is stored in zebu.cpp
 extern int exit_code;
 
-tree_managerRef ParseTreeFile(const ParameterConstRef& Param, const std::string& f)
+/// The first unused version of ssa_name among all the parsed files
+static unsigned int global_uniq_vers_id = 1;
+
+tree_managerRef ParseTreeFile(const ParameterConstRef& Param, const std::string& f, const bool unique_ssa_versions)
 {
    try
    {
       extern tree_managerRef tree_parseY(const ParameterConstRef Param, std::string fn);
-      return tree_parseY(Param, f);
+      const tree_managerRef TM = tree_parseY(Param, f);
+      if(unique_ssa_versions)
+      {
+         UniquifySSAVersions(TM);
+      }
+      return TM;
    }
    catch(const char* msg)
    {
@@ -86,3 +95,28 @@ tree_managerRef ParseTreeFile(const ParameterConstRef& Param, const std::string&
    THROW_ERROR_CODE(exit_code, "Error in tree parsing");
    return tree_managerRef();
 }
+
+void UniquifySSAVersions(const tree_managerRef& TM)
+{
+   /// The parser numbers the versions starting from 1
+   const unsigned int offset = global_uniq_vers_id - 1;
+   unsigned int max_vers = 0;
+   const unsigned int last_index = TM->get_next_available_tree_node_id();
+   for(unsigned int index = 1; index < last_index; index++)
+   {
+      if(TM->is_tree_node(index))
+      {
+         const tree_nodeRef tn = TM->get_tree_node_const(index);
+         if(tn->get_kind() == ssa_name_K)
+         {
+            auto* sn = GetPointer<ssa_name>(tn);
+            if(sn->vers > max_vers)
+            {
+               max_vers = sn->vers;
+            }
+            sn->vers += offset;
+         }
+      }
+   }
+   global_uniq_vers_id += max_vers;
+}
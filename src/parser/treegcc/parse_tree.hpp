@@ -61,10 +61,18 @@ REF_FORWARD_DECL(tree_manager);
  *
  * @param Param is the set of input parameters
  * @param f the input file name
- * @param debug_level is the the debug_level
+ * @param unique_ssa_versions specifies if the versions of the ssa_name have to be made unique with respect to the previously parsed files;
+ * if false the versions are local to the file and UniquifySSAVersions has to be called on the result; in this way different files can be parsed concurrently
  * @return the tree manager associated to the raw file.
 
 */
-tree_managerRef ParseTreeFile(const ParameterConstRef& Param, const std::string& f);
+tree_managerRef ParseTreeFile(const ParameterConstRef& Param, const std::string& f, const bool unique_ssa_versions = true);
+
+/**
+ * Renumber the versions of the ssa_name of a tree manager parsed with unique_ssa_versions set to false so that they do not overlap with the ones of the previously parsed files
+ * Note that this function is not thread safe: to have deterministic versions it must be called in the same order in which files would be parsed
+ * @param TM is the tree manager associated with a raw file
+ */
+void UniquifySSAVersions(const tree_managerRef& TM);
 
 #endif
@@ -49,6 +49,7 @@
 #include "custom_map.hpp"
 #include <cstring>
 #include <string>
+#include <unordered_map>
 
 enum class TreeVocabularyTokenTypes_TokenEnum
 {
@@ -720,14 +721,27 @@ struct treeVocabularyTokenTypes
    treeVocabularyTokenTypes();
 
  private:
-   struct ltstr
+   /// FNV-1a hash of a null terminated string; keywords are looked up for every identifier of the dump, so no std::string is built
+   struct hashstr
+   {
+      size_t operator()(const char* s) const
+      {
+         size_t ret = 2166136261u;
+         for(; *s; ++s)
+         {
+            ret = (ret ^ static_cast<unsigned char>(*s)) * 16777619u;
+         }
+         return ret;
+      }
+   };
+   struct eqstr
    {
       bool operator()(const char* s1, const char* s2) const
       {
-         return strcmp(s1, s2) < 0;
+         return strcmp(s1, s2) == 0;
       }
    };
-   std::map<const char*, int, ltstr> token_map;
+   std::unordered_map<const char*, int, hashstr, eqstr> token_map;
 };
 
 /**
@@ -65,8 +65,20 @@ struct TreeFlexLexer : public yyFlexLexer
 
    TreeFlexLexer(std::istream* argin, std::ostream* argout);
 
+   /**
+    * Constructor of a lexer which scans a memory region (e.g., a mapped file) instead of a stream
+    * @param begin is the first character of the region
+    * @param end is the character after the last one of the region
+    */
+   TreeFlexLexer(const char* begin, const char* end);
+
    ~TreeFlexLexer() override;
 
+   /**
+    * Fill the flex buffer copying from the memory region, if any, or reading from the input stream
+    */
+   int LexerInput(char* buf, int max_size) override;
+
    void yyerror(const char* msg)
    {
       LexerError(msg);
@@ -87,6 +99,13 @@ struct TreeFlexLexer : public yyFlexLexer
    treeVocabularyTokenTypes* tokens;
 
    TreeVocabularyTokenTypes_TokenEnum bison2token(int) const;
+
+ private:
+   /// The next character of the memory region to be scanned (nullptr if the input is a stream)
+   const char* input_position;
+
+   /// The end of the memory region to be scanned
+   const char* input_end;
 };
 
 #endif
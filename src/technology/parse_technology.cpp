@@ -90,7 +90,7 @@ void read_technology_File(const std::string& fn, const technology_managerRef& TM
    try
    {
       XMLDomParser parser(fn);
-      parser.Exec();
+      parser.Exec(Param->getOption<std::string>(OPT_technology_cache_directory));
       if(parser)
       {
          // Walk the tree:
@@ -183,7 +183,7 @@ void FPGA_device::load_devices(const target_deviceRef device)
 
       for(const auto& parser : parsers)
       {
-         parser->Exec();
+         parser->Exec(Param->getOption<std::string>(OPT_technology_cache_directory));
          if(parser and *parser)
          {
             const xml_element* node = parser->get_document()->get_root_node(); // deleted by DomParser.
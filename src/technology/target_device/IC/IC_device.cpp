@@ -145,7 +145,7 @@ void IC_device::load_devices(const target_deviceRef device)
    try
    {
       XMLDomParser parser("builtin_technology", builtin_technology);
-      parser.Exec();
+      parser.Exec(Param->getOption<std::string>(OPT_technology_cache_directory));
       if(parser)
       {
          // Walk the tree:
@@ -164,7 +164,7 @@ void IC_device::load_devices(const target_deviceRef device)
 
          PRINT_OUT_MEX(OUTPUT_LEVEL_MINIMUM, output_level, "(target device) Loading information about the target device from file \"" + file_name + "\"");
          XMLDomParser parser1(file_name);
-         parser1.Exec();
+         parser1.Exec(Param->getOption<std::string>(OPT_technology_cache_directory));
          if(parser1)
          {
             // Walk the tree:
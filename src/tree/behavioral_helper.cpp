@@ -107,12 +107,12 @@
 /// wrapper/treegcc include
 #include "gcc_wrapper.hpp"
 
-std::map<std::string, unsigned int> BehavioralHelper::used_name;
-
 std::map<unsigned int, std::string> BehavioralHelper::vars_symbol_table;
 
 std::map<unsigned int, std::string> BehavioralHelper::vars_renaming_table;
 
+std::mutex BehavioralHelper::symbol_tables_mutex;
+
 /// Max length of a row (at the moment checked only during constructor printing)
 #define MAX_ROW_LENGTH 128
 
@@ -542,12 +542,23 @@ std::string BehavioralHelper::print_attributes(unsigned int var, const var_pp_fu
 
 std::string BehavioralHelper::PrintVariable(unsigned int var) const
 {
-   if(vars_renaming_table.find(var) != vars_renaming_table.end())
-      return vars_renaming_table.find(var)->second;
-   if(vars_symbol_table[var] != "")
    {
-      return vars_symbol_table[var];
+      const std::lock_guard<std::mutex> lock(symbol_tables_mutex);
+      const auto renamed = vars_renaming_table.find(var);
+      if(renamed != vars_renaming_table.end())
+         return renamed->second;
+      const auto symbol = vars_symbol_table.find(var);
+      if(symbol != vars_symbol_table.end() and symbol->second != "")
+      {
+         return symbol->second;
+      }
    }
+   /// the lock is not held while the name is computed, since it can print other variables and create tree nodes
+   const auto store_symbol = [&var](const std::string& name) -> std::string {
+      const std::lock_guard<std::mutex> lock(symbol_tables_mutex);
+      vars_symbol_table[var] = name;
+      return name;
+   };
    if(var == default_COND)
       return "default";
    const tree_nodeRef temp = TM->get_tree_node_const(var);
@@ -556,16 +567,14 @@ std::string BehavioralHelper::PrintVariable(unsigned int var) const
       auto* ir = GetPointer<indirect_ref>(temp);
       unsigned int pointer = GET_INDEX_NODE(ir->op);
       std::string pointer_name = PrintVariable(pointer);
-      vars_symbol_table[var] = "*" + pointer_name;
-      return vars_symbol_table[var];
+      return store_symbol("*" + pointer_name);
    }
    if(temp->get_kind() == misaligned_indirect_ref_K)
    {
       auto* mir = GetPointer<misaligned_indirect_ref>(temp);
       unsigned int pointer = GET_INDEX_NODE(mir->op);
       std::string pointer_name = PrintVariable(pointer);
-      vars_symbol_table[var] = "*" + pointer_name;
-      return vars_symbol_table[var];
+      return store_symbol("*" + pointer_name);
    }
    if(temp->get_kind() == mem_ref_K)
    {
@@ -576,16 +585,14 @@ std::string BehavioralHelper::PrintVariable(unsigned int var) const
       const unsigned int pointer_type = tm->create_pointer_type(mr->type, 8)->index;
       const std::string type_string = tree_helper::print_type(TM, pointer_type);
       if(offset == 0)
-         vars_symbol_table[var] = "*((" + type_string + ")(" + PrintVariable(GET_INDEX_NODE(mr->op0)) + "))";
+         return store_symbol("*((" + type_string + ")(" + PrintVariable(GET_INDEX_NODE(mr->op0)) + "))");
       else
-         vars_symbol_table[var] = "*((" + type_string + ")(((unsigned char*)" + PrintVariable(GET_INDEX_NODE(mr->op0)) + ") + " + boost::lexical_cast<std::string>(offset) + "))";
-      return vars_symbol_table[var];
+         return store_symbol("*((" + type_string + ")(((unsigned char*)" + PrintVariable(GET_INDEX_NODE(mr->op0)) + ") + " + boost::lexical_cast<std::string>(offset) + "))");
    }
    if(temp->get_kind() == identifier_node_K)
    {
       auto* in = GetPointer<identifier_node>(temp);
-      vars_symbol_table[var] = in->strg;
-      return vars_symbol_table[var];
+      return store_symbol(in->strg);
    }
    if(temp->get_kind() == field_decl_K)
    {
@@ -632,15 +639,15 @@ std::string BehavioralHelper::PrintVariable(unsigned int var) const
       if(dn->name)
       {
          auto* id = GetPointer<identifier_node>(GET_NODE(dn->name));
-         vars_symbol_table[var] = tree_helper::normalized_ID(id->strg);
-         return vars_symbol_table[var];
+         return store_symbol(tree_helper::normalized_ID(id->strg));
       }
    }
+   std::string name;
    if(is_a_constant(var))
-      vars_symbol_table[var] = print_constant(var);
-   if(vars_symbol_table[var] == "")
-      vars_symbol_table[var] = INTERNAL + boost::lexical_cast<std::string>(var);
-   return vars_symbol_table[var];
+      name = print_constant(var);
+   if(name == "")
+      name = INTERNAL + boost::lexical_cast<std::string>(var);
+   return store_symbol(name);
 }
 
 std::string BehavioralHelper::print_constant(unsigned int var, const var_pp_functorConstRef vppf) const
@@ -5432,11 +5439,13 @@ std::string BehavioralHelper::print_type(unsigned int type, bool global, bool pr
 
 void BehavioralHelper::rename_a_variable(unsigned int var, const std::string& new_name)
 {
+   const std::lock_guard<std::mutex> lock(symbol_tables_mutex);
    vars_renaming_table[var] = new_name;
 }
 
 void BehavioralHelper::clear_renaming_table()
 {
+   const std::lock_guard<std::mutex> lock(symbol_tables_mutex);
    vars_renaming_table.clear();
 }
 
@@ -5767,8 +5776,6 @@ bool BehavioralHelper::IsLut(const unsigned int statement_index) const
 
 void BehavioralHelper::InvaildateVariableName(const unsigned int index)
 {
-   if(vars_symbol_table.find(index) != vars_symbol_table.end())
-   {
-      vars_symbol_table.erase(vars_symbol_table.find(index));
-   }
+   const std::lock_guard<std::mutex> lock(symbol_tables_mutex);
+   vars_symbol_table.erase(index);
 }
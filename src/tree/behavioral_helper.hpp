@@ -52,6 +52,7 @@
 #include "custom_set.hpp" // for set
 #include "custom_set.hpp"
 #include <list>   // for list
+#include <mutex>
 #include <string> // for string
 #include <tuple>
 #include <utility> // for pair
@@ -93,18 +94,15 @@ class BehavioralHelper
    /// the debug level
    int debug_level;
 
-   /// Maps between unqualified type and definition of a corresponding qualified type
-   static std::map<unsigned int, std::pair<std::string, int>> definitions;
-
-   /// Set of variables name already used
-   static std::map<std::string, unsigned int> used_name;
-
    /// The var symbol table
    static std::map<unsigned int, std::string> vars_symbol_table;
 
    /// Variable renaming table
    static std::map<unsigned int, std::string> vars_renaming_table;
 
+   /// The mutex protecting vars_symbol_table and vars_renaming_table, which are shared by the helpers of the functions processed concurrently
+   static std::mutex symbol_tables_mutex;
+
    /// Index of the function
    unsigned int function_index;
 
@@ -46,16 +46,19 @@
 /// Autoheader include
 #include "config_HAVE_CODE_ESTIMATION_BUILT.hpp"
 #include "config_HAVE_MAPPING_BUILT.hpp"
+#include "config_HAVE_OPENMP.hpp"
 #include "config_NPROFILE.hpp"
 
 /// Header include
-#include "exceptions.hpp"          // for THROW_ASSERT, THROW...
-#include "string_manipulation.hpp" // for STR GET_CLASS
+#include "concurrent_execution.hpp" // for ConcurrentExecution
+#include "exceptions.hpp"           // for THROW_ASSERT, THROW...
+#include "string_manipulation.hpp"  // for STR GET_CLASS
 #include "tree_manager.hpp"
 #include <cstring>  // for strlen, size_t
 #include <fstream>  // for operator<<, basic_o...
 #include <iostream> // for operator<<, basic_o...
 #include <list>     // for list
+#include <sstream>  // for ostringstream
 #include <vector>   // for vector, allocator
 
 /// Machine include
@@ -89,8 +92,11 @@
 #include "dbgPrintHelper.hpp"
 #include "utility.hpp"
 
+#include <boost/preprocessor/seq/for_each.hpp>
+
 tree_manager::tree_manager(const ParameterConstRef& _Param)
-    : n_pl(0),
+    : arena(new TreeNodeArena()),
+      n_pl(0),
       added_goto(0),
       removed_pointer_plus(0),
       removable_pointer_plus(0),
@@ -99,12 +105,24 @@ tree_manager::tree_manager(const ParameterConstRef& _Param)
       last_node_id(1),
       Param(_Param),
       next_vers(0),
-      collapse_into_counter(0)
+      collapse_into_counter(0),
+      merge_next_node_id(0)
 {
 }
 
 tree_manager::~tree_manager() = default;
 
+std::unique_lock<std::recursive_mutex> tree_manager::ConcurrentLock() const
+{
+#if HAVE_OPENMP
+   if(ConcurrentExecution::IsRunning())
+   {
+      return std::unique_lock<std::recursive_mutex>(concurrent_access_mutex);
+   }
+#endif
+   return std::unique_lock<std::recursive_mutex>();
+}
+
 unsigned int tree_manager::get_implementation_node(unsigned int decl_node) const
 {
    THROW_ASSERT(GetPointer<function_decl>(get_tree_node_const(decl_node)), "Node " + STR(decl_node) + " is not a function decl: " + get_tree_node_const(decl_node)->get_kind_text());
@@ -120,56 +138,75 @@ unsigned int tree_manager::get_implementation_node(unsigned int decl_node) const
 
 void tree_manager::AddTreeNode(unsigned int i, const tree_nodeRef& curr)
 {
+   const auto lock = ConcurrentLock();
    THROW_ASSERT(i > 0, "Expected a positive index");
    THROW_ASSERT(curr, "Invalid tree node: " + STR(i));
-   if(i >= last_node_id)
-   {
-      last_node_id = i + 1;
-   }
+   GetTreeReindex(i);
    tree_nodes[i] = curr;
 }
 
 tree_nodeRef tree_manager::GetTreeReindex(unsigned int index)
 {
+   const auto lock = ConcurrentLock();
    THROW_ASSERT(index > 0, "Expected a positive index (" + STR(index) + ")");
    if(index >= last_node_id)
    {
       last_node_id = index + 1;
    }
-   return tree_nodeRef(new tree_reindex(index, tree_nodes[index]));
+   if(index >= tree_reindexes.size())
+   {
+      tree_reindexes.resize(index + 1);
+   }
+   auto& reindex = tree_reindexes[index];
+   if(not reindex)
+   {
+      reindex = tree_nodeRef(new tree_reindex(index, tree_nodes[index]));
+   }
+   return reindex;
 }
 
 const tree_nodeRef tree_manager::CGetTreeReindex(const unsigned int i) const
 {
+   const auto lock = ConcurrentLock();
    THROW_ASSERT(i > 0 and i < last_node_id, "(C) Expected a positive index less than the total number of tree nodes (" + STR(i) + ") (" + STR(last_node_id) + ")");
-   THROW_ASSERT(tree_nodes.find(i) != tree_nodes.end(), "Tree node " + STR(i) + " does not exist");
-   return tree_nodeRef(new tree_reindex(i, tree_nodes.at(i)));
+   THROW_ASSERT(is_tree_node(i), "Tree node " + STR(i) + " does not exist");
+   return tree_reindexes[i];
 }
 
-tree_nodeRef tree_manager::GetTreeNode(const unsigned int index) const
+const tree_nodeRef& tree_manager::GetTreeNode(const unsigned int index) const
 {
-   THROW_ASSERT(tree_nodes.find(index) != tree_nodes.end(), "Tree node with index " + STR(index) + " not found");
-   return tree_nodes.find(index)->second;
+   const auto lock = ConcurrentLock();
+   THROW_ASSERT(is_tree_node(index), "Tree node with index " + STR(index) + " not found");
+   return static_cast<const tree_reindex*>(tree_reindexes[index].get())->actual_tree_node;
 }
 
-const tree_nodeRef tree_manager::get_tree_node_const(unsigned int i) const
+const tree_nodeRef& tree_manager::get_tree_node_const(unsigned int i) const
 {
+   const auto lock = ConcurrentLock();
    THROW_ASSERT(i > 0 and i < last_node_id, "(C) Expected a positive index less than the total number of tree nodes (" + STR(i) + ") (" + STR(last_node_id) + ")");
-   THROW_ASSERT(tree_nodes.find(i) != tree_nodes.end(), "Tree node " + STR(i) + " does not exist");
-   THROW_ASSERT(tree_nodes.find(i)->second, "Tree node " + STR(i) + " is empty");
-   return tree_nodes.find(i)->second;
+   THROW_ASSERT(is_tree_node(i), "Tree node " + STR(i) + " does not exist");
+   THROW_ASSERT(GetTreeNode(i), "Tree node " + STR(i) + " is empty");
+   return static_cast<const tree_reindex*>(tree_reindexes[i].get())->actual_tree_node;
 }
 
 const tree_nodeConstRef tree_manager::CGetTreeNode(const unsigned int i) const
 {
+   const auto lock = ConcurrentLock();
    THROW_ASSERT(i > 0 and i < last_node_id, "(C) Expected a positive index less than the total number of tree nodes (" + STR(i) + ") (" + STR(last_node_id) + ")");
-   THROW_ASSERT(tree_nodes.find(i) != tree_nodes.end(), "Tree node " + STR(i) + " does not exist");
-   return tree_nodes.find(i)->second;
+   THROW_ASSERT(is_tree_node(i), "Tree node " + STR(i) + " does not exist");
+   return static_cast<const tree_reindex*>(tree_reindexes[i].get())->actual_tree_node;
 }
 
 bool tree_manager::is_tree_node(unsigned int i) const
 {
-   return tree_nodes.find(i) != tree_nodes.end();
+   const auto lock = ConcurrentLock();
+   return i < tree_reindexes.size() and tree_reindexes[i];
+}
+
+size_t tree_manager::GetAllocatedSize() const
+{
+   const auto lock = ConcurrentLock();
+   return arena->GetAllocatedSize();
 }
 
 // *****************************************************************************************
@@ -181,6 +218,7 @@ unsigned int tree_manager::find_sc_main_node() const
 
 unsigned int tree_manager::function_index(const std::string& function_name) const
 {
+   const auto lock = ConcurrentLock();
    null_deleter null_del;
    tree_managerConstRef TM(this, null_del);
    unsigned int function_id = 0;
@@ -258,6 +296,7 @@ void tree_manager::PrintGimple(std::ostream& os, const bool use_uid) const
 
 void tree_manager::create_tree_node(const unsigned int node_id, enum kind tree_node_type, std::map<TreeVocabularyTokenTypes_TokenEnum, std::string>& tree_node_schema)
 {
+   const auto lock = ConcurrentLock();
 #ifndef NDEBUG
    int function_debug_level = Param->GetFunctionDebugLevel(GET_CLASS(*this), __func__);
 #endif
@@ -268,6 +307,7 @@ void tree_manager::create_tree_node(const unsigned int node_id, enum kind tree_n
 
 unsigned int tree_manager::new_tree_node_id(const unsigned int ask)
 {
+   const auto lock = ConcurrentLock();
    if(ask and tree_nodes.find(ask) == tree_nodes.end())
    {
       GetTreeReindex(ask);
@@ -280,11 +320,13 @@ unsigned int tree_manager::new_tree_node_id(const unsigned int ask)
 
 unsigned int tree_manager::get_next_available_tree_node_id() const
 {
+   const auto lock = ConcurrentLock();
    return last_node_id;
 }
 
 void tree_manager::add_function(unsigned int index, tree_nodeRef curr)
 {
+   const auto lock = ConcurrentLock();
    function_decl_nodes[index] = curr;
 }
 
@@ -295,6 +337,7 @@ unsigned long tree_manager::get_function_decl_node_n() const
 
 unsigned int tree_manager::find(enum kind tree_node_type, const std::map<TreeVocabularyTokenTypes_TokenEnum, std::string>& tree_node_schema)
 {
+   const auto lock = ConcurrentLock();
    if(tree_node_type == identifier_node_K)
    {
       std::string id;
@@ -344,6 +387,7 @@ unsigned int tree_manager::find(enum kind tree_node_type, const std::map<TreeVoc
 
 void tree_manager::collapse_into(const unsigned int& funID, CustomUnorderedMapUnstable<unsigned int, unsigned int>& stmt_to_bloc, const tree_nodeRef& tn, CustomUnorderedSet<unsigned int>& removed_nodes)
 {
+   const auto lock = ConcurrentLock();
    THROW_ASSERT(tn->get_kind() == tree_reindex_K, "Node is not a tree reindex");
    const unsigned int tree_node_index = GET_INDEX_NODE(tn);
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Collapsing into " + STR(tree_node_index) + " (" + std::string(GET_NODE(tn)->get_kind_text()) + "): " + tn->ToString());
@@ -880,6 +924,7 @@ void tree_manager::collapse_into(const unsigned int& funID, CustomUnorderedMapUn
 
 void tree_manager::ReplaceTreeNode(const tree_nodeRef& stmt, const tree_nodeRef& old_node, const tree_nodeRef& new_node)
 {
+   const auto lock = ConcurrentLock();
    THROW_ASSERT(GetPointer<const gimple_node>(GET_NODE(stmt)), "Replacing ssa name starting from " + stmt->ToString());
    THROW_ASSERT(not GetPointer<const gimple_node>(GET_NODE(new_node)), "new node cannot be a gimple_node");
    THROW_ASSERT(not GetPointer<const gimple_node>(GET_NODE(old_node)), "old node cannot be a gimple_node: " + STR(old_node));
@@ -1703,82 +1748,76 @@ unsigned int tree_manager::get_n_pl() const
    return n_pl;
 }
 
-void tree_manager::merge_tree_managers(const tree_managerRef& source_tree_manager)
+void tree_manager::UpdateMergeSymbolTables()
 {
-   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Starting merging of new tree_manager");
-   /// a declaration is uniquely identified by the name and by the scope
-   /// in case the decl_node has a mangle the associated identifier_node is unique
-   /// a decl_node without name is not added to the symbol table
-   /// a decl_node local to a function_decl (scpe is a function_decl) is not added to the symbol table
-   /// a decl_node local to a type_node without name is not added to the symbol table
-   /// a static decl_node is not added to the symbol table
-   /// memory_tag, parm_decl, result_decl are not added to the symbol table
-   /// declaration with type_node local to a function are not considered
-   /// the key of the declaration symbol table is structured as "name--scope"
-   /// the value of the declaration symbol table is the nodeID of the tree_node in the tree_manager
-   CustomUnorderedMapUnstable<std::string, unsigned int> global_decl_symbol_table;
-
-   /// a type_node without name is not added to the symbol table
-   /// a type_node local to a function_decl is not added to the symbol table
-   /// the key of the type symbol table is structured as "name"
-   /// the value of the type symbol table is the nodeID of the tree_node in the tree_manager
-   CustomUnorderedMapUnstable<std::string, unsigned int> global_type_symbol_table;
-
-   /// this table is used to give a name to unqualified record or union
-   CustomUnorderedMap<unsigned int, std::string> global_type_unql_symbol_table;
-   /// global static variable and function become global so we need some sort of uniquification
-   CustomUnorderedSet<std::string> static_symbol_table;
-   CustomUnorderedSet<std::string> static_function_header_symbol_table;
    null_deleter nullDel;
    tree_managerRef TM_this(this, nullDel);
-   if(debug_level >= DEBUG_LEVEL_PEDANTIC)
+   /// only the tree nodes created after the previous merge and the ones overwritten by it have to be examined
+   std::map<unsigned int, tree_nodeRef> examined_nodes;
+   if(merge_next_node_id == 0)
    {
-      std::string raw_file_name = Param->getOption<std::string>(OPT_output_temporary_directory) + "before_tree_merge_" + STR(get_next_available_tree_node_id()) + ".raw";
-      std::ofstream raw_file(raw_file_name.c_str());
-      raw_file << TM_this;
-      raw_file.close();
+      merge_decl_symbol_table.clear();
+      merge_type_symbol_table.clear();
+      merge_type_unql_symbol_table.clear();
+      merge_static_symbol_table.clear();
+      merge_static_function_header_symbol_table.clear();
+      examined_nodes.insert(tree_nodes.begin(), tree_nodes.end());
    }
-
+   else
+   {
+      for(unsigned int node_id = merge_next_node_id; node_id < last_node_id; node_id++)
+      {
+         const auto tn = tree_nodes.find(node_id);
+         if(tn != tree_nodes.end())
+            examined_nodes.insert(*tn);
+      }
+      for(const auto node_id : merge_overwritten_nodes)
+      {
+         examined_nodes.insert(*tree_nodes.find(node_id));
+      }
+   }
+   merge_overwritten_nodes.clear();
+   merge_next_node_id = last_node_id;
    /// build the symbol tables of tree_node inheriting from type_node and then from decl_node; decl_nodes have to be examinated later since they have to be examinated after the record/union types???
-   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Building the global symbol table of this tree manager");
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Updating the global symbol table of this tree manager with " + STR(examined_nodes.size()) + " tree nodes");
    std::string symbol_name;
    std::string symbol_scope;
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Checking types");
-   for(const auto ti : tree_nodes)
+   for(const auto& ti : examined_nodes)
    {
       const tree_nodeRef tn = ti.second;
       auto* dn = GetPointer<decl_node>(tn);
       if(not dn)
       {
          INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Checking " + STR(ti.first));
-         if(check_for_type(tn, TM_this, symbol_name, symbol_scope, global_type_symbol_table, ti.first))
+         if(check_for_type(tn, TM_this, symbol_name, symbol_scope, merge_type_symbol_table, ti.first))
          {
             INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Is NOT inserted in the symbol table");
             continue;
          }
          else
          {
-            THROW_ASSERT(global_type_symbol_table.find(symbol_name) == global_type_symbol_table.end(),
-                         "duplicated symbol in global_type_symbol_table: " + global_type_symbol_table.find(symbol_name)->first + " " + STR(global_type_symbol_table.find(symbol_name)->second) + " " + STR(ti.first));
+            THROW_ASSERT(merge_type_symbol_table.find(symbol_name) == merge_type_symbol_table.end() or merge_type_symbol_table.find(symbol_name)->second == ti.first,
+                         "duplicated symbol in merge_type_symbol_table: " + merge_type_symbol_table.find(symbol_name)->first + " " + STR(merge_type_symbol_table.find(symbol_name)->second) + " " + STR(ti.first));
             INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Is INSERTED in the symbol table " + symbol_name + " --> " + STR(ti.first));
-            global_type_symbol_table[symbol_name] = ti.first;
+            merge_type_symbol_table[symbol_name] = ti.first;
             /// give a name to unql where possible
             if(tn->get_kind() == record_type_K and GetPointer<record_type>(tn)->unql and GetPointer<record_type>(tn)->qual == TreeVocabularyTokenTypes_TokenEnum::FIRST_TOKEN)
             {
-               global_type_symbol_table["u struct " + symbol_name] = GET_INDEX_NODE(GetPointer<record_type>(tn)->unql);
-               global_type_unql_symbol_table[GET_INDEX_NODE(GetPointer<record_type>(tn)->unql)] = "u struct " + symbol_name;
+               merge_type_symbol_table["u struct " + symbol_name] = GET_INDEX_NODE(GetPointer<record_type>(tn)->unql);
+               merge_type_unql_symbol_table[GET_INDEX_NODE(GetPointer<record_type>(tn)->unql)] = "u struct " + symbol_name;
             }
             else if(tn->get_kind() == union_type_K and GetPointer<union_type>(tn)->unql and GetPointer<union_type>(tn)->qual == TreeVocabularyTokenTypes_TokenEnum::FIRST_TOKEN)
             {
-               global_type_symbol_table["u union " + symbol_name] = GET_INDEX_NODE(GetPointer<union_type>(tn)->unql);
-               global_type_unql_symbol_table[GET_INDEX_NODE(GetPointer<union_type>(tn)->unql)] = "u union " + symbol_name;
+               merge_type_symbol_table["u union " + symbol_name] = GET_INDEX_NODE(GetPointer<union_type>(tn)->unql);
+               merge_type_unql_symbol_table[GET_INDEX_NODE(GetPointer<union_type>(tn)->unql)] = "u union " + symbol_name;
             }
          }
       }
    }
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Checked types");
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Checking declarations");
-   for(const auto& ti : tree_nodes)
+   for(const auto& ti : examined_nodes)
    {
       /// check for decl_node
       const tree_nodeRef tn = ti.second;
@@ -1786,7 +1825,7 @@ void tree_manager::merge_tree_managers(const tree_managerRef& source_tree_manage
       if(dn)
       {
          INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Checking " + STR(ti.first));
-         if(check_for_decl(tn, TM_this, symbol_name, symbol_scope, ti.first, global_type_unql_symbol_table))
+         if(check_for_decl(tn, TM_this, symbol_name, symbol_scope, ti.first, merge_type_unql_symbol_table))
          {
             INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Is NOT inserted in the symbol table");
             continue;
@@ -1798,23 +1837,23 @@ void tree_manager::merge_tree_managers(const tree_managerRef& source_tree_manage
             if((GetPointer<function_decl>(tn) and GetPointer<function_decl>(tn)->static_flag) or (GetPointer<var_decl>(tn) and (GetPointer<var_decl>(tn)->static_flag or GetPointer<var_decl>(tn)->static_static_flag)))
             {
                INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Static declaration");
-               THROW_ASSERT((GetPointer<function_decl>(tn) and GetPointer<function_decl>(tn)->body) or (GetPointer<var_decl>(tn) and static_symbol_table.find(symbol_name + "-" + symbol_scope) == static_symbol_table.end()) or
-                                (GetPointer<function_decl>(tn) and not GetPointer<function_decl>(tn)->body and static_function_header_symbol_table.find(symbol_name + "-" + symbol_scope) == static_function_header_symbol_table.end()),
+               THROW_ASSERT((GetPointer<function_decl>(tn) and GetPointer<function_decl>(tn)->body) or (GetPointer<var_decl>(tn) and merge_static_symbol_table.find(symbol_name + "-" + symbol_scope) == merge_static_symbol_table.end()) or
+                                (GetPointer<function_decl>(tn) and not GetPointer<function_decl>(tn)->body and merge_static_function_header_symbol_table.find(symbol_name + "-" + symbol_scope) == merge_static_function_header_symbol_table.end()),
                             "duplicated static symbol in the current tree_manager: " + symbol_name + "-" + symbol_scope + " " + STR(ti.first));
                if(GetPointer<function_decl>(tn) and !GetPointer<function_decl>(tn)->body)
                {
-                  static_function_header_symbol_table.insert(symbol_name + "-" + symbol_scope);
+                  merge_static_function_header_symbol_table.insert(symbol_name + "-" + symbol_scope);
                }
                else
                {
-                  static_symbol_table.insert(symbol_name + "-" + symbol_scope);
+                  merge_static_symbol_table.insert(symbol_name + "-" + symbol_scope);
                }
                continue;
             }
             /// check for function_decl undefined
-            if(dn->get_kind() == function_decl_K and global_decl_symbol_table.find(symbol_name + "-" + symbol_scope) != global_decl_symbol_table.end())
+            if(dn->get_kind() == function_decl_K and merge_decl_symbol_table.find(symbol_name + "-" + symbol_scope) != merge_decl_symbol_table.end())
             {
-               if(GetPointer<function_decl>(tree_nodes.find(global_decl_symbol_table.find(symbol_name + "-" + symbol_scope)->second)->second)->body)
+               if(GetPointer<function_decl>(tree_nodes.find(merge_decl_symbol_table.find(symbol_name + "-" + symbol_scope)->second)->second)->body)
                {
                   continue;
                }
@@ -1824,9 +1863,9 @@ void tree_manager::merge_tree_managers(const tree_managerRef& source_tree_manage
                }
                // else do overwrite
             }
-            else if(dn->get_kind() == var_decl_K and global_decl_symbol_table.find(symbol_name + "-" + symbol_scope) != global_decl_symbol_table.end())
+            else if(dn->get_kind() == var_decl_K and merge_decl_symbol_table.find(symbol_name + "-" + symbol_scope) != merge_decl_symbol_table.end())
             {
-               if(!GetPointer<var_decl>(tree_nodes.find(global_decl_symbol_table.find(symbol_name + "-" + symbol_scope)->second)->second)->extern_flag)
+               if(!GetPointer<var_decl>(tree_nodes.find(merge_decl_symbol_table.find(symbol_name + "-" + symbol_scope)->second)->second)->extern_flag)
                {
                   continue;
                }
@@ -1838,19 +1877,61 @@ void tree_manager::merge_tree_managers(const tree_managerRef& source_tree_manage
             }
             else if(dn->get_kind() != function_decl_K && dn->get_kind() != var_decl_K && dn->get_kind() != type_decl_K)
             {
-               // THROW_ASSERT(global_decl_symbol_table.find(symbol_name+"-"+symbol_scope) == global_decl_symbol_table.end(), "duplicated symbol in global_decl_symbol_table: "+global_decl_symbol_table.find(symbol_name+"-"+symbol_scope)->first + " == " +
+               // THROW_ASSERT(merge_decl_symbol_table.find(symbol_name+"-"+symbol_scope) == merge_decl_symbol_table.end(), "duplicated symbol in merge_decl_symbol_table: "+merge_decl_symbol_table.find(symbol_name+"-"+symbol_scope)->first + " == " +
                // boost::lexical_cast<std::string>(ti.first));
                continue;
             }
 
             INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Adding to global declaration table " + symbol_name + "-" + symbol_scope + " (" + STR(ti.first) + ")");
 
-            global_decl_symbol_table[symbol_name + "-" + symbol_scope] = ti.first;
+            merge_decl_symbol_table[symbol_name + "-" + symbol_scope] = ti.first;
          }
       }
    }
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Checked declarations");
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--");
+}
+
+void tree_manager::merge_tree_managers(const tree_managerRef& source_tree_manager)
+{
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Starting merging of new tree_manager");
+   /// the symbol tables of this tree manager are copied below since during the merge they are extended also with indices of the source tree manager
+   UpdateMergeSymbolTables();
+   /// a declaration is uniquely identified by the name and by the scope
+   /// in case the decl_node has a mangle the associated identifier_node is unique
+   /// a decl_node without name is not added to the symbol table
+   /// a decl_node local to a function_decl (scpe is a function_decl) is not added to the symbol table
+   /// a decl_node local to a type_node without name is not added to the symbol table
+   /// a static decl_node is not added to the symbol table
+   /// memory_tag, parm_decl, result_decl are not added to the symbol table
+   /// declaration with type_node local to a function are not considered
+   /// the key of the declaration symbol table is structured as "name--scope"
+   /// the value of the declaration symbol table is the nodeID of the tree_node in the tree_manager
+   CustomUnorderedMapUnstable<std::string, unsigned int> global_decl_symbol_table = merge_decl_symbol_table;
+
+   /// a type_node without name is not added to the symbol table
+   /// a type_node local to a function_decl is not added to the symbol table
+   /// the key of the type symbol table is structured as "name"
+   /// the value of the type symbol table is the nodeID of the tree_node in the tree_manager
+   CustomUnorderedMapUnstable<std::string, unsigned int> global_type_symbol_table = merge_type_symbol_table;
+
+   /// this table is used to give a name to unqualified record or union
+   CustomUnorderedMap<unsigned int, std::string> global_type_unql_symbol_table = merge_type_unql_symbol_table;
+   /// global static variable and function become global so we need some sort of uniquification
+   CustomUnorderedSet<std::string> static_symbol_table = merge_static_symbol_table;
+   CustomUnorderedSet<std::string> static_function_header_symbol_table = merge_static_function_header_symbol_table;
+   null_deleter nullDel;
+   tree_managerRef TM_this(this, nullDel);
+   if(debug_level >= DEBUG_LEVEL_PEDANTIC)
+   {
+      std::string raw_file_name = Param->getOption<std::string>(OPT_output_temporary_directory) + "before_tree_merge_" + STR(get_next_available_tree_node_id()) + ".raw";
+      std::ofstream raw_file(raw_file_name.c_str());
+      raw_file << TM_this;
+      raw_file.close();
+   }
+
+   std::string symbol_name;
+   std::string symbol_scope;
 
    auto gtust_i_end = global_type_unql_symbol_table.end();
    for(auto gtust_i = global_type_unql_symbol_table.begin(); gtust_i != gtust_i_end; ++gtust_i)
@@ -2261,6 +2342,10 @@ void tree_manager::merge_tree_managers(const tree_managerRef& source_tree_manage
 
       INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "Type is " + std::string(source_tree_manager->get_tree_node_const(*it_not_yet_remapped)->get_kind_text()));
       INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "DONE");
+      if(remap[*it_not_yet_remapped] < merge_next_node_id)
+      {
+         merge_overwritten_nodes.insert(remap[*it_not_yet_remapped]);
+      }
    }
    if(debug_level >= DEBUG_LEVEL_PEDANTIC)
    {
@@ -2474,7 +2559,13 @@ bool tree_manager::check_for_type(const tree_nodeRef& tn, const tree_managerRef&
 
 unsigned int tree_manager::find_identifier_nodeID(const std::string& str) const
 {
-   auto it = identifiers_unique_table.find(str);
+   InternedString interned;
+   if(!InternedString::Find(str, interned))
+   {
+      return 0;
+   }
+   const auto lock = ConcurrentLock();
+   auto it = identifiers_unique_table.find(interned);
    if(it == identifiers_unique_table.end())
    {
       return 0;
@@ -2487,6 +2578,7 @@ unsigned int tree_manager::find_identifier_nodeID(const std::string& str) const
 
 void tree_manager::add_identifier_node(unsigned int nodeID, const bool& ASSERT_PARAMETER(op))
 {
+   const auto lock = ConcurrentLock();
    THROW_ASSERT(op, "improper use of add_identifier_node");
    identifiers_unique_table[STOK(TOK_OPERATOR)] = nodeID;
 }
@@ -2504,6 +2596,7 @@ const CustomUnorderedSet<unsigned int> tree_manager::GetAllFunctions() const
 
 unsigned int tree_manager::get_next_vers()
 {
+   const auto lock = ConcurrentLock();
    if(next_vers == 0)
    {
       for(const auto& ti : tree_nodes)
@@ -2531,6 +2624,7 @@ unsigned int tree_manager::get_next_vers()
 
 void tree_manager::add_goto()
 {
+   const auto lock = ConcurrentLock();
    added_goto++;
 }
 
@@ -2541,6 +2635,7 @@ unsigned int tree_manager::get_added_goto() const
 
 void tree_manager::increment_removed_pointer_plus()
 {
+   const auto lock = ConcurrentLock();
    removed_pointer_plus++;
 }
 
@@ -2551,6 +2646,7 @@ unsigned int tree_manager::get_removed_pointer_plus() const
 
 void tree_manager::increment_removable_pointer_plus()
 {
+   const auto lock = ConcurrentLock();
    removable_pointer_plus++;
 }
 
@@ -2561,6 +2657,7 @@ unsigned int tree_manager::get_removable_pointer_plus() const
 
 void tree_manager::increment_unremoved_pointer_plus()
 {
+   const auto lock = ConcurrentLock();
    unremoved_pointer_plus++;
 }
 
@@ -2571,6 +2668,7 @@ unsigned int tree_manager::get_unremoved_pointer_plus() const
 
 tree_nodeRef tree_manager::CreateUniqueIntegerCst(long long int value, unsigned int type_index)
 {
+   const auto lock = ConcurrentLock();
    auto key = std::make_pair(value, type_index);
    if(unique_integer_cst_map.find(key) != unique_integer_cst_map.end())
    {
@@ -2590,6 +2688,157 @@ tree_nodeRef tree_manager::CreateUniqueIntegerCst(long long int value, unsigned
    }
 }
 
+/// The classes of the tree nodes which can be stored in the tree_manager; none and tree_reindex are not copied
+#define CLONED_MISCELLANEOUS_OBJ_TREE_NODES \
+   (baselink)(binfo)(block)(constructor)(ctor_initializer)(error_mark)(expr_stmt)(handler)(identifier_node)(null_node)(overload)(return_stmt)(ssa_name)(statement_list)(template_parm_index)(tree_list)(tree_vec)(try_block)
+
+#define CLONED_TREE_NODES                                                                                                                                                        \
+   BINARY_EXPRESSION_TREE_NODES CONST_OBJ_TREE_NODES DECL_NODE_TREE_NODES GIMPLE_NODES MISCELLANEOUS_EXPR_TREE_NODES CLONED_MISCELLANEOUS_OBJ_TREE_NODES PANDA_EXTENSION_TREE_NODES \
+       QUATERNARY_EXPRESSION_TREE_NODES TERNARY_EXPRESSION_TREE_NODES TYPE_NODE_TREE_NODES UNARY_EXPRESSION_TREE_NODES
+
+#define CLONE_TREE_NODE_CASE(r, data, elem) \
+   case BOOST_PP_CAT(elem, _K):            \
+      return RefcountAllocate<elem>(TreeNodeAllocator<elem>(target_arena), *static_cast<const elem*>(tn.get()));
+
+tree_nodeRef tree_manager::CloneTreeNode(const tree_nodeConstRef& tn, const TreeNodeArenaRef& target_arena)
+{
+   if(tn->get_kind() == statement_list_K)
+   {
+      const auto ret = RefcountAllocate<statement_list>(TreeNodeAllocator<statement_list>(target_arena), *GetPointer<const statement_list>(tn));
+      /// basic blocks are not tree nodes, but they are modified in place as well
+      for(auto& block : GetPointer<statement_list>(ret)->list_of_bloc)
+      {
+         block.second = blocRef(new bloc(*block.second));
+      }
+      return ret;
+   }
+   switch(tn->get_kind())
+   {
+      BOOST_PP_SEQ_FOR_EACH(CLONE_TREE_NODE_CASE, BOOST_PP_EMPTY, CLONED_TREE_NODES)
+      default:
+         THROW_UNREACHABLE("Tree node " + STR(tn->index) + " of kind " + tn->get_kind_text() + " cannot be copied");
+   }
+   return tree_nodeRef();
+}
+#undef CLONE_TREE_NODE_CASE
+#undef CLONED_TREE_NODES
+#undef CLONED_MISCELLANEOUS_OBJ_TREE_NODES
+
+std::string tree_manager::GetRawImage(const tree_nodeConstRef& tn) const
+{
+   std::ostringstream raw_image;
+#if HAVE_MAPPING_BUILT
+   const auto component_type_string = Param->getOption<std::string>(OPT_driving_component_type);
+#endif
+   raw_writer RW(
+#if HAVE_MAPPING_BUILT
+       processingElement::get_component_type(component_type_string),
+#endif
+       raw_image);
+   tn->visit(&RW);
+   return raw_image.str();
+}
+
+TreeManagerSnapshotConstRef tree_manager::CreateSnapshot()
+{
+   THROW_ASSERT(not ConcurrentExecution::IsRunning(), "Snapshots cannot be created while a parallel batch is running");
+   const auto lock = ConcurrentLock();
+   const auto snapshot = refcount<TreeManagerSnapshot>(new TreeManagerSnapshot());
+   snapshot->arena = TreeNodeArenaRef(new TreeNodeArena());
+   for(const auto& tree_node : tree_nodes)
+   {
+      snapshot->tree_nodes[tree_node.first] = tree_node.second ? CloneTreeNode(tree_node.second, snapshot->arena) : tree_nodeRef();
+   }
+   snapshot->tree_reindexes_size = tree_reindexes.size();
+   for(const auto& function_decl_node : function_decl_nodes)
+   {
+      snapshot->function_decl_nodes.push_back(function_decl_node.first);
+   }
+   snapshot->find_cache = find_cache;
+   snapshot->identifiers_unique_table = identifiers_unique_table;
+   snapshot->unique_integer_cst_map = unique_integer_cst_map;
+   snapshot->last_node_id = last_node_id;
+   snapshot->next_vers = next_vers;
+   snapshot->n_pl = n_pl;
+   snapshot->added_goto = added_goto;
+   snapshot->removed_pointer_plus = removed_pointer_plus;
+   snapshot->removable_pointer_plus = removable_pointer_plus;
+   snapshot->unremoved_pointer_plus = unremoved_pointer_plus;
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Created snapshot of " + STR(snapshot->GetTreeNodesNumber()) + " tree nodes");
+   return snapshot;
+}
+
+void tree_manager::RestoreSnapshot(const TreeManagerSnapshotConstRef& snapshot)
+{
+   THROW_ASSERT(not ConcurrentExecution::IsRunning(), "Snapshots cannot be restored while a parallel batch is running");
+   const auto lock = ConcurrentLock();
+   std::vector<unsigned int> created_nodes;
+   size_t replaced_nodes = 0;
+   for(auto& tree_node : tree_nodes)
+   {
+      const auto saved = snapshot->tree_nodes.find(tree_node.first);
+      if(saved == snapshot->tree_nodes.end())
+      {
+         created_nodes.push_back(tree_node.first);
+      }
+      else if(not saved->second or not tree_node.second or saved->second->get_kind() != tree_node.second->get_kind() or GetRawImage(saved->second) != GetRawImage(tree_node.second))
+      {
+         /// the slot is reused, so that the tree_reindex wrapping it refers to the restored node
+         tree_node.second = saved->second ? CloneTreeNode(saved->second, arena) : tree_nodeRef();
+         replaced_nodes++;
+      }
+   }
+   for(const auto& saved : snapshot->tree_nodes)
+   {
+      if(saved.second and tree_nodes.find(saved.first) == tree_nodes.end())
+      {
+         AddTreeNode(saved.first, CloneTreeNode(saved.second, arena));
+         replaced_nodes++;
+      }
+   }
+   for(const auto node_id : created_nodes)
+   {
+      if(node_id < tree_reindexes.size() and tree_reindexes[node_id].use_count() > 1)
+      {
+         /// the tree_reindex is still referenced, so the slot it refers to cannot be erased
+         tree_nodes[node_id] = tree_nodeRef();
+      }
+      else
+      {
+         tree_nodes.erase(node_id);
+      }
+      if(node_id < tree_reindexes.size())
+      {
+         tree_reindexes[node_id] = tree_nodeRef();
+      }
+   }
+   if(tree_reindexes.size() > snapshot->tree_reindexes_size)
+   {
+      tree_reindexes.resize(snapshot->tree_reindexes_size);
+   }
+   function_decl_nodes.clear();
+   for(const auto function_decl_node : snapshot->function_decl_nodes)
+   {
+      function_decl_nodes[function_decl_node] = tree_nodes.find(function_decl_node)->second;
+   }
+   find_cache = snapshot->find_cache;
+   identifiers_unique_table = snapshot->identifiers_unique_table;
+   unique_integer_cst_map = snapshot->unique_integer_cst_map;
+   last_node_id = snapshot->last_node_id;
+   next_vers = snapshot->next_vers;
+   n_pl = snapshot->n_pl;
+   added_goto = snapshot->added_goto;
+   removed_pointer_plus = snapshot->removed_pointer_plus;
+   removable_pointer_plus = snapshot->removable_pointer_plus;
+   unremoved_pointer_plus = snapshot->unremoved_pointer_plus;
+   stack.clear();
+   already_visited.clear();
+   uses_erase_temp.clear();
+   /// the restored nodes may differ from the ones examined for the merge symbol tables
+   merge_next_node_id = 0;
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Restored snapshot of " + STR(snapshot->GetTreeNodesNumber()) + " tree nodes; replaced " + STR(replaced_nodes) + " tree nodes; removed " + STR(created_nodes.size()) + " tree nodes");
+}
+
 bool tree_manager::is_CPP() const
 {
    return Param->isOption(OPT_input_format) && Param->getOption<Parameters_FileFormat>(OPT_input_format) == Parameters_FileFormat::FF_CPP;
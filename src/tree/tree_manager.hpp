@@ -51,14 +51,18 @@
 #include "custom_map.hpp"
 #include "custom_set.hpp"
 #include "hash_helper.hpp"
+#include "interned_string.hpp"
+#include "tree_node_arena.hpp"
 /// utility include
 #include "refcount.hpp"
 
 /// STL include
 #include <deque>
 #include <iosfwd>
+#include <mutex>   // for recursive_mutex
 #include <string>  // for string
 #include <utility> // for pair
+#include <vector>
 
 /**
  * @name forward declarations
@@ -74,6 +78,55 @@ REF_FORWARD_DECL(tree_node);
 enum class TreeVocabularyTokenTypes_TokenEnum;
 //@}
 
+/**
+ * The state of a tree_manager saved by tree_manager::CreateSnapshot
+ */
+class TreeManagerSnapshot
+{
+ private:
+   friend class tree_manager;
+
+   /// The arena where the copies of the tree nodes are allocated; it is released together with the snapshot
+   TreeNodeArenaRef arena;
+
+   /// The copies of the tree nodes indexed by node id; basic blocks of statement lists are copied too
+   CustomUnorderedMap<unsigned int, tree_nodeRef> tree_nodes;
+
+   /// The size of the reindex table
+   size_t tree_reindexes_size;
+
+   /// The indices of the function_decl nodes
+   std::vector<unsigned int> function_decl_nodes;
+
+   /// The cache of tree_manager::find
+   CustomUnorderedMapUnstable<std::string, unsigned int> find_cache;
+
+   /// The table of the identifier_nodes
+   CustomUnorderedMapUnstable<InternedString, unsigned int> identifiers_unique_table;
+
+   /// The memoized integer constants
+   CustomUnorderedMap<std::pair<long long int, unsigned int>, tree_nodeRef> unique_integer_cst_map;
+
+   /// The last node id used
+   unsigned int last_node_id;
+
+   /// The next version number for ssa variables
+   unsigned int next_vers;
+
+   /// The statistics counters of the tree_manager
+   unsigned int n_pl, added_goto, removed_pointer_plus, removable_pointer_plus, unremoved_pointer_plus;
+
+ public:
+   /**
+    * Return the number of tree nodes saved in the snapshot
+    */
+   size_t GetTreeNodesNumber() const
+   {
+      return tree_nodes.size();
+   }
+};
+typedef refcount<const TreeManagerSnapshot> TreeManagerSnapshotConstRef;
+
 /**
  * This class manages the tree structures extracted from the raw file.
  */
@@ -94,6 +147,12 @@ class tree_manager
 #else
    OrderedMapStd<unsigned int, tree_nodeRef> tree_nodes;
 #endif
+
+   /// The tree_reindex wrapping each tree node indexed by node id; they are shared by all the references to the same node
+   std::vector<tree_nodeRef> tree_reindexes;
+
+   /// The arena where tree nodes are allocated
+   TreeNodeArenaRef arena;
    /**
     * Variable containing set of function_declaration with their index node
     */
@@ -127,7 +186,7 @@ class tree_manager
    unsigned int last_node_id;
 
    /// this table stores all identifier_nodes with their nodeID.
-   CustomUnorderedMapUnstable<std::string, unsigned int> identifiers_unique_table;
+   CustomUnorderedMapUnstable<InternedString, unsigned int> identifiers_unique_table;
 
    CustomUnorderedMap<std::pair<long long int, unsigned int>, tree_nodeRef> unique_integer_cst_map;
 
@@ -143,6 +202,36 @@ class tree_manager
    /// Index of current call of collapse_into_counter
    unsigned int collapse_into_counter;
 
+   /// The mutex serializing the accesses to the data structures of the tree_manager from concurrent steps
+   mutable std::recursive_mutex concurrent_access_mutex;
+
+   /**
+    * @name symbol tables of this tree_manager used by merge_tree_managers; they are kept across merges and updated only with the tree nodes
+    * created or overwritten since the previous merge, so the cost of a merge does not grow with the number of already merged translation units
+    */
+   //@{
+   /// declarations indexed by "name-scope"
+   CustomUnorderedMapUnstable<std::string, unsigned int> merge_decl_symbol_table;
+
+   /// named types indexed by name
+   CustomUnorderedMapUnstable<std::string, unsigned int> merge_type_symbol_table;
+
+   /// names given to unqualified records and unions
+   CustomUnorderedMap<unsigned int, std::string> merge_type_unql_symbol_table;
+
+   /// static variables and functions
+   CustomUnorderedSet<std::string> merge_static_symbol_table;
+
+   /// forward declarations of static functions
+   CustomUnorderedSet<std::string> merge_static_function_header_symbol_table;
+
+   /// the tree nodes overwritten during the last merge
+   CustomOrderedSet<unsigned int> merge_overwritten_nodes;
+
+   /// the first index of tree node not yet examined; 0 if the symbol tables have to be built from scratch
+   unsigned int merge_next_node_id;
+   //@}
+
    /**
     * check for decl_node and return true if not suitable for symbol table or otherwise its symbol_name and symbol_scope.
     * @param tn is the tree node to be examinated
@@ -159,6 +248,11 @@ class tree_manager
     */
    bool check_for_type(const tree_nodeRef& tn, const tree_managerRef& TM, std::string& symbol_name, std::string& symbol_scope, const CustomUnorderedMapUnstable<std::string, unsigned int>& global_type_symbol_table, unsigned int node_id);
 
+   /**
+    * Update the symbol tables of this tree_manager used by merge_tree_managers examining the tree nodes created or overwritten since the previous update
+    */
+   void UpdateMergeSymbolTables();
+
    /**
     * Erase the information about variable usage (remove stmt from use_stmts attribute) in ssa variables recursively contained in node tn.
     * @param tn is the node from which the recursion begin.
@@ -173,6 +267,19 @@ class tree_manager
     */
    void insert_usage_info(const tree_nodeRef& tn, const tree_nodeRef& stmt);
 
+   /**
+    * Return a copy of a tree node; the basic blocks of a statement list are copied too
+    * @param tn is the tree node to be copied
+    * @param target_arena is the arena where the copy is allocated
+    */
+   tree_nodeRef CloneTreeNode(const tree_nodeConstRef& tn, const TreeNodeArenaRef& target_arena);
+
+   /**
+    * Return the raw representation of a tree node, including the content of the basic blocks of a statement list
+    * @param tn is the tree node to be printed
+    */
+   std::string GetRawImage(const tree_nodeConstRef& tn) const;
+
  public:
    /**
     * Replace the occurrences of tree node old_node with new_node in statement identified by tn.
@@ -228,17 +335,17 @@ class tree_manager
    /**
     * Return the index-th tree_node (modifiable version)
     * @param index is the index of the tree node to be returned
-    * @return the index-the tree_node
+    * @return the index-the tree_node; the returned reference is valid as long as the tree_manager
     */
-   tree_nodeRef GetTreeNode(const unsigned int index) const;
+   const tree_nodeRef& GetTreeNode(const unsigned int index) const;
 
    /**
     * Return the reference to the i-th tree_node Constant version of get_tree_node.
     * @param i is the index of the tree_node of the considered function.
-    * @return the reference to the tree_node.
+    * @return the reference to the tree_node; the returned reference is valid as long as the tree_manager
     * FIXME: this should return tree_nodeConstRef
     */
-   const tree_nodeRef get_tree_node_const(unsigned int i) const;
+   const tree_nodeRef& get_tree_node_const(unsigned int i) const;
    const tree_nodeConstRef CGetTreeNode(const unsigned int i) const;
 
    /**
@@ -262,6 +369,30 @@ class tree_manager
     */
    void create_tree_node(const unsigned int node_id, enum kind tree_node_type, std::map<TreeVocabularyTokenTypes_TokenEnum, std::string>& tree_node_schema);
 
+   /**
+    * Allocate a tree node in the arena of this tree_manager; the node is not added to the tree_manager
+    * @param args are the arguments passed to the constructor of the node
+    * @return the allocated node
+    */
+   template <typename T, typename... Args>
+   tree_nodeRef AllocateTreeNode(Args&&... args)
+   {
+      const auto lock = ConcurrentLock();
+      return RefcountAllocate<T>(TreeNodeAllocator<T>(arena), std::forward<Args>(args)...);
+   }
+
+   /**
+    * Lock the tree_manager while a parallel batch of design flow steps is running; otherwise the returned lock does not own the mutex
+    * The lock is recursive, so it can be used to make atomic a sequence of calls to find, new_tree_node_id and create_tree_node
+    * @return the lock which is released when destroyed
+    */
+   std::unique_lock<std::recursive_mutex> ConcurrentLock() const;
+
+   /**
+    * Return the number of bytes allocated for the tree nodes which are still alive
+    */
+   size_t GetAllocatedSize() const;
+
    /**
     * if there exist return the node id of a tree node compatible with the tree_node_schema and of type tree_node_type.
     * @param tree_node_type is the type of the node added to the tree_manager expressed as a treeVocabularyTokenTypes.
@@ -419,8 +550,9 @@ class tree_manager
     * @param nodeID is the node id.
     * @param str is the string.
     */
-   void add_identifier_node(unsigned int nodeID, const std::string& str)
+   void add_identifier_node(unsigned int nodeID, const InternedString& str)
    {
+      const auto lock = ConcurrentLock();
       identifiers_unique_table[str] = nodeID;
    }
    void add_identifier_node(unsigned int nodeID, const bool& op);
@@ -447,6 +579,23 @@ class tree_manager
     */
    tree_nodeRef CreateUniqueIntegerCst(long long int value, unsigned int type_index);
 
+   /**
+    * Save the current state of the intermediate representation, so that the transformations applied afterwards can be discarded
+    * Each tree node is copied into an arena owned by the snapshot, so the cost is linear in the size of the tree_manager and the memory is released with the snapshot;
+    * snapshots cannot be created or restored while a parallel batch of steps is running
+    * @return the snapshot
+    */
+   TreeManagerSnapshotConstRef CreateSnapshot();
+
+   /**
+    * Restore the state saved in a snapshot; the snapshot is not consumed, so it can be restored again
+    * Nodes whose raw representation has not changed since the snapshot are kept, so pointers to them and to their basic blocks stay valid;
+    * the other ones are replaced by fresh copies while tree_reindexes are kept, so references through tree_reindex stay valid.
+    * Nodes created after the snapshot are removed.
+    * @param snapshot is the snapshot to be restored
+    */
+   void RestoreSnapshot(const TreeManagerSnapshotConstRef& snapshot);
+
    /**
     * @brief is_CPP return true in case we have at least one CPP source code
     * @return true when at least one translation unit is written in C++
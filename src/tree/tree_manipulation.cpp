@@ -698,6 +698,8 @@ tree_nodeRef tree_manipulation::CreateRealCst(const tree_nodeConstRef& type, con
 /// Create an identifier node
 tree_nodeRef tree_manipulation::create_identifier_node(const std::string& strg) const
 {
+   /// the lookup of the existing node and its creation must be atomic
+   const auto lock = TreeM->ConcurrentLock();
    THROW_ASSERT(!strg.empty(), "It requires a non empty string");
 
    ///@37     identifier_node  strg: "int" lngt: 3
@@ -792,6 +794,7 @@ tree_nodeRef tree_manipulation::create_var_decl(const tree_nodeRef& name, const
 
 tree_nodeRef tree_manipulation::create_translation_unit_decl() const
 {
+   const auto lock = TreeM->ConcurrentLock();
    tree_nodeRef translation_unit_decl_node;
    std::map<TreeVocabularyTokenTypes_TokenEnum, std::string> IR_schema;
    IR_schema[TOK(TOK_SRCP)] = "<built-in>:0:0";
@@ -929,6 +932,7 @@ tree_nodeRef tree_manipulation::create_parm_decl(const tree_nodeRef& name, const
 /// Create a void type
 tree_nodeRef tree_manipulation::create_void_type() const
 {
+   const auto lock = TreeM->ConcurrentLock();
    ///@41     void_type        name: @58      algn: 8
    ///@58     type_decl        name: @63      type: @41      srcp:
    ///"<built-in>:0:0"
@@ -974,6 +978,7 @@ tree_nodeRef tree_manipulation::create_void_type() const
 /// Create a bit_size type
 tree_nodeRef tree_manipulation::create_bit_size_type() const
 {
+   const auto lock = TreeM->ConcurrentLock();
    ///@32    identifier_node  strg: "bitsizetype"  lngt: 13
    ///@18    integer_type   name: @32   size: @33   algn: 64    prec: 64 unsigned
    /// min : @34   max : @35
@@ -1031,6 +1036,7 @@ tree_nodeRef tree_manipulation::create_bit_size_type() const
 /// Create a size type
 tree_nodeRef tree_manipulation::create_size_type() const
 {
+   const auto lock = TreeM->ConcurrentLock();
    //@124    identifier_node  strg: "sizetype"             lngt: 8
    //@96     integer_type     name: @124     size: @15      algn: 32
    //                         prec: 32       unsigned       min : @125
@@ -1094,6 +1100,7 @@ tree_nodeRef tree_manipulation::create_size_type() const
 /// Create a boolean type
 tree_nodeRef tree_manipulation::create_boolean_type() const
 {
+   const auto lock = TreeM->ConcurrentLock();
    ///@48 boolean_type name: @55 size: @7 algn: 8
    ///@55 type_decl name: @58 type: @48 srcp: "<built-in>:0:0"
    ///@58 identifier_node strg: "_Bool" lngt: 5
@@ -1160,6 +1167,7 @@ tree_nodeRef tree_manipulation::create_boolean_type() const
 /// Create an unsigned integer type
 tree_nodeRef tree_manipulation::create_default_unsigned_integer_type() const
 {
+   const auto lock = TreeM->ConcurrentLock();
    ///@41     identifier_node  strg: "unsigned int"         lngt: 12
    ///@8      integer_type     name: @20      size: @12      algn: 32      prec:
    /// 32       unsigned       min : @21    max : @22
@@ -1242,6 +1250,7 @@ tree_nodeRef tree_manipulation::create_default_unsigned_integer_type() const
 
 tree_nodeRef tree_manipulation::CreateDefaultUnsignedLongLongInt() const
 {
+   const auto lock = TreeM->ConcurrentLock();
    std::map<TreeVocabularyTokenTypes_TokenEnum, std::string> IR_schema;
    tree_nodeRef integer_type_node;
 
@@ -1302,6 +1311,7 @@ tree_nodeRef tree_manipulation::CreateDefaultUnsignedLongLongInt() const
 /// Create an integer type
 tree_nodeRef tree_manipulation::create_default_integer_type() const
 {
+   const auto lock = TreeM->ConcurrentLock();
    ///@36     identifier_node  strg: "int" lngt: 3
    ///@19     type_decl        name: @36      type: @8       srcp:
    ///"<built-in>:0:0"
@@ -1390,6 +1400,7 @@ tree_nodeRef tree_manipulation::create_default_integer_type() const
 /// Create a pointer type
 tree_nodeRef tree_manipulation::create_pointer_type(const tree_nodeConstRef& ptd, unsigned int algn) const
 {
+   const auto lock = TreeM->ConcurrentLock();
    ///@15     pointer_type     size: @12      algn: 32       ptd : @9     @9 type
    /// of the pointer
    ///@12     integer_cst      type: @26      low : 32       @26 is bit_size_type
@@ -1428,6 +1439,7 @@ tree_nodeRef tree_manipulation::create_pointer_type(const tree_nodeConstRef& ptd
 
 tree_nodeRef tree_manipulation::create_integer_type_with_prec(unsigned int prec, bool unsigned_p) const
 {
+   const auto lock = TreeM->ConcurrentLock();
    std::map<TreeVocabularyTokenTypes_TokenEnum, std::string> IR_schema;
 
    IR_schema[TOK(TOK_ALGN)] = STR(prec);
@@ -1836,6 +1848,7 @@ void tree_manipulation::bb_set_true_edge(blocRef& bb, const unsigned int& true_e
 
 void tree_manipulation::create_label(const blocRef& block, const unsigned int function_decl_nid) const
 {
+   const auto lock = TreeM->ConcurrentLock();
    std::map<TreeVocabularyTokenTypes_TokenEnum, std::string> IR_schema;
    /// check if the first statement is a gimple_label but with a unnamed
    /// label_decl.
@@ -1963,6 +1976,7 @@ void tree_manipulation::create_label(const blocRef& block, const unsigned int fu
 
 void tree_manipulation::create_goto(const blocRef& block, const unsigned int, const unsigned int label_expr_nid) const
 {
+   const auto lock = TreeM->ConcurrentLock();
    TreeM->add_goto();
    /// compute the label_decl_nid
    auto* le = GetPointer<gimple_label>(TreeM->get_tree_node_const(label_expr_nid));
@@ -2040,6 +2054,7 @@ void tree_manipulation::create_goto(const blocRef& block, const unsigned int, co
 
 tree_nodeRef tree_manipulation::create_function_decl(const std::string& function_name, const tree_nodeRef& scpe, const std::vector<tree_nodeRef>& argsT, const tree_nodeRef& returnType, const std::string& srcp, bool with_body) const
 {
+   const auto lock = TreeM->ConcurrentLock();
    auto function_decl_id = TreeM->function_index(function_name);
    if(function_decl_id)
    {
@@ -2300,6 +2315,7 @@ tree_nodeRef tree_manipulation::CreateNopExpr(const tree_nodeConstRef& operand,
 
 tree_nodeRef tree_manipulation::CreateUnsigned(const tree_nodeConstRef& signed_type) const
 {
+   const auto lock = TreeM->ConcurrentLock();
    const auto int_signed_type = GetPointer<const integer_type>(signed_type);
    if(not int_signed_type)
    {
@@ -2517,6 +2533,7 @@ tree_nodeRef tree_manipulation::CreateGimpleAssignAddrExpr(const tree_nodeConstR
 
 tree_nodeRef tree_manipulation::CreateVectorBooleanType(const unsigned int number_of_elements) const
 {
+   const auto lock = TreeM->ConcurrentLock();
    const auto boolean_type = create_boolean_type();
    const auto size = TreeM->CreateUniqueIntegerCst(number_of_elements, create_size_type()->index);
 
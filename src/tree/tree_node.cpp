@@ -73,6 +73,7 @@
 #include <boost/preprocessor/facilities/empty.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
 #include <iostream>
+#include <mutex>
 #include <utility>
 
 /// forward declaration macro
@@ -98,19 +99,21 @@ std::map<enum kind, std::string> tree_node::kind_to_string;
 
 enum kind tree_node::get_kind(const std::string& input_name)
 {
-   if(string_to_kind.empty())
-   {
+   /// The table is built only once even if tree managers are concurrently built
+   static std::once_flag initialized;
+   std::call_once(initialized, []() {
       // cppcheck-suppress unusedVariable
       std::string name;
       BOOST_PP_SEQ_FOR_EACH(NAME_KIND, BOOST_PP_EMPTY, TREE_NODE_LIST);
-   }
-   return string_to_kind[input_name];
+   });
+   const auto it = string_to_kind.find(input_name);
+   return it != string_to_kind.end() ? it->second : kind();
 }
 
 std::string tree_node::GetString(enum kind k)
 {
-   if(kind_to_string.empty())
-   {
+   static std::once_flag initialized;
+   std::call_once(initialized, []() {
       BOOST_PP_SEQ_FOR_EACH(KIND_NAME, BOOST_PP_EMPTY, TREE_NODE_LIST);
       // This part has been added since boost macro does not expand correctly
       std::map<enum kind, std::string>::iterator it, it_end = kind_to_string.end();
@@ -119,8 +122,9 @@ std::string tree_node::GetString(enum kind k)
          it->second = it->second.substr(19);
          it->second = it->second.substr(0, it->second.find(')'));
       }
-   }
-   return kind_to_string[k];
+   });
+   const auto it = kind_to_string.find(k);
+   return it != kind_to_string.end() ? it->second : std::string();
 }
 
 BOOST_PP_SEQ_FOR_EACH(VISIT_TREE_NODE_MACRO, unary_expr, UNARY_EXPRESSION_TREE_NODES)
@@ -824,7 +828,7 @@ void handler::visit(tree_node_visitor* const v) const
 }
 
 #if HAVE_TREE_MANIPULATION_BUILT
-identifier_node::identifier_node(unsigned int node_id, std::string _strg, tree_manager* TM) : tree_node(node_id), operator_flag(false), strg(std::move(_strg))
+identifier_node::identifier_node(unsigned int node_id, const std::string& _strg, tree_manager* TM) : tree_node(node_id), operator_flag(false), strg(_strg)
 {
    TM->add_identifier_node(node_id, strg);
 }
@@ -66,6 +66,7 @@
 #include "custom_map.hpp" // for CustomMap
 #include "custom_set.hpp"
 #include "exceptions.hpp"  // for throw_error
+#include "interned_string.hpp"
 #include "refcount.hpp"    // for GetPointer, refc...
 #include "tree_common.hpp" // for GET_KIND, BINARY...
 
@@ -3162,14 +3163,14 @@ struct handler : public tree_node
 struct identifier_node : public tree_node
 {
    /// constructors
-   identifier_node(unsigned int node_id, std::string _strg, tree_manager* TM);
+   identifier_node(unsigned int node_id, const std::string& _strg, tree_manager* TM);
    identifier_node(unsigned int node_id, bool _operator_flag, tree_manager* TM);
 
    /// Store true if the identifier_node is an operator.
    const bool operator_flag;
 
-   /// Store the identifier string associated with the identifier_node.
-   std::string strg;
+   /// Store the identifier string associated with the identifier_node; equal identifiers share the same storage
+   InternedString strg;
 
    /// Redefinition of get_kind_text.
    GET_KIND_TEXT(identifier_node)
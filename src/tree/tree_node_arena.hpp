@@ -0,0 +1,272 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2004-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file tree_node_arena.hpp
+ * @brief Slab allocator used by tree_manager to store tree nodes.
+ *
+ * Tree nodes are created in large numbers and are almost never destroyed before the tree_manager which owns them.
+ * They are then allocated, together with their reference counter, in large slabs which are released only when
+ * the tree_manager and all the nodes allocated in them have been destroyed.
+ * The memory of destroyed nodes is kept in a free list per size class and reused by the next allocations of the same size,
+ * so the memory of the slabs is bounded by the peak of the memory used by the nodes alive at the same time.
+ *
+ * $Revision$
+ * $Date$
+ * Last modified by $Author$
+ *
+ */
+#ifndef TREE_NODE_ARENA_HPP
+#define TREE_NODE_ARENA_HPP
+
+/// utility include
+#include "concurrent_execution.hpp"
+#include "refcount.hpp"
+
+/// STL include
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+REF_FORWARD_DECL(TreeNodeArena);
+
+/**
+ * Bump pointer allocator of raw memory; released blocks are reused by allocations of the same size class, while slabs are given back only with the destruction of the arena
+ */
+class TreeNodeArena
+{
+ private:
+   /// The size of each slab
+   static const size_t slab_size = 1 << 20;
+
+   /// The granularity of the size classes; the blocks allocated in the slabs are aligned to it
+   static const size_t granularity = alignof(std::max_align_t);
+
+   /// The allocated slabs
+   std::vector<std::unique_ptr<char[]>> slabs;
+
+   /// The blocks allocated for objects larger than a quarter of a slab indexed by the address returned by Allocate
+   std::unordered_map<void*, std::unique_ptr<char[]>> large_blocks;
+
+   /// The first released block of each size class; each released block stores the address of the next one of the same class
+   std::vector<void*> free_lists;
+
+   /// The mutex protecting the arena while a parallel batch runs, since nodes can be released by any thread
+   std::mutex concurrent_access_mutex;
+
+   /// The first free byte of the last slab
+   char* next;
+
+   /// The number of free bytes in the last slab
+   size_t available;
+
+   /// The number of bytes returned by Allocate and not yet released
+   size_t allocated;
+
+   /**
+    * Return the first address not before pointer with the given alignment
+    */
+   static char* Align(char* pointer, size_t alignment)
+   {
+      return pointer + (alignment - reinterpret_cast<size_t>(pointer) % alignment) % alignment;
+   }
+
+   /**
+    * Return true if a block has to be allocated outside the slabs
+    */
+   static bool IsLarge(size_t size, size_t alignment)
+   {
+      return size + alignment > slab_size / 4;
+   }
+
+   /**
+    * Lock the arena while a parallel batch runs; otherwise the returned lock does not own the mutex
+    */
+   std::unique_lock<std::mutex> ConcurrentLock()
+   {
+      if(ConcurrentExecution::IsRunning())
+      {
+         return std::unique_lock<std::mutex>(concurrent_access_mutex);
+      }
+      return std::unique_lock<std::mutex>();
+   }
+
+ public:
+   /**
+    * Constructor
+    */
+   TreeNodeArena() : next(nullptr), available(0), allocated(0)
+   {
+   }
+
+   /**
+    * Return a block of memory
+    * @param size is the number of bytes to be allocated
+    * @param alignment is the required alignment
+    */
+   void* Allocate(size_t size, size_t alignment)
+   {
+      const auto lock = ConcurrentLock();
+      allocated += size;
+      if(IsLarge(size, alignment))
+      {
+         /// large objects get their own block, so that the current slab is not wasted
+         std::unique_ptr<char[]> block(new char[size + alignment]);
+         auto* ret = Align(block.get(), alignment);
+         large_blocks[ret] = std::move(block);
+         return ret;
+      }
+      if(alignment <= granularity)
+      {
+         const auto size_class = (size + granularity - 1) / granularity;
+         if(size_class < free_lists.size() and free_lists[size_class])
+         {
+            auto* ret = free_lists[size_class];
+            free_lists[size_class] = *static_cast<void**>(ret);
+            return ret;
+         }
+         /// the block is rounded to its size class, so that it can be reused by any object of the same class
+         size = size_class * granularity;
+         alignment = granularity;
+      }
+      if(not next or static_cast<size_t>(Align(next, alignment) - next) + size > available)
+      {
+         slabs.push_back(std::unique_ptr<char[]>(new char[slab_size]));
+         next = slabs.back().get();
+         available = slab_size;
+      }
+      auto* ret = Align(next, alignment);
+      available -= static_cast<size_t>(ret + size - next);
+      next = ret + size;
+      return ret;
+   }
+
+   /**
+    * Release a block of memory returned by Allocate
+    * @param pointer is the address of the block
+    * @param size is the number of bytes passed to Allocate
+    * @param alignment is the alignment passed to Allocate
+    */
+   void Deallocate(void* pointer, size_t size, size_t alignment)
+   {
+      const auto lock = ConcurrentLock();
+      allocated -= size;
+      if(IsLarge(size, alignment))
+      {
+         large_blocks.erase(pointer);
+         return;
+      }
+      if(alignment > granularity)
+      {
+         /// over-aligned blocks are rare and are given back only with the slabs
+         return;
+      }
+      const auto size_class = (size + granularity - 1) / granularity;
+      if(size_class >= free_lists.size())
+      {
+         free_lists.resize(size_class + 1, nullptr);
+      }
+      *static_cast<void**>(pointer) = free_lists[size_class];
+      free_lists[size_class] = pointer;
+   }
+
+   /**
+    * Return the number of bytes currently allocated in this arena
+    */
+   size_t GetAllocatedSize() const
+   {
+      return allocated;
+   }
+};
+
+/**
+ * Standard allocator storing objects into a TreeNodeArena; the arena is kept alive by the allocator copies stored together with the objects
+ */
+template <typename T>
+class TreeNodeAllocator
+{
+ public:
+   typedef T value_type;
+
+   /// The arena where objects are allocated
+   TreeNodeArenaRef arena;
+
+   /**
+    * Rebind the allocator to a different type
+    */
+   template <typename U>
+   struct rebind
+   {
+      typedef TreeNodeAllocator<U> other;
+   };
+
+   /**
+    * Constructor
+    * @param _arena is the arena where objects will be allocated
+    */
+   explicit TreeNodeAllocator(const TreeNodeArenaRef& _arena) : arena(_arena)
+   {
+   }
+
+   /**
+    * Copy constructor from allocators of different types
+    */
+   template <typename U>
+   TreeNodeAllocator(const TreeNodeAllocator<U>& other) : arena(other.arena)
+   {
+   }
+
+   T* allocate(size_t n)
+   {
+      return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+   }
+
+   void deallocate(T* pointer, size_t n)
+   {
+      arena->Deallocate(pointer, n * sizeof(T), alignof(T));
+   }
+
+   template <typename U>
+   bool operator==(const TreeNodeAllocator<U>& other) const
+   {
+      return arena == other.arena;
+   }
+
+   template <typename U>
+   bool operator!=(const TreeNodeAllocator<U>& other) const
+   {
+      return arena != other.arena;
+   }
+};
+#endif
@@ -64,22 +64,22 @@
 #include "weight_information.hpp"
 #endif
 
-#define CREATE_TREE_NODE_CASE_BODY(tree_node_name, node_id) \
-   {                                                        \
-      (node_id) = TM->new_tree_node_id();                   \
-      auto tnn = new tree_node_name(node_id);               \
-      tree_nodeRef cur = tree_nodeRef(tnn);                 \
-      if(dynamic_cast<function_decl*>(tnn))                 \
-      {                                                     \
-         TM->add_function(node_id, cur);                    \
-      }                                                     \
-      TM->AddTreeNode(node_id, cur);                        \
-      curr_tree_node_ptr = tnn;                             \
-      source_tn = tn;                                       \
-      tnn->visit(this);                                     \
-      curr_tree_node_ptr = nullptr;                         \
-      source_tn = tree_nodeRef();                           \
-      break;                                                \
+#define CREATE_TREE_NODE_CASE_BODY(tree_node_name, node_id)             \
+   {                                                                    \
+      (node_id) = TM->new_tree_node_id();                               \
+      tree_nodeRef cur = TM->AllocateTreeNode<tree_node_name>(node_id); \
+      auto tnn = static_cast<tree_node_name*>(cur.get());               \
+      if(dynamic_cast<function_decl*>(tnn))                             \
+      {                                                                 \
+         TM->add_function(node_id, cur);                                \
+      }                                                                 \
+      TM->AddTreeNode(node_id, cur);                                    \
+      curr_tree_node_ptr = tnn;                                         \
+      source_tn = tn;                                                   \
+      tnn->visit(this);                                                 \
+      curr_tree_node_ptr = nullptr;                                     \
+      source_tn = tree_nodeRef();                                       \
+      break;                                                            \
    }
 
 #define RET_NODE_ID_CASE_BODY(tree_node_name, node_id) \
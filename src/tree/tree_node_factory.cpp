@@ -59,15 +59,15 @@
 #endif
 #include "utility.hpp"
 
-#define CREATE_TREE_NODE_CASE_BODY(tree_node_name, node_id) \
-   {                                                        \
-      auto tnn = new tree_node_name(node_id);               \
-      tree_nodeRef cur = tree_nodeRef(tnn);                 \
-      TM.AddTreeNode(node_id, cur);                         \
-      curr_tree_node_ptr = tnn;                             \
-      tnn->visit(this);                                     \
-      curr_tree_node_ptr = nullptr;                         \
-      break;                                                \
+#define CREATE_TREE_NODE_CASE_BODY(tree_node_name, node_id)            \
+   {                                                                   \
+      tree_nodeRef cur = TM.AllocateTreeNode<tree_node_name>(node_id); \
+      auto tnn = static_cast<tree_node_name*>(cur.get());              \
+      TM.AddTreeNode(node_id, cur);                                    \
+      curr_tree_node_ptr = tnn;                                        \
+      tnn->visit(this);                                                \
+      curr_tree_node_ptr = nullptr;                                    \
+      break;                                                           \
    }
 
 void tree_node_factory::create_tree_node(unsigned int node_id, enum kind tree_node_type)
@@ -559,11 +559,11 @@ void tree_node_factory::create_tree_node(unsigned int node_id, enum kind tree_no
          tree_nodeRef cur;
          if(tree_node_schema.find(TOK(TOK_STRG)) != tree_node_schema.end())
          {
-            cur = tree_nodeRef(new identifier_node(node_id, tree_node_schema.find(TOK(TOK_STRG))->second, &TM));
+            cur = TM.AllocateTreeNode<identifier_node>(node_id, tree_node_schema.find(TOK(TOK_STRG))->second, &TM);
          }
          else if(tree_node_schema.find(TOK(TOK_OPERATOR)) != tree_node_schema.end())
          {
-            cur = tree_nodeRef(new identifier_node(node_id, boost::lexical_cast<bool>(tree_node_schema.find(TOK(TOK_OPERATOR))->second), &TM));
+            cur = TM.AllocateTreeNode<identifier_node>(node_id, boost::lexical_cast<bool>(tree_node_schema.find(TOK(TOK_OPERATOR))->second), &TM);
          }
          else
          {
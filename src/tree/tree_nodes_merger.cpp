@@ -860,21 +860,21 @@ void tree_node_reached::operator()(const statistical_profiling* obj, unsigned in
    tree_node_mask::operator()(obj, mask);
 }
 
-#define CREATE_TREE_NODE_CASE_BODY(tree_node_name, node_id) \
-   {                                                        \
-      auto tnn = new tree_node_name(node_id);               \
-      tree_nodeRef cur = tree_nodeRef(tnn);                 \
-      if(dynamic_cast<function_decl*>(tnn))                 \
-      {                                                     \
-         TM->add_function(node_id, cur);                    \
-      }                                                     \
-      TM->AddTreeNode(node_id, cur);                        \
-      curr_tree_node_ptr = tnn;                             \
-      source_tn = tn;                                       \
-      tnn->visit(this);                                     \
-      curr_tree_node_ptr = nullptr;                         \
-      source_tn = tree_nodeRef();                           \
-      break;                                                \
+#define CREATE_TREE_NODE_CASE_BODY(tree_node_name, node_id)             \
+   {                                                                    \
+      tree_nodeRef cur = TM->AllocateTreeNode<tree_node_name>(node_id); \
+      auto tnn = static_cast<tree_node_name*>(cur.get());               \
+      if(dynamic_cast<function_decl*>(tnn))                             \
+      {                                                                 \
+         TM->add_function(node_id, cur);                                \
+      }                                                                 \
+      TM->AddTreeNode(node_id, cur);                                    \
+      curr_tree_node_ptr = tnn;                                         \
+      source_tn = tn;                                                   \
+      tnn->visit(this);                                                 \
+      curr_tree_node_ptr = nullptr;                                     \
+      source_tn = tree_nodeRef();                                       \
+      break;                                                            \
    }
 
 void tree_node_index_factory::create_tree_node(const unsigned int node_id, const tree_nodeRef& tn)
@@ -1368,11 +1368,11 @@ void tree_node_index_factory::create_tree_node(const unsigned int node_id, const
          tree_nodeRef cur;
          if(GetPointer<identifier_node>(tn)->operator_flag)
          {
-            cur = tree_nodeRef(new identifier_node(node_id, true, TM.get()));
+            cur = TM->AllocateTreeNode<identifier_node>(node_id, true, TM.get());
          }
          else
          {
-            cur = tree_nodeRef(new identifier_node(node_id, GetPointer<identifier_node>(tn)->strg, TM.get()));
+            cur = TM->AllocateTreeNode<identifier_node>(node_id, GetPointer<identifier_node>(tn)->strg, TM.get());
          }
          TM->AddTreeNode(node_id, cur);
          break;
@@ -0,0 +1,61 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2004-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file concurrent_execution.cpp
+ * @brief Implementation of the tracking of the batches of design flow steps which are executed concurrently
+ *
+ * $Revision$
+ * $Date$
+ * Last modified by $Author$
+ *
+ */
+
+/// Header include
+#include "concurrent_execution.hpp"
+
+std::atomic<unsigned int> ConcurrentExecution::running_batches(0);
+
+ConcurrentExecution::Batch::Batch()
+{
+   ++running_batches;
+}
+
+ConcurrentExecution::Batch::~Batch()
+{
+   --running_batches;
+}
+
+bool ConcurrentExecution::IsRunning()
+{
+   return running_batches.load() != 0;
+}
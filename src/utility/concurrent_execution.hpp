@@ -0,0 +1,84 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2004-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file concurrent_execution.hpp
+ * @brief Tracks the batches of design flow steps which are executed concurrently
+ *
+ * $Revision$
+ * $Date$
+ * Last modified by $Author$
+ *
+ */
+#ifndef CONCURRENT_EXECUTION_HPP
+#define CONCURRENT_EXECUTION_HPP
+
+/// STD include
+#include <atomic>
+
+/**
+ * Counter of the parallel batches currently running in the process.
+ * Data structures shared among design flow steps are locked only while it is not zero, so serial execution never pays for the synchronization
+ */
+class ConcurrentExecution
+{
+ private:
+   /// The number of parallel batches currently running
+   static std::atomic<unsigned int> running_batches;
+
+ public:
+   /**
+    * Marks the lifetime of a parallel batch; it has to be created before the threads are started and destroyed after they are joined
+    */
+   class Batch
+   {
+    public:
+      /**
+       * Constructor
+       */
+      Batch();
+
+      /**
+       * Destructor
+       */
+      ~Batch();
+
+      Batch(const Batch&) = delete;
+      Batch& operator=(const Batch&) = delete;
+   };
+
+   /**
+    * Return true if at least a parallel batch is running
+    */
+   static bool IsRunning();
+};
+#endif
@@ -50,4 +50,9 @@
 void util_print_cpu_stats(std::ostream& os);
 std::string PrintVirtualDataMemoryUsage();
 
+/**
+ * Return the peak resident set size of the process in KB (0 if unavailable)
+ */
+long GetPeakResidentSetSize();
+
 #endif
@@ -89,7 +89,7 @@
 
 //@}
 
-extern size_t indentation;
+extern thread_local size_t indentation;
 
 extern std::ostream null_stream;
 
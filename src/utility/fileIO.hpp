@@ -55,6 +55,7 @@
 #include <boost/lexical_cast.hpp>          // for lexical_cast
 #include <boost/system/error_code.hpp>     // for error_code
 #include <boost/version.hpp>               // for BOOST_VERSION
+#include <atomic>                          // for atomic
 #include <cstdio>                          // for size_t, fclose
 #include <cstdlib>                         // for system
 #include <iostream>                        // for operator<<, basi...
@@ -300,10 +301,11 @@ inline std::string BuildPath(const std::string& first_part, const std::string se
  */
 inline int PandaSystem(const ParameterConstRef Param, const std::string& system_command, const std::string& output = "", const unsigned int type = 3, const bool background = false, const size_t timeout = 0)
 {
-   static size_t counter = 0;
-   const std::string actual_output = output == "" ? Param->getOption<std::string>(OPT_output_temporary_directory) + STR_CST_file_IO_shell_output_file + "_" + boost::lexical_cast<std::string>(counter) : output;
-   const std::string script_file_name = Param->getOption<std::string>(OPT_output_temporary_directory) + STR_CST_file_IO_shell_script + "_" + boost::lexical_cast<std::string>(counter++);
-   counter++;
+   /// The counter is atomic since commands can be concurrently executed by different threads
+   static std::atomic<size_t> counter(0);
+   const size_t current_counter = counter.fetch_add(2);
+   const std::string actual_output = output == "" ? Param->getOption<std::string>(OPT_output_temporary_directory) + STR_CST_file_IO_shell_output_file + "_" + boost::lexical_cast<std::string>(current_counter) : output;
+   const std::string script_file_name = Param->getOption<std::string>(OPT_output_temporary_directory) + STR_CST_file_IO_shell_script + "_" + boost::lexical_cast<std::string>(current_counter);
    std::ofstream script_file(script_file_name.c_str());
    script_file << "#!/bin/bash" << std::endl;
    THROW_ASSERT(not background or timeout == 0, "Background and timeout cannot be specified at the same time");
@@ -51,7 +51,7 @@
 #include "indented_output_stream.hpp"
 
 /// In global_variables.hpp
-extern size_t indentation;
+extern thread_local size_t indentation;
 
 IndentedOutputStream::IndentedOutputStream(char o, char c, unsigned int d) : indent_spaces(0), opening_char(o), closing_char(c), delta(d), is_line_start(true)
 {
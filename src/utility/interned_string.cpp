@@ -0,0 +1,127 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2004-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file interned_string.cpp
+ * @brief Implementation of the global table of interned strings
+ *
+ * $Revision$
+ * $Date$
+ * Last modified by $Author$
+ *
+ */
+
+/// Header include
+#include "interned_string.hpp"
+
+/// Autoheader include
+#include "config_HAVE_OPENMP.hpp"
+
+/// STD include
+#include <ostream>
+#include <unordered_map>
+
+/**
+ * Return the global table of interned strings; the elements of an unordered_map are never moved, so pointers to them stay valid
+ */
+static std::unordered_map<std::string, unsigned int>& GetInternedStrings()
+{
+   static std::unordered_map<std::string, unsigned int> interned_strings;
+   return interned_strings;
+}
+
+const std::pair<const std::string, unsigned int>* InternedString::Intern(const std::string& str)
+{
+   const std::pair<const std::string, unsigned int>* ret;
+   /// tree managers of different source files are concurrently built
+#if HAVE_OPENMP
+#pragma omp critical(InternedString)
+#endif
+   {
+      auto& interned_strings = GetInternedStrings();
+      const auto id = static_cast<unsigned int>(interned_strings.size());
+      ret = &*interned_strings.insert(std::make_pair(str, id)).first;
+   }
+   return ret;
+}
+
+InternedString::InternedString()
+{
+   static const auto empty_string = Intern(std::string());
+   entry = empty_string;
+}
+
+InternedString::InternedString(const std::string& str) : entry(Intern(str))
+{
+}
+
+InternedString::InternedString(const char* str) : entry(Intern(str))
+{
+}
+
+bool InternedString::Find(const std::string& str, InternedString& interned)
+{
+   const std::pair<const std::string, unsigned int>* found = nullptr;
+#if HAVE_OPENMP
+#pragma omp critical(InternedString)
+#endif
+   {
+      const auto& interned_strings = GetInternedStrings();
+      const auto it = interned_strings.find(str);
+      if(it != interned_strings.end())
+      {
+         found = &*it;
+      }
+   }
+   if(!found)
+   {
+      return false;
+   }
+   interned = InternedString(found);
+   return true;
+}
+
+size_t InternedString::GetTableSize()
+{
+   size_t ret;
+#if HAVE_OPENMP
+#pragma omp critical(InternedString)
+#endif
+   ret = GetInternedStrings().size();
+   return ret;
+}
+
+std::ostream& operator<<(std::ostream& os, const InternedString& interned_string)
+{
+   os << interned_string.str();
+   return os;
+}
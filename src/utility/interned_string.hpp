@@ -0,0 +1,258 @@
+/*
+ *
+ *                   _/_/_/    _/_/   _/    _/ _/_/_/    _/_/
+ *                  _/   _/ _/    _/ _/_/  _/ _/   _/ _/    _/
+ *                 _/_/_/  _/_/_/_/ _/  _/_/ _/   _/ _/_/_/_/
+ *                _/      _/    _/ _/    _/ _/   _/ _/    _/
+ *               _/      _/    _/ _/    _/ _/_/_/  _/    _/
+ *
+ *             ***********************************************
+ *                              PandA Project
+ *                     URL: http://panda.dei.polimi.it
+ *                       Politecnico di Milano - DEIB
+ *                        System Architectures Group
+ *             ***********************************************
+ *              Copyright (C) 2004-2020 Politecnico di Milano
+ *
+ *   This file is part of the PandA framework.
+ *
+ *   The PandA framework is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * @file interned_string.hpp
+ * @brief Strings stored only once in a global table and identified by a stable integer id
+ *
+ * $Revision$
+ * $Date$
+ * Last modified by $Author$
+ *
+ */
+#ifndef INTERNED_STRING_HPP
+#define INTERNED_STRING_HPP
+
+/// STD include
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <utility>
+
+/**
+ * Handle of a string stored in the global table of interned strings.
+ * Equal strings share the same storage and the same id, so that copying, hashing and comparing for equality are constant time operations.
+ * Interned strings are never released.
+ */
+class InternedString
+{
+ private:
+   /// The entry of the global table: the string and its id
+   const std::pair<const std::string, unsigned int>* entry;
+
+   /**
+    * Return the entry of the global table associated with a string, adding it if it is not present
+    * @param str is the string to be interned
+    */
+   static const std::pair<const std::string, unsigned int>* Intern(const std::string& str);
+
+   /**
+    * Constructor from an entry of the global table
+    * @param _entry is the entry
+    */
+   explicit InternedString(const std::pair<const std::string, unsigned int>* _entry) : entry(_entry)
+   {
+   }
+
+ public:
+   /**
+    * Constructor of the empty string
+    */
+   InternedString();
+
+   /**
+    * Constructor
+    * @param str is the string to be interned
+    */
+   // cppcheck-suppress noExplicitConstructor
+   InternedString(const std::string& str);
+
+   /**
+    * Constructor
+    * @param str is the string to be interned
+    */
+   // cppcheck-suppress noExplicitConstructor
+   InternedString(const char* str);
+
+   /**
+    * Return the stored string
+    */
+   const std::string& str() const
+   {
+      return entry->first;
+   }
+
+   operator const std::string&() const
+   {
+      return entry->first;
+   }
+
+   /**
+    * Return the id of the string; the id is the same for all the equal strings
+    */
+   unsigned int GetId() const
+   {
+      return entry->second;
+   }
+
+   bool empty() const
+   {
+      return entry->first.empty();
+   }
+
+   size_t length() const
+   {
+      return entry->first.length();
+   }
+
+   size_t size() const
+   {
+      return entry->first.size();
+   }
+
+   const char* c_str() const
+   {
+      return entry->first.c_str();
+   }
+
+   size_t find(const std::string& str, size_t pos = 0) const
+   {
+      return entry->first.find(str, pos);
+   }
+
+   bool operator==(const InternedString& other) const
+   {
+      return entry == other.entry;
+   }
+
+   bool operator!=(const InternedString& other) const
+   {
+      return entry != other.entry;
+   }
+
+   /**
+    * Interned strings are sorted as the corresponding strings, so that the ordered containers do not depend on the interning order
+    */
+   bool operator<(const InternedString& other) const
+   {
+      return entry != other.entry and entry->first < other.entry->first;
+   }
+
+   /**
+    * Look for a string in the global table without adding it, so that lookups of strings which are not interned do not grow the table
+    * @param str is the string to be searched
+    * @param interned is set to the interned string when it is found
+    * @return true if the string has already been interned
+    */
+   static bool Find(const std::string& str, InternedString& interned);
+
+   /**
+    * Return the number of strings which have been interned
+    */
+   static size_t GetTableSize();
+};
+
+inline bool operator==(const InternedString& first, const std::string& second)
+{
+   return first.str() == second;
+}
+
+inline bool operator==(const std::string& first, const InternedString& second)
+{
+   return first == second.str();
+}
+
+inline bool operator==(const InternedString& first, const char* second)
+{
+   return first.str() == second;
+}
+
+inline bool operator==(const char* first, const InternedString& second)
+{
+   return first == second.str();
+}
+
+inline bool operator!=(const InternedString& first, const std::string& second)
+{
+   return first.str() != second;
+}
+
+inline bool operator!=(const std::string& first, const InternedString& second)
+{
+   return first != second.str();
+}
+
+inline bool operator!=(const InternedString& first, const char* second)
+{
+   return first.str() != second;
+}
+
+inline bool operator!=(const char* first, const InternedString& second)
+{
+   return first != second.str();
+}
+
+inline std::string operator+(const InternedString& first, const std::string& second)
+{
+   return first.str() + second;
+}
+
+inline std::string operator+(const std::string& first, const InternedString& second)
+{
+   return first + second.str();
+}
+
+inline std::string operator+(const InternedString& first, const char* second)
+{
+   return first.str() + second;
+}
+
+inline std::string operator+(const char* first, const InternedString& second)
+{
+   return first + second.str();
+}
+
+inline std::string operator+(const InternedString& first, const char second)
+{
+   return first.str() + second;
+}
+
+inline std::string operator+(const char first, const InternedString& second)
+{
+   return first + second.str();
+}
+
+std::ostream& operator<<(std::ostream& os, const InternedString& interned_string);
+
+namespace std
+{
+   template <>
+   struct hash<InternedString>
+   {
+      size_t operator()(const InternedString& interned_string) const
+      {
+         return interned_string.GetId();
+      }
+   };
+} // namespace std
+#endif
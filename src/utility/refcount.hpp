@@ -62,17 +62,22 @@ struct null_deleter
 #define refcount std::shared_ptr
 #define Wrefcount std::weak_ptr
 #define RefcountCast std::dynamic_pointer_cast
+#define RefcountAllocate std::allocate_shared
 
 #else
-#include <boost/smart_ptr/shared_ptr.hpp> // for shared_ptr
-#include <boost/smart_ptr/weak_ptr.hpp>   // for weak_ptr
-#include <cstddef>                        // for size_t
+#include <boost/smart_ptr/make_shared.hpp> // for allocate_shared
+#include <boost/smart_ptr/shared_ptr.hpp>  // for shared_ptr
+#include <boost/smart_ptr/weak_ptr.hpp>    // for weak_ptr
+#include <cstddef>                         // for size_t
 
 #define refcount boost::shared_ptr
 #define Wrefcount boost::weak_ptr
 #define RefcountCast boost::dynamic_pointer_cast
+#define RefcountAllocate boost::allocate_shared
 #endif
 #else
+#include <utility> // for forward
+
 template <class T>
 class Wrefcount;
 
@@ -216,6 +221,14 @@ struct Wrefcount
    }
 };
 
+/**
+ * Create an object managed by a refcount; the allocator is ignored since the reference counter is always allocated on the heap
+ */
+template <class T, class Alloc, class... Args>
+inline refcount<T> RefcountAllocate(const Alloc&, Args&&... args)
+{
+   return refcount<T>(new T(std::forward<Args>(args)...));
+}
 #endif
 /**
  * Macro used to forward declared a Refcount type
@@ -77,6 +77,7 @@
 #include "config_HAVE_I386_GCC7_MX32.hpp"
 #include "config_HAVE_I386_GCC8_COMPILER.hpp"
 #include "config_HAVE_I386_GCC8_MX32.hpp"
+#include "config_HAVE_OPENMP.hpp"
 #include "config_HAVE_SPARC_COMPILER.hpp"
 #include "config_HAVE_SPARC_ELF_GCC.hpp"
 #include "config_I386_CLANG4_ASTANALYZER_PLUGIN.hpp"
@@ -233,11 +234,17 @@
 #endif
 /// STD include
 #include <cerrno>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <sstream>
 #include <string>
 #include <unistd.h>
 
 /// STL include
 #include <list>
+#include <utility>
+#include <vector>
 
 /// Tree includes
 #include "parse_tree.hpp"
@@ -281,8 +288,9 @@ void GccWrapper::CompileFile(const std::string& original_file_name, std::string&
 {
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Compiling " + original_file_name + "(transformed in " + real_file_name);
 
-   /// The gcc output
-   const std::string gcc_output_file_name = Param->getOption<std::string>(OPT_output_temporary_directory) + STR_CST_gcc_output;
+   /// The gcc output (one for each source file since different files can be concurrently compiled); the hash of the full path distinguishes files with the same leaf name in different directories
+   const std::string gcc_output_file_name = Param->getOption<std::string>(OPT_output_temporary_directory) + STR_CST_gcc_output + "_" +
+                                            (original_file_name == "-" ? std::string("stdin") : GetLeafFileName(original_file_name) + "_" + STR(std::hash<std::string>()(original_file_name)));
 
    const Compiler compiler = GetCompiler();
    std::string command = compiler.gcc.string();
@@ -437,6 +445,8 @@ void GccWrapper::CompileFile(const std::string& original_file_name, std::string&
    else
       THROW_ERROR("compilation mode not yet implemented");
 
+   /// The command without output file is used to preprocess the source file when the compiler cache is enabled
+   const std::string command_without_output = command;
    std::string temporary_file_run_o;
    if(cm != GccWrapper_CompilerMode::CM_LTO)
    {
@@ -466,12 +476,13 @@ void GccWrapper::CompileFile(const std::string& original_file_name, std::string&
       local_parameters_line += " -O1 ";
    }
 
+   std::string source_arguments;
    if(!(Param->getOption<bool>(OPT_compute_size_of)))
-      command += " -D\"" + std::string(STR_CST_panda_sizeof) + "(arg)=" + STR_CST_string_sizeof + "(#arg)\"";
-   command += " " + local_parameters_line;
+      source_arguments += " -D\"" + std::string(STR_CST_panda_sizeof) + "(arg)=" + STR_CST_string_sizeof + "(#arg)\"";
+   source_arguments += " " + local_parameters_line;
    if(original_file_name == "-" or original_file_name == "/dev/null")
    {
-      command += real_file_name;
+      source_arguments += real_file_name;
    }
    else
    {
@@ -479,9 +490,42 @@ void GccWrapper::CompileFile(const std::string& original_file_name, std::string&
       std::string extension = GetExtension(file_path);
       /// assembler files are not allowed so in some cases we pass a C file renamed with extension .S
       if(extension == "S")
-         command += "-x c ";
-      command += "\"" + real_file_name + "\"";
+         source_arguments += "-x c ";
+      source_arguments += "\"" + real_file_name + "\"";
+   }
+   command += source_arguments;
+
+   /// Look for the raw file in the compiler cache
+   bool use_compiler_cache = cm == GccWrapper_CompilerMode::CM_STD and Param->isOption(OPT_gcc_cache_directory) and original_file_name != "-" and not(Param->isOption(OPT_gcc_E) and Param->getOption<bool>(OPT_gcc_E)) and
+                             not(Param->isOption(OPT_gcc_S) and Param->getOption<bool>(OPT_gcc_S));
+#if HAVE_FROM_RTL_BUILT
+   use_compiler_cache = use_compiler_cache and not Param->getOption<bool>(OPT_use_rtl);
+#endif
+   std::string cached_raw_file_name;
+   std::string cache_key;
+   const std::string raw_file_name = Param->getOption<std::string>(OPT_output_temporary_directory) + "/" + GetLeafFileName(real_file_name) + STR_CST_gcc_tree_suffix;
+   if(use_compiler_cache)
+   {
+      cached_raw_file_name = GetCachedRawFileName(compiler, command_without_output, source_arguments, gcc_output_file_name, cache_key);
+      if(cached_raw_file_name != "" and boost::filesystem::exists(cached_raw_file_name))
+      {
+         /// The entry starts with the size of the key and with the key itself, which must match the one of this compilation, followed by the raw file
+         std::ifstream cached_raw_file(cached_raw_file_name, std::ios::binary);
+         size_t stored_key_size = 0;
+         cached_raw_file >> stored_key_size;
+         cached_raw_file.get();
+         std::string stored_key(stored_key_size == cache_key.size() ? stored_key_size : 0, '\0');
+         if(stored_key_size == cache_key.size() and cached_raw_file.read(&stored_key[0], static_cast<std::streamsize>(stored_key_size)) and stored_key == cache_key)
+         {
+            std::ofstream raw_file(raw_file_name, std::ios::binary);
+            raw_file << cached_raw_file.rdbuf();
+            INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Raw file retrieved from compiler cache: " + cached_raw_file_name);
+            return;
+         }
+         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Compiler cache entry " + cached_raw_file_name + " belongs to a different compilation");
+      }
    }
+
    INDENT_DBG_MEX(DEBUG_LEVEL_VERBOSE, debug_level, "---Invoke: " + command);
 #if !NPROFILE
    long int gcc_compilation_time = 0;
@@ -517,9 +561,54 @@ void GccWrapper::CompileFile(const std::string& original_file_name, std::string&
       if(output_level >= OUTPUT_LEVEL_VERBOSE)
          CopyStdout(gcc_output_file_name);
    }
+   /// Store the key and the raw file in the compiler cache; the entry is first written and then renamed so that concurrent executions never read a partial entry
+   if(use_compiler_cache and cached_raw_file_name != "" and boost::filesystem::exists(raw_file_name))
+   {
+      const boost::filesystem::path temporary_cached_raw_file_name = boost::filesystem::unique_path(cached_raw_file_name + "-%%%%-%%%%-%%%%-%%%%");
+      {
+         std::ofstream cached_raw_file(temporary_cached_raw_file_name.string(), std::ios::binary);
+         std::ifstream raw_file(raw_file_name, std::ios::binary);
+         cached_raw_file << cache_key.size() << "\n" << cache_key << raw_file.rdbuf();
+      }
+      boost::filesystem::rename(temporary_cached_raw_file_name, cached_raw_file_name);
+      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Raw file stored in compiler cache: " + cached_raw_file_name);
+   }
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "<--Compiled file");
 }
 
+std::string GccWrapper::GetCachedRawFileName(const Compiler& compiler, const std::string& command, const std::string& source_arguments, const std::string& gcc_output_file_name, std::string& key_string) const
+{
+   /// The source is preprocessed only when the compiler cache is enabled
+   THROW_ASSERT(Param->isOption(OPT_gcc_cache_directory), "Compiler cache not enabled");
+   const std::string output_temporary_directory = Param->getOption<std::string>(OPT_output_temporary_directory);
+   const std::string preprocessed_file_name = boost::filesystem::unique_path(output_temporary_directory + "/" + STR_CST_gcc_preprocessed_file).string();
+   const std::string preprocessing_command = command + " -E -o " + preprocessed_file_name + " " + source_arguments;
+   INDENT_DBG_MEX(DEBUG_LEVEL_VERBOSE, debug_level, "---Preprocessing for compiler cache: " + preprocessing_command);
+   const int ret = PandaSystem(Param, preprocessing_command, gcc_output_file_name);
+   if(IsError(ret) or not boost::filesystem::exists(preprocessed_file_name))
+   {
+      /// The error will be reported by the actual compilation
+      return "";
+   }
+   std::ifstream preprocessed_file(preprocessed_file_name);
+   std::stringstream key;
+   key << preprocessed_file.rdbuf();
+   preprocessed_file.close();
+   std::remove(preprocessed_file_name.c_str());
+   key << command << source_arguments << Param->getOption<std::string>(OPT_revision);
+   /// The plugin is identified by its path and by its modification time
+   if(boost::filesystem::exists(compiler.ssa_plugin_obj))
+   {
+      key << boost::filesystem::last_write_time(compiler.ssa_plugin_obj);
+   }
+   /// The temporary directory changes at each execution
+   key_string = key.str();
+   boost::replace_all(key_string, output_temporary_directory, "");
+   std::stringstream hash;
+   hash << std::hex << std::hash<std::string>()(key_string) << "_" << key_string.size();
+   return Param->getOption<std::string>(OPT_gcc_cache_directory) + "/" + hash.str() + STR_CST_gcc_tree_suffix;
+}
+
 void GccWrapper::FillTreeManager(const tree_managerRef TM, std::map<std::string, std::string>& source_files)
 {
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Invoking GCC");
@@ -588,6 +677,8 @@ void GccWrapper::FillTreeManager(const tree_managerRef TM, std::map<std::string,
 
    INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "Starting compilation of single files");
    bool enable_LTO = (compiler.is_clang && source_files.size() > 1);
+   const bool create_raw = !Param->isOption(OPT_gcc_E) and !Param->isOption(OPT_gcc_S) and !enable_LTO;
+   std::vector<std::pair<const std::string, std::string>*> files_to_be_processed;
    for(auto& source_file : source_files)
    {
       if(already_processed_files.find(source_file.first) != already_processed_files.end())
@@ -599,13 +690,58 @@ void GccWrapper::FillTreeManager(const tree_managerRef TM, std::map<std::string,
       {
          already_processed_files.insert(source_file.first);
       }
-      std::string leaf_name = source_file.second == "-" ? "stdin-" : GetLeafFileName(source_file.second);
-      INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Compiling file " + source_file.second);
-      /// create obj
-      CompileFile(source_file.first, source_file.second, gcc_compiling_parameters, enable_LTO ? GccWrapper_CompilerMode::CM_LTO : GccWrapper_CompilerMode::CM_STD);
-      if(!Param->isOption(OPT_gcc_E) and !Param->isOption(OPT_gcc_S) and !enable_LTO)
+      files_to_be_processed.push_back(&source_file);
+   }
+   /// Files are compiled and the raw files are parsed concurrently; tree managers are merged in the order of the source files so that the result does not depend on the number of jobs
+   std::vector<tree_managerRef> tree_managers(files_to_be_processed.size());
+   std::vector<std::exception_ptr> exceptions(files_to_be_processed.size());
+   const auto files_number = static_cast<int>(files_to_be_processed.size());
+#if HAVE_OPENMP
+   /// The raw file name is derived by the compiler from the leaf name of the source file, so files with the same leaf name cannot be concurrently compiled
+   CustomSet<std::string> leaf_names;
+   for(const auto source_file : files_to_be_processed)
+   {
+      leaf_names.insert(source_file->second == "-" ? "stdin-" : GetLeafFileName(source_file->second));
+   }
+   const auto jobs = leaf_names.size() == files_to_be_processed.size() ? Param->getOption<int>(OPT_jobs) : 1;
+#pragma omp parallel for num_threads(jobs) schedule(dynamic) if(jobs > 1)
+#endif
+   for(int index = 0; index < files_number; index++)
+   {
+      auto& source_file = *files_to_be_processed[static_cast<size_t>(index)];
+      try
+      {
+         const std::string leaf_name = source_file.second == "-" ? "stdin-" : GetLeafFileName(source_file.second);
+         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Compiling file " + source_file.second);
+         /// create obj
+         CompileFile(source_file.first, source_file.second, gcc_compiling_parameters, enable_LTO ? GccWrapper_CompilerMode::CM_LTO : GccWrapper_CompilerMode::CM_STD);
+         if(create_raw and boost::filesystem::exists(boost::filesystem::path(output_temporary_directory + "/" + leaf_name + STR_CST_gcc_tree_suffix)))
+         {
+            tree_managers[static_cast<size_t>(index)] = ParseTreeFile(Param, output_temporary_directory + "/" + leaf_name + STR_CST_gcc_tree_suffix, false);
+         }
+      }
+      catch(...)
       {
-         if(!(boost::filesystem::exists(boost::filesystem::path(output_temporary_directory + "/" + leaf_name + STR_CST_gcc_tree_suffix))))
+         exceptions[static_cast<size_t>(index)] = std::current_exception();
+      }
+   }
+   for(size_t index = 0; index < files_to_be_processed.size(); index++)
+   {
+      if(exceptions[index])
+      {
+         std::rethrow_exception(exceptions[index]);
+      }
+      if(create_raw)
+      {
+         auto& source_file = *files_to_be_processed[index];
+         std::string leaf_name = source_file.second == "-" ? "stdin-" : GetLeafFileName(source_file.second);
+         INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "-->Merging file " + source_file.second);
+         tree_managerRef TreeM = tree_managers[index];
+         if(TreeM)
+         {
+            UniquifySSAVersions(TreeM);
+         }
+         else
          {
             THROW_WARNING("Raw not created for file " + output_temporary_directory + "/" + leaf_name);
             CompileFile(source_file.first, source_file.second, gcc_compiling_parameters, GccWrapper_CompilerMode::CM_EMPTY);
@@ -615,14 +751,13 @@ void GccWrapper::FillTreeManager(const tree_managerRef TM, std::map<std::string,
                THROW_ERROR(output_temporary_directory + "/" + leaf_name + STR_CST_gcc_empty_suffix + " not found: impossible to create raw file for " + source_file.second);
             rename_file(output_temporary_directory + "/" + leaf_name + STR_CST_gcc_empty_suffix, output_temporary_directory + "/" + leaf_name + STR_CST_gcc_tree_suffix);
             INDENT_DBG_MEX(DEBUG_LEVEL_VERY_PEDANTIC, debug_level, "---Renaming " + source_file.second + STR_CST_gcc_empty_suffix + " in " + source_file.second + STR_CST_gcc_tree_suffix);
+            TreeM = ParseTreeFile(Param, output_temporary_directory + "/" + leaf_name + STR_CST_gcc_tree_suffix);
          }
-         boost::filesystem::path obj = boost::filesystem::path(output_temporary_directory + "/" + leaf_name + STR_CST_gcc_tree_suffix);
-         tree_managerRef TreeM = ParseTreeFile(Param, obj.string());
 
 #if HAVE_FROM_RTL_BUILT
          if((Param->getOption<bool>(OPT_use_rtl)) and boost::filesystem::exists(boost::filesystem::path(leaf_name + STR_CST_gcc_rtl_suffix)))
          {
-            obj = boost::filesystem::path(leaf_name + STR_CST_gcc_rtl_suffix);
+            const boost::filesystem::path obj = boost::filesystem::path(leaf_name + STR_CST_gcc_rtl_suffix);
             parse_rtl_File(obj.string(), TreeM, debug_level);
             rename_file(obj, boost::filesystem::path(output_temporary_directory + leaf_name + STR_CST_gcc_rtl_suffix));
          }
@@ -281,6 +281,18 @@ class GccWrapper
     */
    void CompileFile(const std::string& original_file_name, std::string& real_file_name, const std::string& parameters_line, GccWrapper_CompilerMode cm = GccWrapper_CompilerMode::CM_STD);
 
+   /**
+    * Compute the name of the file of the compiler cache which stores the raw file produced by a compilation;
+    * the key is computed on the preprocessed source, on the compilation command and on the version of the tool and of the plugin
+    * @param compiler is the compiler used
+    * @param command is the compilation command without output file, options and source file
+    * @param source_arguments are the options and the source file passed to the compiler
+    * @param gcc_output_file_name is the file where the output of the compiler is redirected
+    * @param key_string is filled with the key, which is stored in the cache entry and checked when the entry is retrieved
+    * @return the name of the cached raw file or the empty string if the source file cannot be preprocessed
+    */
+   std::string GetCachedRawFileName(const Compiler& compiler, const std::string& command, const std::string& source_arguments, const std::string& gcc_output_file_name, std::string& key_string) const;
+
    /**
     * Return the compiler for a given target
     * @return a structure containing information about compiler